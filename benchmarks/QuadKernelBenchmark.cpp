@@ -0,0 +1,139 @@
+// 四边形变换内核微基准测试
+// 比较标量与SIMD内核的变换吞吐量，以及逐个drawSprite与批量drawSprites的提交耗时。
+#include "core/Graphics.h"
+#include "core/QuadKernel.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+// 不绘制的图形设备，只统计提交的索引数量，用于测量CPU端顶点构建开销
+class NullGraphicsDevice : public GraphicsDevice {
+public:
+    NullGraphicsDevice() : m_indexCount(0) {}
+
+    bool init() override { return true; }
+    void cleanup() override {}
+    void swapBuffers() override {}
+    void setViewport(int x, int y, int width, int height) override {}
+    void getViewport(int& x, int& y, int& width, int& height) const override { x = y = width = height = 0; }
+    void clear(const Color& color) override {}
+
+    using GraphicsDevice::drawIndexed;
+    void drawIndexed(const void* vertices, const VertexFormat& format, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) override {
+        m_indexCount += indexCount;
+    }
+
+    std::unique_ptr<Shader> createShader() override { return nullptr; }
+    std::unique_ptr<Texture> createTexture() override { return nullptr; }
+
+    size_t getIndexCount() const { return m_indexCount; }
+
+private:
+    size_t m_indexCount;
+};
+
+// 不采样的纹理，只作为批处理键
+class NullTexture : public Texture {
+public:
+    bool loadFromFile(const std::string& filePath) override { return true; }
+    bool loadFromMemory(const void* data, size_t size) override { return true; }
+    void bind(int unit) override {}
+    int getWidth() const override { return 1; }
+    int getHeight() const override { return 1; }
+};
+
+// 运行iterations次并返回每次的平均耗时（毫秒）
+template <typename Function>
+double measure(int iterations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 10000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::vector<SpriteInstance> instances(count);
+    for (size_t i = 0; i < count; ++i) {
+        SpriteInstance& instance = instances[i];
+        instance.x = static_cast<float>(i % 1280);
+        instance.y = static_cast<float>((i * 7) % 720);
+        instance.width = 16.0f;
+        instance.height = 8.0f;
+        instance.rotation = static_cast<float>(i) * 0.01f;
+        instance.u0 = 0.0f;
+        instance.v0 = 0.0f;
+        instance.u1 = 1.0f;
+        instance.v1 = 1.0f;
+        instance.color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    std::vector<float> positions(count * 8);
+
+    // 防止编译器优化掉结果
+    volatile float sink = 0.0f;
+
+    double libmTime = measure(iterations, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const SpriteInstance& instance = instances[i];
+            float cosTheta = cosf(instance.rotation);
+            float sinTheta = sinf(instance.rotation);
+            float halfWidth = instance.width * 0.5f;
+            float halfHeight = instance.height * 0.5f;
+            float corners[8] = {-halfWidth, -halfHeight, halfWidth, -halfHeight, -halfWidth, halfHeight, halfWidth, halfHeight};
+            for (int corner = 0; corner < 4; ++corner) {
+                float x = corners[corner * 2];
+                float y = corners[corner * 2 + 1];
+                positions[i * 8 + corner * 2] = x * cosTheta - y * sinTheta + instance.x;
+                positions[i * 8 + corner * 2 + 1] = x * sinTheta + y * cosTheta + instance.y;
+            }
+        }
+        sink = sink + positions[0];
+    });
+    double scalarTime = measure(iterations, [&]() {
+        transformSpritesScalar(instances.data(), count, positions.data());
+        sink = sink + positions[0];
+    });
+    double simdTime = measure(iterations, [&]() {
+        transformSprites(instances.data(), count, positions.data());
+        sink = sink + positions[0];
+    });
+
+    NullTexture texture;
+    Renderer renderer(std::make_unique<NullGraphicsDevice>());
+    renderer.init();
+    double drawSpriteTime = measure(iterations, [&]() {
+        renderer.beginRender();
+        for (const SpriteInstance& instance : instances) {
+            Rect dstRect(instance.x - instance.width * 0.5f, instance.y - instance.height * 0.5f, instance.width, instance.height);
+            renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), dstRect, instance.rotation, instance.color);
+        }
+        renderer.endRender();
+    });
+    double drawSpritesTime = measure(iterations, [&]() {
+        renderer.beginRender();
+        renderer.drawSprites(texture, instances.data(), count);
+        renderer.endRender();
+    });
+
+    std::cout << "Quad kernel: " << getQuadKernelName() << " (" << getQuadKernelWidth() << " quads per iteration)" << std::endl;
+    std::cout << count << " sprites, " << iterations << " iterations" << std::endl;
+    std::cout << "  transform (libm sincos) : " << libmTime << " ms" << std::endl;
+    std::cout << "  transform (scalar)      : " << scalarTime << " ms" << std::endl;
+    std::cout << "  transform (SIMD)        : " << simdTime << " ms  x" << scalarTime / simdTime << std::endl;
+    std::cout << "  drawSprite loop         : " << drawSpriteTime << " ms" << std::endl;
+    std::cout << "  drawSprites batch       : " << drawSpritesTime << " ms  x" << drawSpriteTime / drawSpritesTime << std::endl;
+    return 0;
+}
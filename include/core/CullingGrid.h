@@ -0,0 +1,79 @@
+#ifndef CULLINGGRID_H
+#define CULLINGGRID_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Appgame {
+
+// 视口剔除网格
+// 对象按包围盒注册到均匀网格（格子按需创建，世界范围不受限），
+// 每帧用摄像机视口查询，只有可见对象交给渲染器提交。
+// 跨越多个格子的对象在每个格子中各登记一次，查询时去重。
+class CullingGrid {
+public:
+    typedef uint32_t Handle;
+
+    struct Stats {
+        size_t objects;         // 已注册对象数
+        size_t submitted;       // 上次查询的可见对象数
+        size_t culled;          // 上次查询剔除的对象数
+        size_t cellsVisited;    // 上次查询访问的非空格子数
+    };
+
+    explicit CullingGrid(float cellSize = 256.0f);
+
+    // 注册对象，userData由调用方解释（如FishInstance指针）
+    Handle insert(const Rect& bounds, void* userData);
+
+    // 更新对象包围盒，覆盖的格子不变时不重新登记
+    void update(Handle handle, const Rect& bounds);
+
+    // 移除对象，句柄之后可能被重用
+    void remove(Handle handle);
+
+    // 移除所有对象
+    void clear();
+
+    // 查询与视口相交的对象，结果按注册顺序（句柄）排列，返回可见数量
+    size_t query(const Rect& viewport, std::vector<void*>& visible);
+
+    // 获取统计信息
+    const Stats& getStats() const;
+
+    float getCellSize() const;
+
+private:
+    struct Object {
+        Rect bounds;
+        void* userData;
+        int cellX0, cellY0, cellX1, cellY1;
+        uint32_t queryStamp;
+        bool active;
+    };
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    std::vector<Object> m_objects;
+    std::vector<Handle> m_freeHandles;
+    std::unordered_map<uint64_t, std::vector<Handle>> m_cells;
+    std::vector<Handle> m_candidates;
+    uint32_t m_queryStamp;
+    Stats m_stats;
+
+    // 计算包围盒覆盖的格子范围
+    void computeCells(const Rect& bounds, int& x0, int& y0, int& x1, int& y1) const;
+
+    // 在覆盖的格子中登记/注销
+    void addToCells(Handle handle);
+    void removeFromCells(Handle handle);
+
+    static uint64_t cellKey(int x, int y);
+};
+
+} // namespace Appgame
+
+#endif // CULLINGGRID_H
@@ -0,0 +1,51 @@
+#ifndef DIRTYREGION_H
+#define DIRTYREGION_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+#include <vector>
+
+namespace Appgame {
+
+// 脏矩形区域
+// 记录自上次重绘以来发生变化的屏幕区域，只重绘这些区域（配合Renderer::setScissorRect）。
+// 加入的矩形向外取整到像素并裁剪到边界；重叠或合并后浪费面积不多的矩形合并为包围盒，
+// 因此结果中的矩形互不重叠。数量超过上限时合并面积增量最小的一对，最坏情况下退化为一个包围盒。
+class DirtyRegion {
+public:
+    explicit DirtyRegion(size_t maxRects = 8);
+
+    // 设置边界（通常为屏幕），宽高为0时不裁剪
+    void setBounds(const Rect& bounds);
+    const Rect& getBounds() const;
+
+    // 加入一个变化的区域
+    void add(const Rect& rect);
+
+    // 整个边界都需要重绘
+    void addAll();
+
+    // 重绘完成后清空
+    void clear();
+
+    // 是否没有需要重绘的区域
+    bool isEmpty() const;
+
+    // 获取需要重绘的矩形（互不重叠）
+    const std::vector<Rect>& getRects() const;
+
+    // 需要重绘的总面积（像素）
+    float getArea() const;
+
+private:
+    size_t m_maxRects;
+    Rect m_bounds;
+    std::vector<Rect> m_rects;
+
+    // 合并与rect重叠或相邻矩形后加入，不检查数量上限
+    void insert(Rect rect);
+};
+
+} // namespace Appgame
+
+#endif // DIRTYREGION_H
@@ -0,0 +1,145 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include "core/Graphics.h"
+#include "core/TextureAtlas.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Appgame {
+
+// UTF-8解码为Unicode码点，非法或截断的序列解码为U+FFFD
+void decodeUtf8(const std::string& text, std::vector<uint32_t>& codepoints);
+
+// 字形位图：8位覆盖率（行优先，无行填充）与度量（像素）
+struct GlyphBitmap {
+    int width, height;
+    float bearingX;             // 笔位置到位图左边的距离
+    float bearingY;             // 基线到位图上边的距离（向上为正）
+    float advance;              // 笔前进量
+    std::vector<uint8_t> coverage;
+
+    GlyphBitmap() : width(0), height(0), bearingX(0.0f), bearingY(0.0f), advance(0.0f) {}
+};
+
+// 字形来源：把码点光栅化为覆盖率位图，TrueType等字体库在此接入
+class GlyphSource {
+public:
+    virtual ~GlyphSource() = default;
+
+    // 按像素字号光栅化码点，字体中没有该字符时返回false；空白字符返回宽高为0的位图
+    virtual bool rasterize(uint32_t codepoint, int pixelSize, GlyphBitmap& bitmap) = 0;
+
+    // 获取字号下的上升高度和行高（像素）
+    virtual void getMetrics(int pixelSize, float& ascent, float& lineHeight) const = 0;
+};
+
+// 由覆盖率位图生成有向距离场（精确欧氏距离变换）
+// 输出四周各扩展spread像素，尺寸为(width + 2*spread) x (height + 2*spread)；
+// 值为0.5 + 距离/(2*spread)映射到0-255，128为边缘，形状内部大于128
+void generateDistanceField(const uint8_t* coverage, int width, int height, int spread, std::vector<uint8_t>& field);
+
+// SDF字体
+// 字形以基准字号生成距离场后打包到专用图集（页面标记为距离场纹理），任意字号共用同一套字形并保持边缘清晰。
+// 字形可以在加载时或离线预先生成（preload/saveToMemory/loadFromMemory），
+// 也可以设置来源后按需生成：CJK字符集很大，只为实际出现的字生成距离场。
+class SdfFont {
+public:
+    struct Glyph {
+        const AtlasRegion* region;  // 距离场所在的图集区域，空白字符为空
+        float left, top;            // 距离场左上角相对笔位置（基线）的偏移，y向下
+        float width, height;        // 距离场尺寸（含四周spread）
+        float advance;              // 笔前进量
+    };
+
+    struct Stats {
+        size_t glyphs;              // 已有的字形数量
+        unsigned int generated;     // 生成距离场的次数
+        unsigned int missing;       // 来源中不存在的码点数量
+        float generateTime;         // 生成距离场的总耗时（毫秒）
+    };
+
+    // 页面纹理由device创建；baseSize为生成距离场的字号，spread为距离场向外扩展的像素数
+    SdfFont(GraphicsDevice* device, int baseSize = 32, int spread = 4, int pageSize = 1024);
+    ~SdfFont();
+
+    // 设置字形来源，getGlyph遇到未生成的码点时从来源生成；来源必须在字体使用期间保持有效
+    void setSource(GlyphSource* source);
+
+    // 预先生成文本中出现的字形，返回新生成的数量
+    size_t preload(const std::string& text);
+
+    // 获取字形：未生成时从来源生成，失败时使用替代字形，仍失败时返回空
+    const Glyph* getGlyph(uint32_t codepoint);
+
+    // 设置替代字形（默认'?'）
+    void setFallback(uint32_t codepoint);
+
+    // 设置图集触发重新装箱的碎片率阈值
+    void setRepackThreshold(float fragmentation);
+
+    // 基准字号下的度量
+    int getBaseSize() const;
+    int getSpread() const;
+    float getAscent() const;
+    float getLineHeight() const;
+
+    // 执行按需生成字形时标记的图集重新装箱，在帧开始（本帧还没有绘制文字）时调用
+    // 绘制过程中生成的字形只会放到空闲位置或新页面，已提交的字形不会移动
+    bool repackIfPending();
+
+    // 图集重新装箱或重新加载后改变，缓存了字形UV的调用方据此判断是否失效
+    unsigned int getGeneration() const;
+
+    // 离线生成：保存所有已生成字形的距离场与度量，加载后无需字形来源
+    bool saveToMemory(std::vector<uint8_t>& data) const;
+    bool loadFromMemory(const void* data, size_t size);
+
+    // 获取图集
+    const TextureAtlas& getAtlas() const;
+
+    // 获取统计信息
+    const Stats& getStats() const;
+
+private:
+    // 距离场数据（每纹素1字节），保存时写出
+    struct FieldData {
+        int width, height;
+        std::vector<uint8_t> values;
+    };
+
+    GraphicsDevice* m_device;
+    int m_pageSize;
+    GlyphSource* m_source;
+    std::unique_ptr<TextureAtlas> m_atlas;
+    int m_baseSize;
+    int m_spread;
+    float m_ascent;
+    float m_lineHeight;
+    uint32_t m_fallback;
+    float m_repackThreshold;        // 负数表示使用图集默认值
+    unsigned int m_generationBase;
+    std::unordered_map<uint32_t, Glyph> m_glyphs;
+    std::unordered_map<uint32_t, FieldData> m_fields;
+    std::unordered_set<uint32_t> m_missing;
+    std::vector<uint32_t> m_codepoints;
+    Stats m_stats;
+
+    // 从来源生成字形，失败返回空
+    const Glyph* generateGlyph(uint32_t codepoint);
+
+    // 把距离场加入图集并登记字形
+    const Glyph* addGlyph(uint32_t codepoint, const Glyph& metrics, FieldData field);
+
+    // 重新创建空图集，代数继续递增
+    void resetAtlas();
+};
+
+} // namespace Appgame
+
+#endif // FONT_H
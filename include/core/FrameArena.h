@@ -0,0 +1,145 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Appgame {
+
+// 帧线性分配器（bump allocator）
+// 每帧开始时由GameLoop重置，帧内分配只移动指针，不逐个释放。
+// 分配的内存只在本帧内有效；非线程安全，每个线程应使用自己的FrameArena。
+// 容量不足时从堆上分配溢出块，在下次reset时释放，并把主缓冲区扩大到峰值用量。
+class FrameArena {
+public:
+    // 回滚标记，用于临时内存作用域
+    typedef size_t Marker;
+
+    explicit FrameArena(size_t capacity = 1024 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // 分配内存
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // 分配未初始化的数组
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // 重置分配器（帧开始时调用）
+    void reset();
+
+    // 获取当前位置标记 / 回滚到标记位置（仅回收主缓冲区中的内存）
+    Marker getMarker() const;
+    void rewind(Marker marker);
+
+    // 获取统计信息
+    size_t getCapacity() const;
+    size_t getUsed() const;
+    size_t getPeakUsed() const;
+    uint64_t getOverflowCount() const;
+
+private:
+    char* m_buffer;
+    size_t m_capacity;
+    size_t m_offset;
+    size_t m_peakUsed;
+    size_t m_overflowBytes;
+    uint64_t m_overflowCount;
+    std::vector<void*> m_overflowBlocks;
+};
+
+// 临时内存作用域：析构时回滚到创建时的位置
+class ScratchScope {
+public:
+    explicit ScratchScope(FrameArena& arena)
+        : m_arena(arena), m_marker(arena.getMarker()) {}
+    ~ScratchScope() { m_arena.rewind(m_marker); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    FrameArena& getArena() { return m_arena; }
+
+private:
+    FrameArena& m_arena;
+    FrameArena::Marker m_marker;
+};
+
+// STL兼容的分配器适配器；arena为空时退回到堆分配
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator() noexcept : m_arena(nullptr) {}
+    explicit ArenaAllocator(FrameArena* arena) noexcept : m_arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        if (m_arena) {
+            return m_arena->allocateArray<T>(count);
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        // 帧内存在reset时统一回收
+        if (!m_arena) {
+            ::operator delete(pointer);
+        }
+    }
+
+    FrameArena* getArena() const noexcept {
+        return m_arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return m_arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return m_arena != other.getArena();
+    }
+
+private:
+    FrameArena* m_arena;
+};
+
+// 使用帧内存的容器
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> FrameString;
+
+// 堆分配统计（需链接HeapTracking.cpp，见CMake选项APPGAME_TRACK_HEAP_ALLOCATIONS）
+struct HeapStats {
+    uint64_t allocations;   // 累计堆分配次数
+    uint64_t frees;         // 累计堆释放次数
+    uint64_t bytes;         // 累计分配字节数
+};
+
+// 获取进程级堆分配统计
+HeapStats getHeapStats();
+
+// 是否启用了堆分配统计（替换的operator new已经统计到分配）
+bool isHeapTrackingEnabled();
+
+// 记录一次堆分配/释放，由HeapTracking.cpp中替换的全局operator new/delete调用
+void recordHeapAllocation(size_t size);
+void recordHeapFree();
+
+} // namespace Appgame
+
+#endif // FRAMEARENA_H
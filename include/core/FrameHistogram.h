@@ -0,0 +1,58 @@
+#ifndef FRAMEHISTOGRAM_H
+#define FRAMEHISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+
+namespace Appgame {
+
+// 帧时间直方图（HDR风格）
+// 以微秒为单位记录，按2的幂分段、段内线性细分，相对误差不超过约3%，
+// 内存固定，记录为O(1)，适合每帧调用。
+class FrameTimeHistogram {
+public:
+    FrameTimeHistogram();
+
+    // 记录一个样本（毫秒）
+    void record(float milliseconds);
+
+    // 获取百分位数（percentile取值0-100，返回毫秒）
+    float getPercentile(float percentile) const;
+
+    // 获取样本数量
+    uint64_t getCount() const;
+
+    // 获取最小/最大/平均值（毫秒）
+    float getMin() const;
+    float getMax() const;
+    float getMean() const;
+
+    // 合并另一个直方图
+    void merge(const FrameTimeHistogram& other);
+
+    // 清空所有样本
+    void reset();
+
+private:
+    // 段内细分位数：每段64个子桶，其中后32个为有效区间
+    static const int SUB_BUCKET_BITS = 6;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    // 覆盖到2^32微秒
+    static const int MAX_SHIFT = 32 - SUB_BUCKET_BITS + 1;
+    static const int BUCKET_COUNT = SUB_BUCKET_COUNT + MAX_SHIFT * SUB_BUCKET_HALF;
+
+    // 微秒值与桶索引的相互转换
+    static int indexFor(uint64_t microseconds);
+    static uint64_t upperBoundFor(int index);
+
+    std::array<uint32_t, BUCKET_COUNT> m_counts;
+    uint64_t m_count;
+    uint64_t m_minMicros;
+    uint64_t m_maxMicros;
+    double m_sumMicros;
+};
+
+} // namespace Appgame
+
+#endif // FRAMEHISTOGRAM_H
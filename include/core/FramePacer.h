@@ -0,0 +1,70 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "core/FrameHistogram.h"
+#include <chrono>
+#include <cstdint>
+
+namespace Appgame {
+
+// 帧率控制器：等待到下一帧的截止时间，并统计唤醒误差
+class FramePacer {
+public:
+    enum class Mode {
+        SLEEP,     // 仅使用系统睡眠（开销最低，精度受调度器影响）
+        HYBRID,    // 粗粒度睡眠 + 最后一段自旋等待
+        BUSY       // 全程自旋等待（精度最高，占满一个核心）
+    };
+
+    struct Stats {
+        uint64_t waitCount;         // 等待次数
+        uint64_t missedDeadlines;   // 唤醒晚于截止时间超过容差的次数
+        float avgError;             // 平均唤醒误差（毫秒，晚于截止时间为正）
+        float maxError;             // 最大唤醒误差（毫秒）
+        float p99Error;             // 唤醒误差99百分位（毫秒）
+        float sleepEstimate;        // 当前对单次睡眠实际耗时的估计（毫秒）
+    };
+
+    FramePacer();
+
+    // 设置/获取等待策略
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    // 设置判定为错过截止时间的容差（毫秒）
+    void setMissTolerance(float milliseconds);
+
+    // 等待到指定时间点
+    void waitUntil(std::chrono::steady_clock::time_point deadline);
+
+    // 获取/重置统计信息
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    // 混合模式：睡眠到剩余时间小于睡眠估计值，再自旋
+    void sleepCoarse(std::chrono::steady_clock::time_point deadline);
+
+    // 自旋等待到截止时间
+    static void spinUntil(std::chrono::steady_clock::time_point deadline);
+
+    // 根据实际睡眠耗时更新估计值
+    void updateSleepEstimate(double milliseconds);
+
+    Mode m_mode;
+    float m_missTolerance;
+
+    // 单次1ms睡眠实际耗时的在线均值/方差（Welford）
+    double m_sleepMean;
+    double m_sleepM2;
+    uint64_t m_sleepSamples;
+    double m_sleepEstimate;
+
+    // 唤醒误差统计
+    FrameTimeHistogram m_errorHistogram;
+    uint64_t m_missedDeadlines;
+};
+
+} // namespace Appgame
+
+#endif // FRAMEPACER_H
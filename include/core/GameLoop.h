@@ -1,11 +1,24 @@
 #ifndef GAMELOOP_H
 #define GAMELOOP_H
 
+#include "core/FrameArena.h"
+#include "core/FrameHistogram.h"
+#include "core/FramePacer.h"
+#include "core/UpdateGovernor.h"
 #include <functional>
 #include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 namespace Appgame {
 
+class JobSystem;
+
 class GameLoop {
 public:
     enum class TimeStepMode {
@@ -19,6 +32,63 @@ public:
         float maxFrameTime;     // 最大帧时间（毫秒）
     };
 
+    // 单个阶段的耗时统计
+    struct PhaseStats {
+        float average;          // 平均耗时（毫秒）
+        float max;              // 最大耗时（毫秒）
+    };
+
+    // 帧内存统计
+    struct MemoryStats {
+        float heapAllocationsPerFrame;      // 平均每帧堆分配次数（需启用堆分配统计）
+        uint64_t maxHeapAllocationsPerFrame; // 单帧最大堆分配次数
+        uint64_t lastHeapAllocations;       // 最近一帧堆分配次数
+        size_t arenaCapacity;               // 帧分配器容量（字节）
+        size_t arenaPeakUsed;               // 帧分配器峰值用量（字节）
+        uint64_t arenaOverflowCount;        // 帧分配器溢出次数
+    };
+
+    // 详细统计信息（自上次resetDetailedStats起累计）
+    struct DetailedStats {
+        uint64_t frameCount;    // 统计帧数
+        float p50FrameTime;     // 帧时间百分位数（毫秒）
+        float p90FrameTime;
+        float p99FrameTime;
+        float p999FrameTime;
+        float minFrameTime;     // 最小帧时间（毫秒）
+        float maxFrameTime;     // 最大帧时间（毫秒）
+        float avgFrameTime;     // 平均帧时间（毫秒）
+        float frameBudget;      // 帧预算（毫秒）
+        uint64_t spikeCount;    // 超出帧预算的帧数
+        PhaseStats update;      // 更新阶段
+        PhaseStats render;      // 渲染阶段
+        PhaseStats sleep;       // 帧率控制等待阶段
+        FramePacer::Stats pacing; // 帧率控制精度
+        MemoryStats memory;     // 帧内存统计
+        UpdateGovernor::Stats governor; // 更新预算调节（补偿步数、丢弃时间、过载等级）
+    };
+
+    // 无头模拟统计
+    struct HeadlessStats {
+        uint64_t steps;                 // 执行的固定步长更新次数
+        double simulatedSeconds;        // 模拟时间（秒）
+        double wallSeconds;             // 实际耗时（秒）
+        double simSecondsPerWallSecond; // 每实际秒模拟的秒数
+        float avgStepTime;              // 平均单步耗时（毫秒）
+        float maxStepTime;              // 最大单步耗时（毫秒）
+    };
+
+    // 空闲模式统计
+    struct IdleStats {
+        uint64_t wakeups;           // 空闲期间的唤醒次数
+        uint64_t timerWakeups;      // 因超时唤醒的次数
+        uint64_t explicitWakeups;   // 因wake()/requestRedraw()/状态变化唤醒的次数
+        uint64_t redraws;           // 空闲期间执行的重绘次数
+        double idleSeconds;         // 累计空闲时间（秒）
+        double idleCpuSeconds;      // 空闲期间游戏循环线程消耗的CPU时间（秒）
+        float cpuUsage;             // 空闲期间的CPU占用（CPU时间/空闲时间）
+    };
+
     GameLoop();
     ~GameLoop();
 
@@ -34,6 +104,39 @@ public:
     // 恢复游戏循环
     void resume();
 
+    // 进入/退出空闲模式（用于主菜单、设置等静态场景）
+    // 空闲或暂停时游戏循环阻塞在条件变量上，不更新、不渲染，直到超时、wake()或状态变化
+    void setIdle(bool idle);
+    bool isIdle() const;
+
+    // 唤醒空闲等待（线程安全，平台事件到达时调用），非空闲时没有效果
+    void wake();
+
+    // 请求空闲期间重绘一帧并唤醒（线程安全），非空闲时没有效果
+    void requestRedraw();
+
+    // 设置空闲等待的超时时间（秒），0表示一直等待到被唤醒
+    void setIdleTimeout(float seconds);
+
+    // 设置空闲唤醒回调：每次空闲唤醒时调用，用于处理平台消息
+    void setIdleCallback(std::function<void()> callback);
+
+    // 设置空闲条件（如当前场景为静态界面）：游戏循环每帧开始和每次空闲唤醒后求值，决定是否处于空闲模式
+    // 设置后setIdle的状态会被条件的结果覆盖；空函数表示不使用
+    void setIdleCondition(std::function<bool()> condition);
+
+    // 获取空闲模式统计
+    IdleStats getIdleStats() const;
+
+    // 无头模式：连续执行steps个固定步长更新，不调用渲染回调、不等待，返回本次统计
+    HeadlessStats advance(uint64_t steps);
+
+    // 无头模式：模拟simSeconds秒（按固定步长向上取整）
+    HeadlessStats runFor(double simSeconds);
+
+    // 获取自创建以来无头模式的累计统计
+    const HeadlessStats& getHeadlessStats() const;
+
     // 设置时间步长模式
     void setTimeStepMode(TimeStepMode mode);
 
@@ -43,32 +146,138 @@ public:
     // 设置固定时间步长（秒）
     void setFixedTimeStep(float step);
 
+    // 设置帧率控制策略（仅睡眠/睡眠+自旋/自旋）
+    void setPacingMode(FramePacer::Mode mode);
+
+    // 获取帧率控制精度统计
+    FramePacer::Stats getPacingStats() const;
+
+    // 获取更新预算调节器（固定步长模式下限制每帧补偿步数，并发布过载信号）
+    UpdateGovernor& getUpdateGovernor();
+
     // 获取当前统计信息
     const Stats& getStats() const;
 
+    // 获取上一帧的工作耗时（更新+渲染，不含帧率控制等待，毫秒）
+    float getLastFrameTime() const;
+
+    // 获取详细统计信息（帧时间百分位数、超预算帧数及各阶段耗时）
+    DetailedStats getDetailedStats() const;
+
+    // 重置详细统计信息
+    void resetDetailedStats();
+
+    // 设置帧预算（毫秒），帧时间（更新+渲染）超过预算计为一次卡顿，0表示使用目标帧时间
+    void setFrameBudget(float milliseconds);
+
+    // 获取帧时间直方图
+    const FrameTimeHistogram& getFrameTimeHistogram() const;
+
+    // 获取帧分配器：每帧（无头模式为每步）开始时重置，分配的内存只在本帧内有效，仅限更新线程使用
+    FrameArena& getFrameArena();
+
     // 注册回调函数
     void setUpdateCallback(std::function<void(float)> callback);
     void setRenderCallback(std::function<void(float)> callback);
 
+    // 设置流水线渲染（需在start()之前设置）
+    // 开启后渲染回调在独立的渲染线程执行：第N帧渲染与第N+1帧更新并行，渲染最多落后一帧。
+    // 渲染回调不应直接读取游戏状态，而应读取发布回调写入的快照（见TripleBuffer）。
+    void setPipelinedRender(bool enabled);
+
+    // 设置快照发布回调：流水线模式下每帧更新结束后在更新线程调用，参数与渲染回调相同
+    void setPublishCallback(std::function<void(float)> callback);
+
+    // 注册更新系统，dependencies中的系统先于本系统执行，返回系统ID（依赖无效时返回-1）
+    // 系统在更新回调之后、按注册顺序或依赖图执行
+    int addSystem(const std::string& name, std::function<void(float)> update, const std::vector<int>& dependencies = {});
+
+    // 清除所有已注册的系统
+    void clearSystems();
+
+    // 设置任务系统，非空时每帧将已注册系统作为任务节点按依赖图并行执行
+    void setJobSystem(JobSystem* jobSystem);
+
 private:
+    // 更新系统节点
+    struct SystemNode {
+        std::string name;
+        std::function<void(float)> update;
+        std::vector<int> dependencies;
+    };
+
+    // 阶段耗时累计
+    struct PhaseAccumulator {
+        double sum;
+        float max;
+
+        PhaseAccumulator() : sum(0.0), max(0.0f) {}
+        void record(float milliseconds);
+        PhaseStats toStats(uint64_t count) const;
+    };
+
     // 游戏循环主函数
     void run();
 
-    // 计算帧率和性能统计
-    void updateStats();
+    // 空闲等待一次（超时、被唤醒或退出空闲后返回）
+    void runIdle();
+
+    // 按空闲条件更新空闲状态
+    void updateIdleCondition();
+
+    // 执行一次更新（更新回调和所有系统）
+    void runUpdate(float deltaTime);
+
+    // 执行所有已注册系统
+    void runSystems(float deltaTime);
+
+    // 渲染线程管理
+    void startRenderThread();
+    void stopRenderThread();
+    void renderThreadMain();
+
+    // 提交一帧给渲染线程（等待上一帧渲染完成），返回上一帧的渲染耗时（毫秒）
+    float submitPipelinedRender(float renderParam);
+
+    // 计算帧率和性能统计（参数均为毫秒）
+    void updateStats(float updateTime, float renderTime, float frameTime, float frameInterval);
+
+    // 帧率控制等待
+    void waitForNextFrame();
+
+    // 记录本帧堆分配次数
+    void recordHeapAllocations(uint64_t allocations);
+
+    // 获取当前帧预算（毫秒）
+    float getFrameBudget() const;
 
     // 回调函数
     std::function<void(float)> m_updateCallback;
     std::function<void(float)> m_renderCallback;
 
+    // 更新系统及任务调度
+    std::vector<SystemNode> m_systems;
+    JobSystem* m_jobSystem;
+
     // 时间步长设置
     TimeStepMode m_timeStepMode;
     float m_fixedTimeStep;
     float m_targetFrameTime;
 
-    // 游戏状态
-    bool m_running;
-    bool m_paused;
+    // 游戏状态（可由其他线程修改）
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_paused;
+    std::atomic<bool> m_idle;
+
+    // 空闲模式
+    std::function<void()> m_idleCallback;
+    std::function<bool()> m_idlePredicate;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition;
+    bool m_wakeRequested;
+    bool m_redrawRequested;
+    float m_idleTimeout;
+    IdleStats m_idleStats;
 
     // 时间变量
     std::chrono::steady_clock::time_point m_lastTime;
@@ -80,6 +289,42 @@ private:
     int m_frameCount;
     float m_frameTimeSum;
     float m_lastFrameTime;
+    float m_windowMaxFrameTime;
+    float m_statsElapsed;
+
+    // 帧率控制
+    FramePacer m_framePacer;
+
+    // 更新预算调节
+    UpdateGovernor m_updateGovernor;
+
+    // 无头模拟累计统计
+    HeadlessStats m_headlessStats;
+
+    // 详细统计
+    FrameTimeHistogram m_frameTimeHistogram;
+    PhaseAccumulator m_updatePhase;
+    PhaseAccumulator m_renderPhase;
+    PhaseAccumulator m_sleepPhase;
+    uint64_t m_spikeCount;
+    float m_frameBudget;
+
+    // 帧内存
+    FrameArena m_frameArena;
+    uint64_t m_heapAllocationSum;
+    uint64_t m_maxHeapAllocations;
+    uint64_t m_lastHeapAllocations;
+
+    // 流水线渲染
+    bool m_pipelinedRender;
+    std::function<void(float)> m_publishCallback;
+    std::thread m_renderThread;
+    std::mutex m_renderMutex;
+    std::condition_variable m_renderCondition;
+    bool m_renderPending;
+    bool m_renderExit;
+    float m_renderParam;
+    float m_lastRenderTime;
 };
 
 } // namespace Appgame
@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace Appgame {
 
@@ -27,6 +29,71 @@ struct Vertex {
         : x(x), y(y), z(z), u(u), v(v), color(color) {}
 };
 
+// 紧凑顶点：2D位置、16位归一化UV、RGBA8颜色，共16字节（Vertex为36字节）
+struct PackedVertex {
+    float x, y;
+    uint16_t u, v;
+    uint32_t color;     // 内存字节顺序R、G、B、A
+
+    // 颜色打包为RGBA8
+    static uint32_t packColor(const Color& color);
+
+    // 0-1范围的值量化为16位归一化整数
+    static uint16_t packUnorm16(float value);
+};
+
+// 顶点属性
+enum class VertexAttribute {
+    POSITION,
+    TEXCOORD,
+    COLOR
+};
+
+// 顶点属性的存储类型
+enum class VertexElementType {
+    FLOAT2,     // 2个float
+    FLOAT3,     // 3个float
+    FLOAT4,     // 4个float（0-1范围的颜色）
+    UNORM16X2,  // 2个16位归一化整数
+    UNORM8X4    // 4个8位归一化整数（RGBA8）
+};
+
+// 顶点属性描述
+struct VertexElement {
+    VertexAttribute attribute;
+    VertexElementType type;
+    uint32_t offset;
+};
+
+// 顶点格式描述：批处理与设备按描述读写顶点缓冲区
+struct VertexFormat {
+    static const int MAX_ELEMENTS = 4;
+
+    uint32_t stride;
+    int elementCount;
+    VertexElement elements[MAX_ELEMENTS];
+
+    explicit VertexFormat(uint32_t stride = 0);
+
+    // 添加属性，返回自身便于链式调用
+    VertexFormat& add(VertexAttribute attribute, VertexElementType type, uint32_t offset);
+
+    // 查找属性，不存在时返回空
+    const VertexElement* find(VertexAttribute attribute) const;
+
+    // 按格式解码第index个顶点（缺少的属性取默认值）
+    Vertex decode(const void* vertices, size_t index) const;
+
+    bool operator==(const VertexFormat& other) const;
+    bool operator!=(const VertexFormat& other) const;
+
+    // 标准格式（Vertex）
+    static const VertexFormat& standard();
+
+    // 紧凑格式（PackedVertex）
+    static const VertexFormat& compact();
+};
+
 // 矩形结构体
 struct Rect {
     float x, y, width, height;
@@ -35,6 +102,94 @@ struct Rect {
         : x(x), y(y), width(width), height(height) {}
 };
 
+// 精灵实例（批量提交）
+struct SpriteInstance {
+    float x, y;             // 中心位置
+    float width, height;    // 尺寸
+    float rotation;         // 旋转（弧度）
+    float u0, v0, u1, v1;   // 纹理坐标（归一化）
+    Color color;
+};
+
+// 线段实例（批量提交）
+struct LineInstance {
+    float x1, y1, x2, y2;
+    float width;
+    Color color;
+};
+
+// 折线连接方式
+enum class LineJoin {
+    MITER,      // 尖角（超过miterLimit时退回斜角）
+    BEVEL       // 斜角
+};
+
+// 折线样式
+struct PolylineStyle {
+    float width;        // 起点宽度
+    float endWidth;     // 终点宽度，按折线长度线性渐变；小于0表示与起点相同
+    LineJoin join;
+    float miterLimit;   // 尖角长度与半宽之比的上限
+    Color color;
+
+    PolylineStyle(float width = 1.0f, const Color& color = Color())
+        : width(width), endWidth(-1.0f), join(LineJoin::MITER), miterLimit(4.0f), color(color) {}
+};
+
+// 实例化精灵的每实例数据（32字节），由设备把共享的单位四边形展开为精灵
+// CPU展开同一个精灵需要4个紧凑顶点和6个索引，共88字节
+struct PackedSpriteInstance {
+    float x, y;                 // 中心位置
+    float rotation;             // 旋转（弧度）
+    float scaleX, scaleY;       // 单位四边形的缩放（即宽高）
+    uint16_t u0, v0, u1, v1;    // 16位归一化纹理坐标
+    uint32_t color;             // RGBA8
+};
+
+// 图形设备能力
+struct DeviceCapabilities {
+    bool instancing;            // 支持实例化绘制（drawInstanced）
+    size_t maxInstancesPerDraw; // 单次实例化绘制的最大实例数，0表示不限
+    bool renderTargets;         // 支持渲染到纹理（setRenderTarget）
+    bool scissor;               // 支持裁剪矩形（setScissor）
+
+    DeviceCapabilities() : instancing(false), maxInstancesPerDraw(0), renderTargets(false), scissor(false) {}
+};
+
+// 围栏标识，0表示无需等待
+typedef uint64_t FenceID;
+
+// 批次中断原因
+enum class BatchBreak {
+    LAYER,      // 图层变化
+    SHADER,     // 着色器变化
+    TEXTURE,    // 纹理变化
+    CAPACITY,   // 批处理缓冲区已满，提前刷新
+    INSTANCING, // 同一状态下实例化绘制与逐顶点绘制交替
+    COUNT
+};
+
+// 渲染批处理统计（每帧，beginRender时重置）
+struct RenderStats {
+    unsigned int quads;         // 提交的四边形数量（含实例化精灵）
+    unsigned int instances;     // 通过实例化绘制的精灵数量
+    unsigned int culled;        // 被剔除矩形剔除、未进入批处理的四边形数量
+    unsigned int batches;       // 批次数量（即绘制调用次数）
+    unsigned int flushes;       // 刷新次数
+    unsigned int breaks[static_cast<int>(BatchBreak::COUNT)]; // 按原因统计的批次中断次数
+    unsigned int vertices;      // 提交的顶点数（实例按每个4个顶点计）
+    unsigned int indices;       // 提交的索引数
+    unsigned int triangles;     // 提交的三角形数
+    size_t uploadBytes;         // 上传到设备的顶点、索引和实例数据字节数（每次刷新上传一次）
+    float flushTime;            // 刷新（排序、生成索引、提交绘制）耗时，毫秒
+};
+
+class Shader;
+class Texture;
+class StreamBuffer;
+struct RenderCommand;
+struct AtlasRegion;
+
 // 图形设备抽象类
 class GraphicsDevice {
 public:
@@ -57,8 +212,64 @@ public:
 
     // 清除屏幕
     virtual void clear(const Color& color) = 0;
+
+    // 绘制带索引的三角形列表，顶点按format解析，texture为空时只使用顶点颜色
+    virtual void drawIndexed(const void* vertices, const VertexFormat& format, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) = 0;
+
+    // 绘制标准格式（Vertex）的三角形列表
+    void drawIndexed(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) {
+        drawIndexed(vertices, VertexFormat::standard(), vertexCount, indices, indexCount, texture);
+    }
+
+    // 创建与本设备配套的着色器和纹理
+    virtual std::unique_ptr<Shader> createShader() = 0;
+    virtual std::unique_ptr<Texture> createTexture() = 0;
+
+    // 查询设备能力，默认不支持可选功能
+    virtual DeviceCapabilities getCapabilities() const { return DeviceCapabilities(); }
+
+    // 实例化绘制：每个实例把单位四边形（-0.5到0.5）缩放、旋转、平移后绘制
+    // 只在getCapabilities().instancing为true时调用
+    virtual void drawInstanced(const PackedSpriteInstance* instances, size_t count, const Texture* texture) {}
+
+    // 设置渲染目标，空表示默认帧缓冲区；目标纹理需由本设备创建，绑定期间不能被采样
+    // 不支持渲染目标时只接受空值
+    virtual bool setRenderTarget(Texture* texture) { return texture == nullptr; }
+
+    // 设置裁剪矩形（像素，相对视口），之后的绘制和clear只影响矩形内部，enabled为false时关闭
+    // 支持时DeviceCapabilities::scissor为true
+    virtual void setScissor(bool enabled, int x, int y, int width, int height) {}
+
+    // 在命令流中插入围栏，此前提交的绘制执行完毕后围栏被标记为完成（用于判断流式缓冲区中的数据何时可以覆盖）
+    // 默认设备同步执行绘制，返回0（立即完成）
+    virtual FenceID insertFence() { return 0; }
+    virtual bool isFenceSignaled(FenceID fence) const { return true; }
+
+    // 阻塞直到围栏完成
+    virtual void waitFence(FenceID fence) {}
 };
 
+// uniform句柄，由Shader::resolve解析一次，绘制时按句柄设置
+struct UniformHandle {
+    int index;
+
+    explicit UniformHandle(int index = -1) : index(index) {}
+    bool isValid() const { return index >= 0; }
+};
+
+// 每帧uniform块（std140布局），通过Shader::setUniformBlock一次上传
+struct FrameUniforms {
+    float projection[16];   // 投影矩阵（列主序）
+    float tint[4];          // 时段色调（RGBA）
+    float time;             // 游戏时间（秒）
+    float padding[3];
+
+    FrameUniforms();
+};
+
+// uniform块在着色器中的名称
+extern const char* const FRAME_UNIFORMS_BLOCK;
+
 // 着色器类
 class Shader {
 public:
@@ -70,13 +281,28 @@ public:
     // 使用着色器
     virtual void use() = 0;
 
-    // 设置 uniforms
-    virtual void setUniform1i(const std::string& name, int value) = 0;
-    virtual void setUniform1f(const std::string& name, float value) = 0;
-    virtual void setUniform2f(const std::string& name, float x, float y) = 0;
-    virtual void setUniform3f(const std::string& name, float x, float y, float z) = 0;
-    virtual void setUniform4f(const std::string& name, float x, float y, float z, float w) = 0;
-    virtual void setUniformMatrix4f(const std::string& name, const float* matrix) = 0;
+    // 解析uniform/uniform块名称，着色器中不存在时返回无效句柄
+    virtual UniformHandle resolve(const std::string& name) = 0;
+    virtual UniformHandle resolveBlock(const std::string& name) = 0;
+
+    // 按句柄设置uniform，无效句柄被忽略
+    virtual void setUniform1i(UniformHandle handle, int value) = 0;
+    virtual void setUniform1f(UniformHandle handle, float value) = 0;
+    virtual void setUniform2f(UniformHandle handle, float x, float y) = 0;
+    virtual void setUniform3f(UniformHandle handle, float x, float y, float z) = 0;
+    virtual void setUniform4f(UniformHandle handle, float x, float y, float z, float w) = 0;
+    virtual void setUniformMatrix4f(UniformHandle handle, const float* matrix) = 0;
+
+    // 一次上传整个uniform块
+    virtual void setUniformBlock(UniformHandle handle, const void* data, size_t size) = 0;
+
+    // 按名称设置uniform（每次调用都要查找名称，只用于初始化等非热点路径）
+    void setUniform1i(const std::string& name, int value) { setUniform1i(resolve(name), value); }
+    void setUniform1f(const std::string& name, float value) { setUniform1f(resolve(name), value); }
+    void setUniform2f(const std::string& name, float x, float y) { setUniform2f(resolve(name), x, y); }
+    void setUniform3f(const std::string& name, float x, float y, float z) { setUniform3f(resolve(name), x, y, z); }
+    void setUniform4f(const std::string& name, float x, float y, float z, float w) { setUniform4f(resolve(name), x, y, z, w); }
+    void setUniformMatrix4f(const std::string& name, const float* matrix) { setUniformMatrix4f(resolve(name), matrix); }
 };
 
 // 纹理类
@@ -94,6 +320,16 @@ public:
     // 获取纹理尺寸
     virtual int getWidth() const = 0;
     virtual int getHeight() const = 0;
+
+    // 用RGBA8像素创建纹理（pixels为空时填充为透明黑色），后端不支持时返回false
+    virtual bool create(int width, int height, const uint32_t* pixels = nullptr) { return false; }
+
+    // 更新纹理的矩形区域（pixels为行优先、无行填充的RGBA8），超出范围或不支持时返回false
+    virtual bool update(int x, int y, int width, int height, const uint32_t* pixels) { return false; }
+
+    // 把alpha通道标记为有向距离场：alpha = 0.5 + 距离/(2*spread)，距离以纹素计、形状内部为正；spread为0时为普通纹理
+    // 采样时按屏幕上的纹素密度把距离转换为抗锯齿覆盖率，任意缩放都保持边缘清晰（用于SDF文字）
+    virtual void setDistanceField(float spread) {}
 };
 
 // 渲染器类
@@ -111,30 +347,152 @@ public:
     // 结束渲染
     void endRender();
 
+    // 设置后续绘制的图层，图层小的先绘制
+    void setLayer(int layer);
+    int getLayer() const;
+
+    // 设置后续绘制使用的着色器，空表示默认着色器
+    void setShader(Shader* shader);
+
+    // 设置每帧uniform块（投影、时段色调等），本帧每个着色器在首次绑定时上传一次
+    void setFrameUniforms(const FrameUniforms& uniforms);
+
+    // 设置每次刷新最多容纳的四边形数量
+    void setBatchCapacity(size_t quads);
+
+    // 获取本帧的批处理统计
+    const RenderStats& getRenderStats() const;
+
+    // 设置批处理顶点格式（VertexFormat::standard()或compact()），不支持的格式返回false
+    // 紧凑格式每个四边形64字节（标准格式144字节），UV需在0-1范围内
+    bool setVertexFormat(const VertexFormat& format);
+    const VertexFormat& getVertexFormat() const;
+
     // 绘制精灵
     void drawSprite(const Texture& texture, const Rect& srcRect, const Rect& dstRect, float rotation = 0.0f, const Color& color = Color(1.0f, 1.0f, 1.0f, 1.0f));
 
+    // 绘制图集区域中的精灵，srcRect为区域内的归一化矩形，按区域当前的页面和UV绘制
+    void drawSprite(const AtlasRegion& region, const Rect& srcRect, const Rect& dstRect, float rotation = 0.0f, const Color& color = Color(1.0f, 1.0f, 1.0f, 1.0f));
+
+    // 批量绘制同一纹理的精灵
+    // 设备支持实例化时只写入每实例数据，否则由SIMD内核在CPU上展开为顶点（见QuadKernel.h）
+    void drawSprites(const Texture& texture, const SpriteInstance* instances, size_t count);
+
+    // 启用/禁用实例化绘制（默认启用），设备不支持时drawSprites自动退回CPU展开
+    void setInstancingEnabled(bool enabled);
+    bool isInstancingActive() const;
+
+    // 启用流式上传：每次刷新的顶点、索引和实例写入容量为capacity字节的环形缓冲区（见StreamBuffer.h），
+    // endRender时插入围栏；capacity为0时关闭，设备直接读取批处理缓冲区
+    void setStreamBuffer(size_t capacity, unsigned int framesInFlight = 3);
+    const StreamBuffer* getStreamBuffer() const;
+
+    // 设置剔除矩形（通常为摄像机视口），完全在矩形外的四边形不进入批处理
+    void setCullRect(const Rect& rect);
+    void clearCullRect();
+    bool isCullingEnabled() const;
+    const Rect& getCullRect() const;
+
+    // 设置裁剪矩形（向外取整到像素），之后的绘制和设备clear只影响矩形内部，用于局部重绘
+    // 切换前先刷新已提交的绘制；设备不支持时返回false
+    bool setScissorRect(const Rect& rect);
+    void clearScissorRect();
+    bool isScissorEnabled() const;
+    const Rect& getScissorRect() const;
+
     // 绘制矩形
     void drawRect(const Rect& rect, const Color& color);
 
-    // 绘制线条
+    // 绘制线条（长度为0时不绘制）
     void drawLine(float x1, float y1, float x2, float y2, float width, const Color& color);
 
-    // 设置渲染目标
-    void setTargetTexture(Texture* texture = nullptr);
+    // 绘制折线（如钓鱼线、绳索），points为count个(x, y)
+    // 每条线段生成一个四边形，相邻线段在连接点的顶点位置相同（不共享顶点）；拐角按样式生成尖角或斜角，
+    // 斜角额外生成一个三角形填补外侧缺口，重合的相邻点被忽略；整条折线属于同一批次
+    void drawPolyline(const float* points, size_t count, const PolylineStyle& style);
+
+    // 批量绘制线条（长度为0的线段生成退化四边形，不会绘制）
+    void drawLines(const LineInstance* lines, size_t count);
+
+    // 按给定顺序绘制已排序的渲染命令（见RenderCommand.h），不再重新排序
+    // 此前立即模式提交的内容先刷新，命令回放后恢复当前图层和着色器
+    void drawCommands(const RenderCommand* const* commands, size_t count);
+
+    // 设置渲染目标，空表示默认帧缓冲区；切换前先刷新已提交的绘制，设备不支持时返回false
+    bool setTargetTexture(Texture* texture = nullptr);
+    Texture* getTargetTexture() const;
 
     // 获取图形设备
     GraphicsDevice* getDevice();
 
 private:
+    // 已提交的绘制：排序键（图层、着色器、纹理）及其在顶点缓冲区或实例缓冲区中的位置
+    // 逐顶点四边形每个一项，实例化精灵每次drawSprites一项
+    struct QuadEntry {
+        uint64_t key;
+        unsigned int order;         // 提交顺序，排序键相同时保持
+        unsigned int first;         // 首个顶点（四边形）或首个实例
+        unsigned int instanceCount; // 实例数量，0表示逐顶点四边形
+    };
+
     std::unique_ptr<GraphicsDevice> m_device;
     std::unique_ptr<Shader> m_defaultShader;
     std::vector<Vertex> m_vertices;
+    std::vector<PackedVertex> m_packedVertices;
     std::vector<unsigned int> m_indices;
+    bool m_compactVertices;
+
+    // 实例化
+    std::vector<PackedSpriteInstance> m_instances;
+    std::vector<PackedSpriteInstance> m_instanceScratch;
+    std::vector<float> m_polylineScratch;
+    std::unique_ptr<StreamBuffer> m_streamBuffer;
+    DeviceCapabilities m_capabilities;
+    bool m_instancingEnabled;
+
+    // 批处理
+    // 四边形直接写入预留的顶点缓冲区，刷新时按排序键排序后生成索引，
+    // 相邻且排序键相同的四边形合并为一次绘制调用。
+    std::vector<QuadEntry> m_quads;
+    std::vector<const Texture*> m_textureSlots;
+    std::vector<Shader*> m_shaderSlots;
+    std::vector<UniformHandle> m_shaderBlocks;      // 与m_shaderSlots对应的FrameUniforms块句柄
+    size_t m_batchCapacity;
+    int m_layer;
+    Shader* m_shader;
+    FrameUniforms m_frameUniforms;
+    bool m_hasFrameUniforms;
+    std::vector<Shader*> m_frameUniformShaders;   // 已上传本帧uniform块的着色器
+    bool m_presorted;           // 回放渲染命令时已按顺序提交，刷新时不排序
+    bool m_cullingEnabled;
+    Rect m_cullRect;
+    bool m_scissorEnabled;
+    Rect m_scissorRect;
+    Texture* m_targetTexture;
+    RenderStats m_renderStats;
 
     // 内部方法
     void flush();
     void setupDefaultShader();
+
+    // 为一个四边形分配4个顶点（缓冲区已满时先刷新），返回首个顶点的位置
+    unsigned int allocateQuad(const Texture* texture);
+
+    // 按当前顶点格式写入四边形顶点，positions依次为左上、右上、左下、右下的(x, y)
+    void writeQuad(unsigned int firstVertex, const float* positions, float u0, float v0, float u1, float v1, const Color& color);
+
+    // 计算排序键
+    uint64_t makeSortKey(const Texture* texture);
+
+    // 已提交的四边形数量（逐顶点与实例化），用于容量判断
+    size_t getPendingQuadCount() const;
+
+    // 四边形或精灵包围盒完全在剔除矩形外时计数并返回true
+    bool cullQuad(const float* positions);
+    bool cullSprite(const SpriteInstance& instance);
+
+    // 提交一段实例化绘制
+    void drawInstancedRange(const PackedSpriteInstance* instances, size_t count, const Texture* texture);
 };
 
 // 图形管理器类
@@ -148,8 +506,8 @@ public:
     // 清理图形系统
     void cleanup();
 
-    // 创建渲染器
-    std::unique_ptr<Renderer> createRenderer();
+    // 创建渲染器（使用软件光栅化设备，width/height为帧缓冲区尺寸）
+    std::unique_ptr<Renderer> createRenderer(int width = 1280, int height = 720);
 
     // 创建着色器
     std::unique_ptr<Shader> createShader();
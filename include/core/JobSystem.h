@@ -0,0 +1,120 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+namespace Appgame {
+
+class JobSystem;
+struct JobCounter;
+
+// 任务句柄：指向一个完成计数器，计数归零即表示任务（或一组任务）完成
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    // 句柄是否指向已调度的任务
+    bool isValid() const;
+
+    // 任务是否已完成（无效句柄视为已完成）
+    bool isComplete() const;
+
+private:
+    friend class JobSystem;
+    explicit JobHandle(std::shared_ptr<JobCounter> counter);
+
+    std::shared_ptr<JobCounter> m_counter;
+};
+
+// 工作窃取任务系统
+// 每个工作线程拥有自己的双端队列：本线程从队尾取任务，空闲线程从其他队列的队首窃取。
+// 非工作线程（如主线程）提交的任务进入共享的外部队列，同样可被窃取。
+class JobSystem {
+public:
+    struct Stats {
+        unsigned long long jobsExecuted;   // 已执行任务数
+        unsigned long long jobsStolen;     // 从其他队列窃取的任务数
+    };
+
+    JobSystem();
+    ~JobSystem();
+
+    // 初始化任务系统，workerCount为0时使用硬件线程数-1（调用线程在wait中也会执行任务）
+    bool init(unsigned int workerCount = 0);
+
+    // 清理任务系统（等待工作线程退出）
+    void cleanup();
+
+    // 调度单个任务
+    JobHandle schedule(std::function<void()> job);
+
+    // 调度依赖于其他任务的任务，所有依赖完成后才会进入队列
+    JobHandle schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies);
+
+    // 将区间[0, count)切分为大小为grainSize的块并行执行，返回覆盖所有块的句柄
+    JobHandle parallelFor(size_t count, size_t grainSize, std::function<void(size_t begin, size_t end)> body);
+
+    // 等待任务完成，等待期间调用线程会帮助执行队列中的任务
+    void wait(const JobHandle& handle);
+
+    // 获取工作线程数量
+    unsigned int getWorkerCount() const;
+
+    // 检查是否已初始化
+    bool isRunning() const;
+
+    // 获取统计信息
+    Stats getStats() const;
+
+private:
+    friend struct JobCounter;
+
+    struct Job;
+    struct WorkerQueue {
+        std::deque<std::shared_ptr<Job>> jobs;
+        std::mutex mutex;
+    };
+
+    // 工作线程主函数
+    void workerMain(unsigned int index);
+
+    // 创建任务并按依赖关系提交
+    JobHandle submit(std::function<void()> job, std::shared_ptr<JobCounter> counter, const std::vector<JobHandle>& dependencies);
+
+    // 将就绪任务放入队列
+    void enqueue(std::shared_ptr<Job> job);
+
+    // 取出一个可执行任务（先取本队列队尾，再窃取其他队列队首）
+    std::shared_ptr<Job> acquireJob(int ownIndex);
+
+    // 执行任务并处理完成通知
+    void execute(const std::shared_ptr<Job>& job);
+
+    // 当前线程对应的队列索引，非工作线程返回外部队列索引
+    int currentQueueIndex() const;
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+    // 空闲线程等待
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<int> m_queuedJobs;
+    std::atomic<bool> m_running;
+
+    // 统计
+    std::atomic<unsigned long long> m_jobsExecuted;
+    std::atomic<unsigned long long> m_jobsStolen;
+};
+
+} // namespace Appgame
+
+#endif // JOBSYSTEM_H
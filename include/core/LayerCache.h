@@ -0,0 +1,58 @@
+#ifndef LAYERCACHE_H
+#define LAYERCACHE_H
+
+#include "core/Graphics.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Appgame {
+
+// 静态图层缓存
+// 把很少变化的图层（钓鱼点背景、水面纹理、时段色调等）预先合成到纹理中，之后每帧只绘制一个四边形。
+// 图层内容由调用方给出的键标识（如钓鱼点、天气和时段），键变化或调用invalidate后下一次draw重新合成。
+// drawLayer以(originX, originY)为图层左上角绘制；合成结果按源alpha混合到透明背景上，适合不透明的背景图层。
+class LayerCache {
+public:
+    typedef std::function<void(Renderer& renderer, float originX, float originY)> DrawFunction;
+
+    struct Stats {
+        unsigned int rebuilds;      // 重新合成次数
+        unsigned int hits;          // 直接使用缓存的次数
+        unsigned int fallbacks;     // 设备不支持渲染目标而直接绘制的次数
+    };
+
+    LayerCache();
+    ~LayerCache();
+
+    // 绘制图层到dstRect；缓存无效时先以(0, 0)为原点把drawLayer的内容合成到纹理
+    // 设备不支持渲染目标时每次以dstRect左上角为原点直接执行drawLayer
+    void draw(Renderer& renderer, uint64_t key, const Rect& dstRect, const DrawFunction& drawLayer);
+
+    // 使缓存失效
+    void invalidate();
+
+    // 缓存是否对应key
+    bool isValid(uint64_t key) const;
+
+    // 获取缓存纹理（未合成时为空）
+    const Texture* getTexture() const;
+
+    // 获取统计信息
+    const Stats& getStats() const;
+
+private:
+    std::unique_ptr<Texture> m_texture;
+    uint64_t m_key;
+    bool m_valid;
+    int m_width;
+    int m_height;
+    Stats m_stats;
+
+    // 在缓存纹理中重新合成，失败返回false
+    bool rebuild(Renderer& renderer, int width, int height, const DrawFunction& drawLayer);
+};
+
+} // namespace Appgame
+
+#endif // LAYERCACHE_H
@@ -0,0 +1,42 @@
+#ifndef QUADKERNEL_H
+#define QUADKERNEL_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+
+namespace Appgame {
+
+// 四边形变换内核
+// 按编译目标选择实现：AVX2每次8个四边形，SSE2/NEON每次4个，其余平台使用标量实现。
+// 所有实现使用相同的sincos近似和运算顺序，输出只有舍入级别的差异。
+enum class QuadKernelType {
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+// 获取当前编译使用的内核
+QuadKernelType getQuadKernelType();
+
+// 获取内核名称
+const char* getQuadKernelName();
+
+// 获取内核每次处理的四边形数量
+int getQuadKernelWidth();
+
+// 快速sincos近似（多项式，|angle| < 8192时误差约1e-7）
+void fastSinCos(float angle, float& sine, float& cosine);
+
+// 把精灵实例变换为四边形顶点位置
+// 每个四边形输出8个float：左上、右上、左下、右下的(x, y)
+void transformSprites(const SpriteInstance* instances, size_t count, float* positions);
+void transformSpritesScalar(const SpriteInstance* instances, size_t count, float* positions);
+
+// 把线段展开为四边形顶点位置，输出布局同上
+void transformLines(const LineInstance* lines, size_t count, float* positions);
+void transformLinesScalar(const LineInstance* lines, size_t count, float* positions);
+
+} // namespace Appgame
+
+#endif // QUADKERNEL_H
@@ -0,0 +1,125 @@
+#ifndef RENDERCOMMAND_H
+#define RENDERCOMMAND_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Appgame {
+
+// 渲染命令：已变换的四边形及其64位排序键
+// 排序键布局（从高位到低位）：
+//   不透明：图层(16位) | 0 | 材质(24位) | 深度(23位)   同一图层内按材质分组，减少批次
+//   半透明：图层(16位) | 1 | 深度(23位) | 材质(24位)   同一图层内按深度由小到大绘制
+// 不透明命令排在同图层的半透明命令之前；没有深度测试时，同一图层内互相重叠的不透明命令应标记为半透明。
+struct RenderCommand {
+    uint64_t key;
+    const Texture* texture;
+    Shader* shader;
+    float positions[8];         // 左上、右上、左下、右下的(x, y)
+    float u0, v0, u1, v1;
+    Color color;
+};
+
+// 渲染命令缓冲区
+// 每个线程录制到自己的缓冲区，录制期间不需要加锁；材质号在合并时统一分配。
+class RenderCommandBuffer {
+public:
+    RenderCommandBuffer();
+
+    // 清空已录制的命令（不重置状态）
+    void clear();
+
+    // 设置后续命令的图层，图层小的先绘制
+    void setLayer(int layer);
+    int getLayer() const;
+
+    // 设置后续命令的深度，同一图层内深度小的先绘制（任意有限浮点数）
+    void setDepth(float depth);
+    float getDepth() const;
+
+    // 设置后续命令是否半透明（默认是）；颜色alpha小于1的命令总是按半透明处理
+    void setTranslucent(bool translucent);
+    bool isTranslucent() const;
+
+    // 设置后续命令使用的着色器，空表示默认着色器
+    void setShader(Shader* shader);
+
+    // 录制绘制命令，参数含义与Renderer相同
+    void drawSprite(const Texture& texture, const Rect& srcRect, const Rect& dstRect, float rotation = 0.0f, const Color& color = Color(1.0f, 1.0f, 1.0f, 1.0f));
+    void drawSprites(const Texture& texture, const SpriteInstance* instances, size_t count);
+    void drawRect(const Rect& rect, const Color& color);
+    void drawLine(float x1, float y1, float x2, float y2, float width, const Color& color);
+    void drawLines(const LineInstance* lines, size_t count);
+
+    // 获取已录制的命令
+    const std::vector<RenderCommand>& getCommands() const;
+
+    // 计算排序键
+    static uint64_t makeSortKey(int layer, bool translucent, float depth, uint32_t material);
+
+private:
+    std::vector<RenderCommand> m_commands;
+    int m_layer;
+    float m_depth;
+    bool m_translucent;
+    Shader* m_shader;
+
+    // 追加一条命令，材质号留空
+    RenderCommand& append(const Texture* texture, const Color& color);
+};
+
+// 渲染命令队列
+// 管理一组命令缓冲区；execute把所有缓冲区的命令合并、按排序键基数排序后回放到Renderer的批处理器。
+// 排序稳定：排序键相同的命令按(缓冲区序号, 录制顺序)绘制，结果与录制线程的调度无关。
+class RenderCommandQueue {
+public:
+    RenderCommandQueue();
+    ~RenderCommandQueue();
+
+    // 创建命令缓冲区（非线程安全，应在并行录制前创建）
+    RenderCommandBuffer& createBuffer();
+
+    // 获取命令缓冲区
+    RenderCommandBuffer& getBuffer(size_t index);
+    size_t getBufferCount() const;
+
+    // 合并、排序并回放所有命令，完成后清空各缓冲区
+    // 命令绘制在此前立即模式提交的内容之后
+    void execute(Renderer& renderer);
+
+    // 上次execute回放的命令数和材质数
+    size_t getLastCommandCount() const;
+    size_t getLastMaterialCount() const;
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        const RenderCommand* command;
+    };
+
+    // 材质：(着色器, 纹理)组合，按合并时首次出现的顺序编号
+    typedef std::pair<Shader*, const Texture*> Material;
+    struct MaterialHash {
+        size_t operator()(const Material& material) const;
+    };
+
+    std::vector<std::unique_ptr<RenderCommandBuffer>> m_buffers;
+    std::vector<SortEntry> m_entries;
+    std::vector<SortEntry> m_scratch;
+    std::vector<const RenderCommand*> m_sorted;
+    std::unordered_map<Material, uint32_t, MaterialHash> m_materials;
+    size_t m_lastCommandCount;
+    size_t m_lastMaterialCount;
+
+    // 按64位键做LSD基数排序（每趟8位，所有键该字节相同的趟跳过）
+    void radixSort();
+};
+
+} // namespace Appgame
+
+#endif // RENDERCOMMAND_H
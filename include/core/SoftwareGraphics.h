@@ -0,0 +1,245 @@
+#ifndef SOFTWAREGRAPHICS_H
+#define SOFTWAREGRAPHICS_H
+
+#include "core/Graphics.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+namespace Appgame {
+
+class JobSystem;
+
+// 软件纹理：RGBA8像素（内存字节顺序R、G、B、A），用于软件光栅化设备
+class SoftwareTexture : public Texture {
+public:
+    SoftwareTexture();
+
+    // 加载二进制PPM（P6）图像，alpha为255
+    bool loadFromFile(const std::string& filePath) override;
+    bool loadFromMemory(const void* data, size_t size) override;
+
+    // 软件设备无需绑定纹理单元
+    void bind(int unit = 0) override;
+
+    int getWidth() const override;
+    int getHeight() const override;
+
+    // 按尺寸创建纹理，pixels为空时填充为透明黑色
+    bool create(int width, int height, const uint32_t* pixels = nullptr) override;
+
+    // 更新矩形区域
+    bool update(int x, int y, int width, int height, const uint32_t* pixels) override;
+
+    // 距离场纹理在光栅化时按每个三角形的UV梯度转换覆盖率
+    void setDistanceField(float spread) override;
+    float getDistanceField() const;
+
+    // 获取像素数据（行优先，无行填充）
+    const uint32_t* getPixels() const;
+    uint32_t* getPixels();
+
+    // 双线性采样（u、v为归一化坐标，边缘钳制），结果为0-1范围的RGBA
+    Color sample(float u, float v) const;
+
+private:
+    // 作为渲染目标时，像素缓冲区交换给设备使用
+    friend class SoftwareGraphicsDevice;
+
+    int m_width;
+    int m_height;
+    float m_distanceFieldSpread;
+    std::vector<uint32_t> m_pixels;
+};
+
+// 软件着色器：固定管线（纹理颜色乘以顶点颜色，源alpha混合），只保存uniform值
+class SoftwareShader : public Shader {
+public:
+    SoftwareShader();
+
+    bool compile(const std::string& vertexSource, const std::string& fragmentSource) override;
+    void use() override;
+
+    // 软件管线不解析源码，任何名称都在首次解析时分配槽位
+    UniformHandle resolve(const std::string& name) override;
+    UniformHandle resolveBlock(const std::string& name) override;
+
+    using Shader::setUniform1i;
+    using Shader::setUniform1f;
+    using Shader::setUniform2f;
+    using Shader::setUniform3f;
+    using Shader::setUniform4f;
+    using Shader::setUniformMatrix4f;
+
+    void setUniform1i(UniformHandle handle, int value) override;
+    void setUniform1f(UniformHandle handle, float value) override;
+    void setUniform2f(UniformHandle handle, float x, float y) override;
+    void setUniform3f(UniformHandle handle, float x, float y, float z) override;
+    void setUniform4f(UniformHandle handle, float x, float y, float z, float w) override;
+    void setUniformMatrix4f(UniformHandle handle, const float* matrix) override;
+    void setUniformBlock(UniformHandle handle, const void* data, size_t size) override;
+
+    // 是否已编译
+    bool isCompiled() const;
+
+    // 获取uniform值（不存在时返回空）
+    const float* getUniform(const std::string& name) const;
+
+    // 获取uniform块数据（不存在时返回空）
+    const void* getUniformBlock(const std::string& name, size_t* size = nullptr) const;
+
+private:
+    struct UniformValue {
+        float values[16];
+        int count;
+    };
+
+    bool m_compiled;
+    std::unordered_map<std::string, int> m_uniformIndices;
+    std::vector<UniformValue> m_uniforms;
+    std::unordered_map<std::string, int> m_blockIndices;
+    std::vector<std::vector<uint8_t>> m_blocks;
+
+    void storeUniform(UniformHandle handle, const float* values, int count);
+};
+
+// 软件光栅化图形设备（无GPU环境下的基准测试与截图比较）
+// drawIndexed只做三角形建立并按64x64分块装箱，clear/swapBuffers/resolve时统一光栅化。
+// 各分块互不重叠，可通过任务系统并行执行；块内按提交顺序绘制，结果与线程数无关。
+// 顶点坐标为像素坐标（相对视口），像素中心采样，遵循左上填充规则。
+// 纹理必须保持有效直到下一次光栅化完成。
+class SoftwareGraphicsDevice : public GraphicsDevice {
+public:
+    // 光栅化统计（每次swapBuffers后更新为上一帧的数据）
+    struct Stats {
+        uint64_t drawCalls;         // drawIndexed/drawInstanced调用次数
+        uint64_t triangles;         // 参与光栅化的三角形数量
+        uint64_t culledTriangles;   // 退化或在视口外而被丢弃的三角形数量
+        uint64_t pixels;            // 写入的像素数量
+        uint64_t tileJobs;          // 执行光栅化的分块数量（同一分块多次光栅化分别计数）
+        float rasterTime;           // 光栅化耗时（毫秒）
+    };
+
+    SoftwareGraphicsDevice(int width, int height);
+    ~SoftwareGraphicsDevice() override;
+
+    bool init() override;
+    void cleanup() override;
+
+    // 光栅化未完成的绘制并结束本帧
+    void swapBuffers() override;
+
+    void setViewport(int x, int y, int width, int height) override;
+    void getViewport(int& x, int& y, int& width, int& height) const override;
+
+    // 先光栅化之前的绘制，再清除视口区域
+    void clear(const Color& color) override;
+
+    using GraphicsDevice::drawIndexed;
+    void drawIndexed(const void* vertices, const VertexFormat& format, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) override;
+
+    // 实例化绘制：单位四边形按实例变换后展开为三角形
+    DeviceCapabilities getCapabilities() const override;
+    void drawInstanced(const PackedSpriteInstance* instances, size_t count, const Texture* texture) override;
+
+    // 渲染到SoftwareTexture：与纹理交换像素缓冲区，解除绑定时换回（无复制）
+    // 绑定期间getPixels等读取的是目标纹理的内容，视口为整个纹理
+    bool setRenderTarget(Texture* texture) override;
+
+    // 裁剪矩形在三角形建立时与视口一起裁剪包围盒，clear只清除矩形内部
+    void setScissor(bool enabled, int x, int y, int width, int height) override;
+
+    std::unique_ptr<Shader> createShader() override;
+    std::unique_ptr<Texture> createTexture() override;
+
+    // 围栏：drawIndexed时已复制顶点属性，默认围栏立即完成；
+    // 设置帧延迟后围栏在之后第frames次swapBuffers时才完成，用于模拟GPU落后CPU若干帧
+    FenceID insertFence() override;
+    bool isFenceSignaled(FenceID fence) const override;
+    void waitFence(FenceID fence) override;
+    void setFrameLatency(unsigned int frames);
+
+    // 设置任务系统，非空且已初始化时分块并行光栅化
+    void setJobSystem(JobSystem* jobSystem);
+
+    // 立即光栅化所有未完成的绘制
+    void resolve();
+
+    // 当前绑定的渲染目标缓冲区访问（RGBA8，行优先）
+    int getWidth() const;
+    int getHeight() const;
+    const uint32_t* getPixels() const;
+    Color getPixel(int x, int y) const;
+
+    // 帧缓冲区内容的哈希值（FNV-1a），用于确定性比较
+    uint64_t getFramebufferHash() const;
+
+    // 保存帧缓冲区为二进制PPM（P6）图像
+    bool saveToFile(const std::string& filePath) const;
+
+    // 获取上一帧的光栅化统计
+    const Stats& getStats() const;
+
+private:
+    // 建立后的三角形：边函数与属性（顶点已按逆时针排列）
+    struct Triangle {
+        float edgeA[3], edgeB[3];       // 边函数 w = A*(x-ox) + B*(y-oy)
+        float edgeX[3], edgeY[3];       // 每条边的参考点（共享边两侧结果严格相反）
+        bool topLeft[3];                // 是否为左上边（w==0时包含）
+        float invArea;
+        float u[3], v[3];
+        float r[3], g[3], b[3], a[3];
+        int minX, minY, maxX, maxY;     // 包围盒（像素，maxX/maxY不包含）
+        const SoftwareTexture* texture;
+        float distanceScale;            // 距离场纹理：覆盖率 = (alpha - 0.5) * distanceScale + 0.5，0表示普通纹理
+        bool flat;                      // 无纹理、顶点颜色相同且不透明，走纯色填充
+        uint32_t flatColor;
+    };
+
+    void setupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const SoftwareTexture* texture);
+    void rasterizeTile(size_t tileIndex);
+    void rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1, int y1, uint64_t& pixels);
+
+    // 按当前尺寸重建分块
+    void resizeTiles();
+
+    // 当前的裁剪区域（视口、裁剪矩形与帧缓冲区的交集，x1/y1不包含）
+    void getClipRect(int& x0, int& y0, int& x1, int& y1) const;
+
+    int m_width;
+    int m_height;
+    int m_viewportX, m_viewportY, m_viewportWidth, m_viewportHeight;
+    bool m_scissorEnabled;
+    int m_scissor[4];
+    std::vector<uint32_t> m_colorBuffer;
+
+    // 渲染目标：绑定期间默认帧缓冲区及其尺寸、视口保存在这里
+    SoftwareTexture* m_target;
+    std::vector<uint32_t> m_savedColorBuffer;
+    int m_savedWidth, m_savedHeight;
+    int m_savedViewport[4];
+
+    // 分块装箱
+    int m_tilesX, m_tilesY;
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_tileBins;
+    std::vector<uint32_t> m_activeTiles;
+    std::vector<uint64_t> m_tilePixels;
+
+    JobSystem* m_jobSystem;
+
+    // 围栏：m_pendingFences按插入顺序保存(围栏, 剩余帧数)
+    FenceID m_lastFence;
+    FenceID m_signaledFence;
+    unsigned int m_frameLatency;
+    std::vector<std::pair<FenceID, unsigned int>> m_pendingFences;
+
+    Stats m_stats;
+    Stats m_frameStats;
+};
+
+} // namespace Appgame
+
+#endif // SOFTWAREGRAPHICS_H
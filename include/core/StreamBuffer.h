@@ -0,0 +1,69 @@
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Appgame {
+
+// 流式顶点/索引环形缓冲区
+// 每帧的动态顶点和索引依次写入同一块持久存储，不为每次刷新创建或重新分配缓冲区。
+// 每帧结束时插入围栏，围栏完成前该帧写入的区域不会被覆盖；最多framesInFlight帧的数据同时在途。
+// 写入位置绕回到仍在使用的区域时等待最早的围栏，并记为一次停顿。
+// 软件设备直接读取这块内存；GPU后端对应持久映射的缓冲区。
+class StreamBuffer {
+public:
+    struct Stats {
+        uint64_t bytesWritten;      // 已分配的字节数（含对齐）
+        unsigned int allocations;   // 分配次数
+        unsigned int wraps;         // 绕回缓冲区开头的次数
+        unsigned int stalls;        // 因数据仍在途而等待围栏的次数
+        float stallTime;            // 等待围栏的总耗时（毫秒）
+        unsigned int overflows;     // 单帧数据超出容量、分配失败的次数
+        unsigned int framesInFlight; // 当前在途帧数
+    };
+
+    StreamBuffer(GraphicsDevice* device, size_t capacity, unsigned int framesInFlight = 3);
+
+    // 分配一段可写区域并返回其地址，offset为在缓冲区中的偏移
+    // 与在途数据重叠时先等待围栏；本帧数据已占满缓冲区时返回空
+    void* allocate(size_t size, size_t alignment, size_t& offset);
+
+    // 写入数据，返回写入后的地址（失败时为空）
+    const void* write(const void* data, size_t size, size_t alignment = 16);
+
+    // 结束一帧：为本帧写入的区域插入围栏，在途帧数超过上限时等待最早的一帧
+    void endFrame();
+
+    // 获取缓冲区起始地址和容量
+    const uint8_t* getData() const;
+    size_t getCapacity() const;
+
+    // 获取统计信息
+    const Stats& getStats() const;
+
+private:
+    struct InFlightFrame {
+        FenceID fence;
+        size_t bytes;               // 该帧占用的字节数（含对齐和绕回时跳过的尾部）
+    };
+
+    // 回收围栏已完成的帧，wait为true时至少回收最早的一帧
+    void retire(bool wait);
+
+    GraphicsDevice* m_device;
+    std::vector<uint8_t> m_storage;
+    unsigned int m_maxFramesInFlight;
+    size_t m_head;
+    size_t m_used;
+    size_t m_frameBytes;
+    std::deque<InFlightFrame> m_frames;
+    Stats m_stats;
+};
+
+} // namespace Appgame
+
+#endif // STREAMBUFFER_H
@@ -0,0 +1,101 @@
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Appgame {
+
+// 多频率系统调度器
+// 每个系统按自己的频率更新（如天气1Hz、时间10Hz、鱼AI 30Hz、物理60Hz），
+// 各自拥有独立的时间累加器，回调收到的deltaTime固定为1/频率。
+// 同频率的系统注册时错开初始相位，使它们分散在不同帧执行。
+class SystemScheduler {
+public:
+    typedef int SystemID;
+
+    // 单个系统的统计信息
+    struct SystemStats {
+        std::string name;       // 系统名称
+        float rate;             // 更新频率（Hz，0表示每帧更新）
+        uint64_t ticks;         // 累计更新次数
+        float lastTickTime;     // 最近一次更新耗时（毫秒）
+        float avgTickTime;      // 平均更新耗时（毫秒）
+        float maxTickTime;      // 最大更新耗时（毫秒）
+        float budget;           // 单次更新预算（毫秒，0表示不限）
+        float budgetUsage;      // 平均耗时占预算的比例
+        uint64_t overBudgetTicks; // 超出预算的更新次数
+        float msPerSecond;      // 每秒模拟时间消耗的CPU时间（毫秒）
+    };
+
+    SystemScheduler();
+    ~SystemScheduler();
+
+    // 注册系统，rate为更新频率（Hz，0表示每帧使用帧deltaTime更新），budget为单次更新预算（毫秒）
+    SystemID addSystem(const std::string& name, float rate, std::function<void(float)> update, float budget = 0.0f);
+
+    // 移除系统
+    void removeSystem(SystemID id);
+
+    // 修改系统更新频率
+    void setRate(SystemID id, float rate);
+
+    // 获取系统更新频率
+    float getRate(SystemID id) const;
+
+    // 启用/禁用系统（禁用期间不累计时间）
+    void setEnabled(SystemID id, bool enabled);
+
+    // 设置单个系统每次update中最多补偿的更新次数，超出部分丢弃
+    void setMaxTicksPerUpdate(int maxTicks);
+
+    // 推进调度器
+    void update(float deltaTime);
+
+    // 获取统计信息
+    SystemStats getSystemStats(SystemID id) const;
+    std::vector<SystemStats> getAllStats() const;
+
+    // 获取上一次update中所有系统的总耗时（毫秒）
+    float getLastUpdateTime() const;
+
+    // 重置统计信息
+    void resetStats();
+
+private:
+    struct SystemEntry {
+        SystemID id;
+        std::string name;
+        float rate;
+        float period;
+        float accumulator;
+        float budget;
+        bool enabled;
+        std::function<void(float)> update;
+
+        // 统计
+        uint64_t ticks;
+        double totalTime;
+        double simulatedTime;
+        float lastTickTime;
+        float maxTickTime;
+        uint64_t overBudgetTicks;
+    };
+
+    // 执行一次系统更新并统计耗时
+    void tick(SystemEntry& entry, float deltaTime);
+
+    SystemEntry* findSystem(SystemID id);
+    const SystemEntry* findSystem(SystemID id) const;
+
+    std::vector<SystemEntry> m_systems;
+    SystemID m_nextId;
+    int m_maxTicksPerUpdate;
+    float m_lastUpdateTime;
+};
+
+} // namespace Appgame
+
+#endif // SYSTEMSCHEDULER_H
@@ -0,0 +1,79 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include "core/Font.h"
+#include "core/Graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Appgame {
+
+// 批量文字渲染器
+// 整串文字排版为一组字形四边形（字形串），按(文字, 字体, 字号)缓存排版结果，界面上静止的文字每帧不再重新排版；
+// 同一图集页的字形合并为一次drawSprites，同一字体的所有文字共享页面纹理，可在渲染器中继续合批。
+class TextRenderer {
+public:
+    struct Stats {
+        unsigned int hits;          // 命中缓存的字形串数量
+        unsigned int misses;        // 重新排版的字形串数量
+        unsigned int evictions;     // 被淘汰的字形串数量
+        size_t runs;                // 当前缓存的字形串数量
+    };
+
+    // maxRuns为缓存的字形串上限，超出时淘汰最久未使用的
+    explicit TextRenderer(size_t maxRuns = 256);
+    ~TextRenderer();
+
+    // 绘制UTF-8文字，(x, y)为第一行的左上角，size为字号（像素），'\n'换行
+    void drawText(Renderer& renderer, SdfFont& font, const std::string& text, float x, float y, float size, const Color& color);
+
+    // 测量文字的宽高（结果同样进入缓存）
+    void measureText(SdfFont& font, const std::string& text, float size, float& width, float& height);
+
+    // 清空缓存，字体销毁前需要调用
+    void clear();
+
+    // 获取统计信息
+    const Stats& getStats() const;
+
+private:
+    // 同一页面纹理上连续的字形
+    struct PageRange {
+        size_t page;
+        size_t first;
+        size_t count;
+    };
+
+    // 排版好的字形串，位置相对文字左上角
+    struct GlyphRun {
+        std::string text;
+        const SdfFont* font;
+        float size;
+        uint64_t key;
+        unsigned int generation;
+        float width, height;
+        std::vector<SpriteInstance> instances;
+        std::vector<PageRange> pages;
+    };
+
+    size_t m_maxRuns;
+    std::list<GlyphRun> m_runs;     // 最近使用的在前
+    std::unordered_map<uint64_t, std::list<GlyphRun>::iterator> m_index;
+    std::vector<uint32_t> m_codepoints;
+    std::vector<SpriteInstance> m_scratch;
+    Stats m_stats;
+
+    // 查找或排版字形串，并移到最近使用位置
+    const GlyphRun& getRun(SdfFont& font, const std::string& text, float size);
+
+    // 排版字形串
+    void layout(SdfFont& font, GlyphRun& run);
+};
+
+} // namespace Appgame
+
+#endif // TEXT_RENDERER_H
@@ -0,0 +1,169 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include "core/Graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Appgame {
+
+// 图集中的像素矩形
+struct AtlasRect {
+    int x, y;
+    int width, height;
+};
+
+// MaxRects装箱器（单页）
+// 维护互相可重叠的极大空闲矩形，按最短边适配放置。
+// 移除的矩形直接并入空闲列表，不与相邻空闲区域合并，碎片由TextureAtlas重新装箱消除。
+class MaxRectsPacker {
+public:
+    MaxRectsPacker(int width = 0, int height = 0);
+
+    // 清空并设置页面尺寸
+    void reset(int width, int height);
+
+    // 放置矩形，放不下时返回false
+    bool insert(int width, int height, AtlasRect& rect);
+
+    // 释放已放置的矩形
+    void remove(const AtlasRect& rect);
+
+    // 占用指定矩形（用于恢复刚释放的矩形，调用方保证它不与已占用的矩形重叠）
+    void occupy(const AtlasRect& rect);
+
+    int getWidth() const;
+    int getHeight() const;
+
+    // 已占用面积（像素）
+    size_t getUsedArea() const;
+
+    // 碎片率：1 - 最大空闲矩形面积 / 空闲面积，无空闲时为0
+    float getFragmentation() const;
+
+    // 获取空闲矩形
+    const std::vector<AtlasRect>& getFreeRects() const;
+
+private:
+    int m_width;
+    int m_height;
+    size_t m_usedArea;
+    std::vector<AtlasRect> m_freeRects;
+    std::vector<AtlasRect> m_newFreeRects;
+
+    // 从与used相交的空闲矩形中切出剩余部分
+    void splitFreeRects(const AtlasRect& used);
+
+    // 移除被其他空闲矩形包含的空闲矩形
+    void pruneFreeRects();
+};
+
+// 图集区域
+// 重新装箱后区域的页面和UV会原地更新，持有指针的调用方无需重新查找。
+struct AtlasRegion {
+    const Texture* texture;     // 所在图集页
+    size_t page;
+    AtlasRect rect;             // 像素区域（不含填充）
+    Rect uvRect;                // 归一化UV矩形
+
+    // 把区域内的归一化源矩形映射为图集页上的UV
+    Rect mapUV(const Rect& srcRect) const;
+};
+
+// 运行时纹理图集
+// 把图标、鱼类等小纹理打包到共享的图集页中，使用同一页的精灵可以合并为一个批次。
+// 每个区域四周保留padding像素并复制边缘像素，避免双线性采样时串色。
+// 插入放不下时新建页面；若现有页面空闲面积足够且碎片率超过阈值，同时标记需要重新装箱。
+// 重新装箱会重建页面内容并删除空页面，本帧已提交的绘制仍引用旧的UV和页面纹理，
+// 因此不在插入时进行，而是由调用方在帧之间调用repackIfPending执行。
+class TextureAtlas {
+public:
+    struct Stats {
+        size_t pages;               // 页面数
+        size_t regions;             // 区域数
+        float occupancy;            // 所有页面的平均占用率
+        float fragmentation;        // 各页面的最大碎片率
+        unsigned int repacks;       // 重新装箱次数
+    };
+
+    // 页面纹理由device创建（需支持Texture::create/update）
+    TextureAtlas(GraphicsDevice* device, int pageSize = 1024, int padding = 1);
+    ~TextureAtlas();
+
+    // 插入RGBA8图像，失败返回空
+    // 同名区域原地替换，已持有的区域指针保持有效；替换失败时原区域不变
+    const AtlasRegion* insert(const std::string& name, int width, int height, const uint32_t* pixels);
+
+    // 查找区域
+    const AtlasRegion* find(const std::string& name) const;
+
+    // 移除区域
+    bool remove(const std::string& name);
+
+    // 按尺寸从大到小重新装箱所有区域，并删除空页面
+    // 只能在帧之间调用（上一帧的绘制已经完成，本帧还没有使用图集）
+    // 需要新页面但无法创建时恢复原有布局并返回false
+    bool repack();
+
+    // 有插入时标记的重新装箱则执行，重新装箱成功时返回true，在帧开始时调用
+    bool repackIfPending();
+
+    // 是否有待执行的重新装箱
+    bool isRepackPending() const;
+
+    // 设置触发重新装箱的碎片率阈值（0-1，默认0.5）
+    void setRepackThreshold(float fragmentation);
+
+    // 页面存放有向距离场（如SDF字形）时设置其spread，现有和之后新建的页面都调用Texture::setDistanceField
+    void setDistanceField(float spread);
+
+    // 获取页面
+    size_t getPageCount() const;
+    const Texture* getPage(size_t index) const;
+
+    // 每次重新装箱后递增，缓存UV的调用方据此判断是否失效
+    unsigned int getGeneration() const;
+
+    // 获取统计信息
+    Stats getStats() const;
+
+private:
+    struct Page {
+        std::unique_ptr<Texture> texture;
+        MaxRectsPacker packer;
+    };
+
+    struct Entry {
+        AtlasRegion region;
+        AtlasRect slot;                 // 含填充的占用区域
+        std::vector<uint32_t> pixels;   // 含填充的像素，重新装箱时重新上传
+    };
+
+    GraphicsDevice* m_device;
+    int m_pageSize;
+    int m_padding;
+    float m_repackThreshold;
+    float m_distanceFieldSpread;
+    unsigned int m_generation;
+    unsigned int m_repacks;
+    bool m_repackPending;
+    std::vector<Page> m_pages;
+    std::unordered_map<std::string, Entry> m_entries;
+
+    // 在现有页面中放置，必要时新建页面
+    bool place(Entry& entry, bool allowNewPage);
+
+    // 新建页面
+    bool addPage();
+
+    // 空闲面积足够且碎片率超过阈值时返回true
+    bool shouldRepack(size_t area) const;
+};
+
+} // namespace Appgame
+
+#endif // TEXTUREATLAS_H
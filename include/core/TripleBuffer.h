@@ -0,0 +1,59 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+namespace Appgame {
+
+// 无锁三缓冲：一个写线程发布快照，一个读线程读取最新快照，双方互不阻塞
+// 写线程在getWriteBuffer()返回的槽中写入完整快照后调用publish()；
+// 发布后拿到的新写入槽保存的是更早的旧数据，需要整体覆盖。
+// 读线程调用acquire()获取最新已发布的快照，在下次acquire()之前该快照保持不变。
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : m_back(0)
+        , m_front(1)
+        , m_middle(2)
+    {
+    }
+
+    // 写线程：获取当前写入槽
+    T& getWriteBuffer() {
+        return m_buffers[m_back];
+    }
+
+    // 写线程：发布写入槽中的快照
+    void publish() {
+        int previous = m_middle.exchange(m_back | FRESH_BIT, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // 读线程：获取最新已发布的快照
+    const T& acquire() {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH_BIT) {
+            int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & INDEX_MASK;
+        }
+        return m_buffers[m_front];
+    }
+
+    // 读线程：是否有尚未读取的新快照
+    bool hasNewData() const {
+        return (m_middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+
+private:
+    static const int INDEX_MASK = 0x3;
+    static const int FRESH_BIT = 0x4;
+
+    T m_buffers[3];
+    int m_back;                 // 仅写线程访问
+    int m_front;                // 仅读线程访问
+    std::atomic<int> m_middle;  // 交换槽索引及新数据标记
+};
+
+} // namespace Appgame
+
+#endif // TRIPLEBUFFER_H
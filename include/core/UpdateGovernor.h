@@ -0,0 +1,95 @@
+#ifndef UPDATEGOVERNOR_H
+#define UPDATEGOVERNOR_H
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace Appgame {
+
+// 更新预算调节器：防止固定步长模式下的“死亡螺旋”
+// 每帧限制补偿更新的步数，超出部分直接丢弃（模拟时间落后于实际时间），
+// 并根据帧工作耗时与推进的模拟时间之比判断过载等级。
+// 过载等级上升立即生效，下降需连续若干帧低于阈值（带回差），变化时通知订阅者，
+// 订阅者可据此降低鱼AI频率、粒子数量、物理迭代次数等。
+class UpdateGovernor {
+public:
+    enum class OverloadLevel {
+        NONE,      // 正常
+        MODERATE,  // 接近预算上限，建议适度降级
+        SEVERE     // 已无法跟上实际时间，建议大幅降级
+    };
+
+    typedef int CallbackID;
+
+    struct Stats {
+        uint64_t frames;        // 统计帧数
+        uint64_t cappedFrames;  // 达到补偿上限的帧数
+        uint64_t droppedSteps;  // 丢弃的更新步数
+        double droppedTime;     // 丢弃的模拟时间（秒），即模拟累计落后于实际时间的量
+        float backlog;          // 本帧更新后剩余的积压时间（秒）
+        float load;             // 平滑后的负载（帧工作耗时 / 推进的模拟时间）
+        int lastSteps;          // 最近一帧的更新步数
+        int maxSteps;           // 单帧最大更新步数
+        OverloadLevel level;    // 当前过载等级
+        uint64_t levelChanges;  // 过载等级变化次数
+    };
+
+    UpdateGovernor();
+
+    // 设置每帧最多执行的更新步数（默认4）
+    void setMaxCatchUpSteps(int maxSteps);
+    int getMaxCatchUpSteps() const;
+
+    // 设置进入MODERATE/SEVERE等级的负载阈值（默认0.75/1.0）
+    void setLoadThresholds(float moderate, float severe);
+
+    // 设置降低过载等级前需要连续满足条件的帧数（默认120）
+    void setRecoveryFrames(int frames);
+
+    // 帧开始：计算本帧应执行的更新步数，超出上限的积压从accumulator中丢弃
+    int beginFrame(float& accumulator, float fixedStep);
+
+    // 帧结束：根据本帧执行的步数和工作耗时（毫秒，不含等待）更新负载和过载等级
+    void endFrame(int steps, float fixedStep, float workMilliseconds);
+
+    // 获取当前过载等级
+    OverloadLevel getOverloadLevel() const;
+
+    // 订阅过载等级变化，回调在游戏循环线程调用
+    CallbackID addOverloadCallback(std::function<void(OverloadLevel)> callback);
+
+    // 取消订阅
+    void removeOverloadCallback(CallbackID id);
+
+    // 获取/重置统计信息（不影响当前过载等级）
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    // 按负载和是否达到补偿上限判断过载等级，scale用于下降时的回差
+    OverloadLevel classify(float load, bool capped, float scale) const;
+
+    // 切换过载等级并通知订阅者
+    void setLevel(OverloadLevel level);
+
+    int m_maxCatchUpSteps;
+    float m_moderateThreshold;
+    float m_severeThreshold;
+    int m_recoveryFrames;
+
+    OverloadLevel m_level;
+    bool m_cappedThisFrame;
+    bool m_hasLoadSample;
+    int m_calmFrames;
+
+    Stats m_stats;
+
+    std::vector<std::pair<CallbackID, std::function<void(OverloadLevel)>>> m_callbacks;
+    CallbackID m_nextCallbackId;
+};
+
+} // namespace Appgame
+
+#endif // UPDATEGOVERNOR_H
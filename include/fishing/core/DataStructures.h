@@ -164,6 +164,32 @@ typedef struct {
     float32 lineTension;
 } GameState;
 
+// 鱼的渲染状态
+typedef struct {
+    FishTypeID typeId;
+    Vector2f position;
+    Vector2f velocity;
+    float32 size;
+    bool isHooked;
+} FishRenderState;
+
+// HUD显示数值
+typedef struct {
+    int32 playerLevel;
+    int32 playerMoney;
+    float32 playerExperience;
+    float32 reelingProgress;
+    float32 lineTension;
+} HUDValues;
+
+// 渲染快照：由更新线程写入并发布，渲染线程只读
+typedef struct {
+    uint64 frameIndex;
+    GameState gameState;
+    std::vector<FishRenderState> fishes;
+    HUDValues hud;
+} RenderSnapshot;
+
 // 配置数据结构
 typedef struct {
     int32 screenWidth;
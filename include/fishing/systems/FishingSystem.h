@@ -3,6 +3,8 @@
 
 #include "fishing/core/Types.h"
 #include "fishing/core/DataStructures.h"
+#include "core/SystemScheduler.h"
+#include "core/UpdateGovernor.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -77,12 +79,28 @@ public:
     // 获取物理管理器
     PhysicsManager* getPhysicsManager() const;
 
+    // 获取系统调度器（鱼AI和物理按各自频率更新）
+    Appgame::SystemScheduler& getSystemScheduler();
+
+    // 响应GameLoop过载信号：降低鱼AI更新频率和物理迭代次数，恢复时还原
+    void setOverloadLevel(Appgame::UpdateGovernor::OverloadLevel level);
+
+    // 获取当前过载等级
+    Appgame::UpdateGovernor::OverloadLevel getOverloadLevel() const;
+
+    // 订阅GameLoop更新调控器的过载信号，等级变化时调用setOverloadLevel；传空取消订阅
+    // 调控器必须在订阅期间保持有效，cleanup时自动取消订阅
+    void attachUpdateGovernor(Appgame::UpdateGovernor* governor);
+
     // 设置玩家数据
     void setPlayerData(PlayerData* playerData);
 
     // 获取玩家数据
     PlayerData* getPlayerData() const;
 
+    // 将当前钓鱼状态、鱼的位置和HUD数值写入渲染快照（完整覆盖，复用已有容量）
+    void captureRenderSnapshot(RenderSnapshot& snapshot) const;
+
 private:
     // 钓鱼状态
     FishingState m_fishingState;
@@ -117,6 +135,17 @@ private:
     // 物理管理器
     std::unique_ptr<PhysicsManager> m_physicsManager;
 
+    // 系统调度器
+    Appgame::SystemScheduler m_systemScheduler;
+    Appgame::SystemScheduler::SystemID m_fishSystemId;
+    Appgame::SystemScheduler::SystemID m_physicsSystemId;
+
+    // 过载降级
+    Appgame::UpdateGovernor::OverloadLevel m_overloadLevel;
+    int32 m_basePhysicsIterations;
+    Appgame::UpdateGovernor* m_updateGovernor;
+    Appgame::UpdateGovernor::CallbackID m_overloadCallbackId;
+
     // 玩家数据
     PlayerData* m_playerData;
 
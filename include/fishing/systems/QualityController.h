@@ -0,0 +1,131 @@
+#ifndef QUALITY_CONTROLLER_H
+#define QUALITY_CONTROLLER_H
+
+#include "fishing/core/Types.h"
+#include "fishing/core/DataStructures.h"
+#include "core/FrameHistogram.h"
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Appgame {
+struct RenderStats;
+}
+
+namespace FishingGame {
+
+// 画质变化事件
+struct QualityChangeEvent {
+    int32 previousLevel;        // 变化前的画质等级
+    int32 level;                // 当前画质等级（0为最低）
+    float32 detailScale;        // 细节系数（0-1），粒子数量、鱼LOD距离等按此缩放
+    float32 frameTime;          // 触发变化的窗口帧时间百分位数（毫秒）
+    GameConfig config;          // 调整后的画质设置
+};
+
+// 动态画质控制器
+// 按窗口统计帧时间百分位数（不含帧率控制等待），超出目标帧时间时逐级降低画质，
+// 连续多个窗口明显低于目标时逐级恢复（带回差和冷却，升级后很快又降级时加倍升级所需窗口数）。
+// 降级顺序按视觉损失从小到大：泛光 -> 抗锯齿 -> 阴影质量 -> 阴影 -> 纹理质量 -> 粒子。
+class QualityController {
+public:
+    typedef int32 CallbackID;
+
+    // 统计信息
+    struct Stats {
+        uint64 windows;             // 已评估的窗口数
+        uint64 downgrades;          // 降级次数
+        uint64 upgrades;            // 升级次数
+        float32 lastFrameTime;      // 最近一个窗口的帧时间百分位数（毫秒）
+        int32 upgradeWindows;       // 当前升级所需的连续窗口数
+    };
+
+    QualityController();
+    ~QualityController();
+
+    // 设置用户选择的画质（最高画质），并恢复到最高等级；等级或设置有变化时通知订阅者
+    void setBaseConfig(const GameConfig& config);
+
+    // 获取当前生效的画质设置
+    const GameConfig& getConfig() const;
+
+    // 设置目标帧率
+    void setTargetFrameRate(float32 fps);
+
+    // 设置用于判断的帧时间百分位数（默认90）
+    void setPercentile(float32 percentile);
+
+    // 设置降级/升级阈值（相对目标帧时间的比例，默认1.0/0.7）
+    void setThresholds(float32 downgradeRatio, float32 upgradeRatio);
+
+    // 设置每个评估窗口的帧数（默认60）
+    void setWindowFrames(int32 frames);
+
+    // 启用/禁用自动调整
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    // 记录一帧的工作耗时（毫秒），窗口满时评估并调整画质
+    void recordFrame(float32 frameTime);
+
+    // 获取/设置画质等级（0为最低，getMaxQualityLevel()为用户设置）
+    int32 getQualityLevel() const;
+    int32 getMaxQualityLevel() const;
+    void setQualityLevel(int32 level);
+
+    // 获取当前细节系数（0-1）
+    float32 getDetailScale() const;
+
+    // 订阅画质变化事件
+    CallbackID addQualityCallback(std::function<void(const QualityChangeEvent&)> callback);
+
+    // 取消订阅
+    void removeQualityCallback(CallbackID id);
+
+    // 获取统计信息
+    Stats getStats() const;
+
+    // 记录一帧的渲染统计（Renderer::getRenderStats()，在endRender之后调用）
+    void recordRenderStats(const Appgame::RenderStats& stats);
+
+    // 获取性能数据：帧率取自最近一个评估窗口，帧时间和渲染计数取自最近一帧
+    const PerformanceData& getPerformanceData() const;
+
+private:
+    // 评估一个窗口
+    void evaluateWindow();
+
+    // 按等级从用户设置生成画质设置
+    GameConfig buildConfig(int32 level) const;
+
+    // 切换画质等级并发送事件
+    void changeLevel(int32 level, float32 frameTime);
+
+    GameConfig m_baseConfig;
+    GameConfig m_config;
+    int32 m_level;
+
+    // 控制参数
+    float32 m_targetFrameTime;
+    float32 m_percentile;
+    float32 m_downgradeRatio;
+    float32 m_upgradeRatio;
+    int32 m_windowFrames;
+    bool m_enabled;
+
+    // 窗口统计
+    Appgame::FrameTimeHistogram m_window;
+    int32 m_goodWindows;
+    int32 m_cooldownWindows;
+    int32 m_windowsSinceUpgrade;
+
+    Stats m_stats;
+    PerformanceData m_performance;
+
+    std::vector<std::pair<CallbackID, std::function<void(const QualityChangeEvent&)>>> m_callbacks;
+    CallbackID m_nextCallbackId;
+};
+
+} // namespace FishingGame
+
+#endif // QUALITY_CONTROLLER_H
@@ -3,6 +3,7 @@
 
 #include "fishing/core/Types.h"
 #include "fishing/core/DataStructures.h"
+#include "core/SystemScheduler.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -196,6 +197,10 @@ public:
     // 获取当前钓鱼点
     FishingSpotID getCurrentFishingSpot() const;
 
+    // 静态图层（背景、水面纹理、时段色调）的缓存键，用于Appgame::LayerCache
+    // 只在钓鱼点、天气或时段变化时改变；天气/时段过渡期间按1/16进度变化
+    uint64 getStaticLayerKey() const;
+
 private:
     // 当前钓鱼点
     FishingSpotID m_currentFishingSpot;
@@ -276,12 +281,18 @@ public:
     // 检查场景是否存在
     bool hasScene(SceneType type) const;
 
+    // 检查当前场景是否为静态界面（主菜单、设置），静态界面下游戏循环可进入空闲模式
+    bool isCurrentSceneStatic() const;
+
     // 设置场景大小
     void setSceneSize(int32 width, int32 height);
 
     // 获取场景大小
     void getSceneSize(int32& width, int32& height) const;
 
+    // 获取系统调度器（天气、时间等慢变化系统按各自频率更新）
+    Appgame::SystemScheduler& getSystemScheduler();
+
 private:
     // 场景映射
     std::map<SceneType, Scene*> m_scenes;
@@ -302,6 +313,19 @@ private:
     int32 m_width;
     int32 m_height;
 
+    // 系统调度器
+    Appgame::SystemScheduler m_systemScheduler;
+
+    // 在调度器中注册的天气系统和时间系统（-1表示未注册）
+    Appgame::SystemScheduler::SystemID m_weatherSystemId;
+    Appgame::SystemScheduler::SystemID m_timeSystemId;
+
+    // 初始化系统调度器（重复调用时先移除之前注册的系统）
+    void initSystemScheduler();
+
+    // 从调度器中移除天气系统和时间系统
+    void clearSystemScheduler();
+
     // 初始化默认场景
     void initDefaultScenes();
 
@@ -230,6 +230,9 @@ private:
     // 根据输入类型调整UI元素
     void adjustUIElementsForInputType(InputType inputType);
 
+    // 把可见UI元素所在区域标记为需要重绘
+    void invalidate();
+
     // 计算UI元素位置
     void calculateUIElementPositions();
 
@@ -202,6 +202,9 @@ private:
     // 根据输入类型调整UI元素
     void adjustUIElementsForInputType(InputType inputType);
 
+    // 把可见UI元素和格子所在区域标记为需要重绘
+    void invalidate();
+
     // 计算背包格子位置
     void calculateInventorySlotPositions();
 
@@ -3,6 +3,9 @@
 
 #include "fishing/core/Types.h"
 #include "fishing/core/DataStructures.h"
+#include "core/FrameArena.h"
+#include "core/DirtyRegion.h"
+#include "core/TextRenderer.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -164,6 +167,9 @@ public:
     // 获取边界矩形
     virtual void getBounds(Rectf& bounds) const = 0;
 
+    // 标记UI元素需要重绘（内容变化时调用，位置、大小、可见性等变化时自动标记）
+    virtual void markDirty() = 0;
+
     // 响应式调整大小
     virtual void resize(float32 width, float32 height) = 0;
 
@@ -279,6 +285,9 @@ public:
     // 获取边界矩形
     void getBounds(Rectf& bounds) const override;
 
+    // 可见时把边界矩形加入UI管理器的脏区域
+    void markDirty() override;
+
     // 响应式调整大小
     void resize(float32 width, float32 height) override;
 
@@ -341,9 +350,61 @@ protected:
     void resizeChildren(float32 width, float32 height);
 };
 
+// 文字标签类
+// 通过UI管理器的SDF字体和批量文字渲染器绘制，没有设置字体或渲染器时不绘制文字
+class UILabel : public BaseUIElement {
+public:
+    UILabel(const std::string& name, uint32 id, const std::string& text, float32 fontSize);
+
+    // 渲染标签
+    void render() override;
+
+    // 设置UI管理器（设置字体后按实际字形测量大小）
+    void setUIManager(UIManager* uiManager) override;
+
+    // 设置文本（UTF-8）
+    void setText(const std::string& text);
+
+    // 获取文本
+    const std::string& getText() const;
+
+    // 设置字号
+    void setFontSize(float32 fontSize);
+
+    // 获取字号
+    float32 getFontSize() const;
+
+    // 设置文字颜色
+    void setColor(const Appgame::Color& color);
+
+    // 获取文字颜色
+    const Appgame::Color& getColor() const;
+
+private:
+    // 文本
+    std::string m_text;
+
+    // 字号
+    float32 m_fontSize;
+
+    // 文字颜色
+    Appgame::Color m_color;
+
+    // 根据文本和字号更新大小
+    void updateSize();
+};
+
 // UI管理器类
 class UIManager {
 public:
+    // 局部重绘统计
+    struct RedrawStats {
+        uint32 frames;          // 局部重绘模式下调用render的帧数
+        uint32 skippedFrames;   // 没有脏区域、完全跳过绘制的帧数
+        uint32 dirtyRects;      // 上一帧重绘的矩形数量
+        float32 dirtyArea;      // 上一帧重绘的面积（像素）
+    };
+
     UIManager();
     ~UIManager();
 
@@ -357,8 +418,45 @@ public:
     void update(float32 deltaTime);
 
     // 渲染UI管理器
+    // 设置渲染器后只重绘脏区域：逐个矩形设置裁剪矩形和剔除矩形，以背景色清除后重绘HUD、背包、商店和相交的UI元素，
+    // 区域外保留上一帧的内容；没有脏区域时不绘制任何内容
     void render();
 
+    // 设置局部重绘使用的渲染器，空表示每帧完整渲染
+    // 帧缓冲区即持久的后备缓冲区，调用方不能每帧清屏；UI下方的内容变化时调用invalidateAll
+    // 设备不支持裁剪矩形时每次重绘整个屏幕
+    void setRenderer(Appgame::Renderer* renderer);
+
+    // 获取渲染器
+    Appgame::Renderer* getRenderer() const;
+
+    // 设置局部重绘时清除脏区域的背景色
+    void setClearColor(const Appgame::Color& color);
+
+    // 设置标签使用的SDF字体，空表示不绘制文字；字体销毁前需要先清除
+    void setFont(Appgame::SdfFont* font);
+
+    // 获取字体
+    Appgame::SdfFont* getFont() const;
+
+    // 获取文字渲染器（所有标签共享字形串缓存）
+    Appgame::TextRenderer& getTextRenderer();
+
+    // 设置标签文本，element不是标签时忽略
+    static void setLabelText(UIElement* element, const std::string& text);
+
+    // 标记屏幕区域需要重绘
+    void invalidateRect(const Rectf& rect);
+
+    // 标记整个屏幕需要重绘
+    void invalidateAll();
+
+    // 是否有需要重绘的区域
+    bool isDirty() const;
+
+    // 获取局部重绘统计
+    const RedrawStats& getRedrawStats() const;
+
     // 处理输入
     bool handleInput(int32 inputType, int32 inputValue, float32 x, float32 y);
 
@@ -383,6 +481,9 @@ public:
     // 获取指定类型的UI元素
     std::vector<UIElement*> getUIElementsByType(UIElementType type) const;
 
+    // 获取指定类型的UI元素（结果分配在帧内存中，只在本帧内有效）
+    Appgame::FrameVector<UIElement*> getUIElementsByType(UIElementType type, Appgame::FrameArena& arena) const;
+
     // 显示HUD
     void showHUD();
 
@@ -520,6 +621,19 @@ private:
     // 下一个UI元素ID
     uint32 m_nextElementId;
 
+    // 局部重绘
+    Appgame::Renderer* m_renderer;
+    Appgame::DirtyRegion m_dirtyRegion;
+    Appgame::Color m_clearColor;
+    RedrawStats m_redrawStats;
+
+    // 文字渲染
+    Appgame::SdfFont* m_font;
+    Appgame::TextRenderer m_textRenderer;
+
+    // 渲染HUD、背包、商店和UI元素，bounds非空时跳过与其不相交的UI元素
+    void renderElements(const Rectf* bounds);
+
     // 初始化HUD
     void initHUD();
 
@@ -0,0 +1,194 @@
+#include "core/CullingGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Appgame {
+
+namespace {
+
+bool intersects(const Rect& a, const Rect& b) {
+    return a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+} // namespace
+
+CullingGrid::CullingGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 256.0f)
+    , m_inverseCellSize(1.0f / m_cellSize)
+    , m_queryStamp(0)
+{
+    m_stats = Stats();
+}
+
+CullingGrid::Handle CullingGrid::insert(const Rect& bounds, void* userData) {
+    Handle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_objects.size());
+        m_objects.emplace_back();
+    }
+
+    Object& object = m_objects[handle];
+    object.bounds = bounds;
+    object.userData = userData;
+    object.queryStamp = m_queryStamp;
+    object.active = true;
+    computeCells(bounds, object.cellX0, object.cellY0, object.cellX1, object.cellY1);
+    addToCells(handle);
+    m_stats.objects++;
+    return handle;
+}
+
+void CullingGrid::update(Handle handle, const Rect& bounds) {
+    if (handle >= m_objects.size() || !m_objects[handle].active) {
+        return;
+    }
+
+    Object& object = m_objects[handle];
+    object.bounds = bounds;
+    int x0, y0, x1, y1;
+    computeCells(bounds, x0, y0, x1, y1);
+    if (x0 == object.cellX0 && y0 == object.cellY0 && x1 == object.cellX1 && y1 == object.cellY1) {
+        return;
+    }
+
+    removeFromCells(handle);
+    object.cellX0 = x0;
+    object.cellY0 = y0;
+    object.cellX1 = x1;
+    object.cellY1 = y1;
+    addToCells(handle);
+}
+
+void CullingGrid::remove(Handle handle) {
+    if (handle >= m_objects.size() || !m_objects[handle].active) {
+        return;
+    }
+
+    removeFromCells(handle);
+    m_objects[handle].active = false;
+    m_objects[handle].userData = nullptr;
+    m_freeHandles.push_back(handle);
+    m_stats.objects--;
+}
+
+void CullingGrid::clear() {
+    m_objects.clear();
+    m_freeHandles.clear();
+    m_cells.clear();
+    m_stats = Stats();
+}
+
+size_t CullingGrid::query(const Rect& viewport, std::vector<void*>& visible) {
+    // 每次查询使用新的标记，跨格子的对象只检查一次
+    m_queryStamp++;
+    if (m_queryStamp == 0) {
+        for (Object& object : m_objects) {
+            object.queryStamp = 0;
+        }
+        m_queryStamp = 1;
+    }
+
+    m_candidates.clear();
+    m_stats.cellsVisited = 0;
+    int x0, y0, x1, y1;
+    computeCells(viewport, x0, y0, x1, y1);
+
+    // 视口覆盖的格子比非空格子多时改为遍历非空格子
+    size_t viewportCells = static_cast<size_t>(x1 - x0 + 1) * static_cast<size_t>(y1 - y0 + 1);
+    auto visitCell = [&](const std::vector<Handle>& handles) {
+        m_stats.cellsVisited++;
+        for (Handle handle : handles) {
+            Object& object = m_objects[handle];
+            if (object.queryStamp == m_queryStamp) {
+                continue;
+            }
+            object.queryStamp = m_queryStamp;
+            if (intersects(object.bounds, viewport)) {
+                m_candidates.push_back(handle);
+            }
+        }
+    };
+    if (viewportCells > m_cells.size()) {
+        for (const auto& cell : m_cells) {
+            int cellX = static_cast<int>(static_cast<int32_t>(cell.first >> 32));
+            int cellY = static_cast<int>(static_cast<int32_t>(cell.first & 0xFFFFFFFF));
+            if (cellX >= x0 && cellX <= x1 && cellY >= y0 && cellY <= y1) {
+                visitCell(cell.second);
+            }
+        }
+    } else {
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                auto it = m_cells.find(cellKey(x, y));
+                if (it != m_cells.end()) {
+                    visitCell(it->second);
+                }
+            }
+        }
+    }
+
+    // 按注册顺序输出，保证提交顺序与遍历格子的顺序无关
+    std::sort(m_candidates.begin(), m_candidates.end());
+    visible.clear();
+    for (Handle handle : m_candidates) {
+        visible.push_back(m_objects[handle].userData);
+    }
+
+    m_stats.submitted = m_candidates.size();
+    m_stats.culled = m_stats.objects - m_stats.submitted;
+    return m_stats.submitted;
+}
+
+const CullingGrid::Stats& CullingGrid::getStats() const {
+    return m_stats;
+}
+
+float CullingGrid::getCellSize() const {
+    return m_cellSize;
+}
+
+void CullingGrid::computeCells(const Rect& bounds, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = static_cast<int>(std::floor(bounds.x * m_inverseCellSize));
+    y0 = static_cast<int>(std::floor(bounds.y * m_inverseCellSize));
+    x1 = static_cast<int>(std::floor((bounds.x + bounds.width) * m_inverseCellSize));
+    y1 = static_cast<int>(std::floor((bounds.y + bounds.height) * m_inverseCellSize));
+}
+
+void CullingGrid::addToCells(Handle handle) {
+    const Object& object = m_objects[handle];
+    for (int y = object.cellY0; y <= object.cellY1; ++y) {
+        for (int x = object.cellX0; x <= object.cellX1; ++x) {
+            m_cells[cellKey(x, y)].push_back(handle);
+        }
+    }
+}
+
+void CullingGrid::removeFromCells(Handle handle) {
+    const Object& object = m_objects[handle];
+    for (int y = object.cellY0; y <= object.cellY1; ++y) {
+        for (int x = object.cellX0; x <= object.cellX1; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end()) {
+                continue;
+            }
+            std::vector<Handle>& handles = it->second;
+            auto position = std::find(handles.begin(), handles.end(), handle);
+            if (position != handles.end()) {
+                *position = handles.back();
+                handles.pop_back();
+            }
+            if (handles.empty()) {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
+
+uint64_t CullingGrid::cellKey(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+} // namespace Appgame
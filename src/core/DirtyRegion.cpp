@@ -0,0 +1,126 @@
+#include "core/DirtyRegion.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Appgame {
+
+namespace {
+
+// 两个矩形的包围盒面积不超过两者面积之和的这个倍数时合并（相邻的矩形总会合并）
+const float MERGE_WASTE_RATIO = 1.25f;
+
+float area(const Rect& rect) {
+    return rect.width * rect.height;
+}
+
+Rect unite(const Rect& a, const Rect& b) {
+    float x0 = std::min(a.x, b.x);
+    float y0 = std::min(a.y, b.y);
+    float x1 = std::max(a.x + a.width, b.x + b.width);
+    float y1 = std::max(a.y + a.height, b.y + b.height);
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+bool overlaps(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+} // namespace
+
+DirtyRegion::DirtyRegion(size_t maxRects)
+    : m_maxRects(maxRects > 0 ? maxRects : 1)
+{
+}
+
+void DirtyRegion::setBounds(const Rect& bounds) {
+    m_bounds = bounds;
+}
+
+const Rect& DirtyRegion::getBounds() const {
+    return m_bounds;
+}
+
+void DirtyRegion::add(const Rect& rect) {
+    float x0 = std::floor(rect.x);
+    float y0 = std::floor(rect.y);
+    float x1 = std::ceil(rect.x + rect.width);
+    float y1 = std::ceil(rect.y + rect.height);
+    if (m_bounds.width > 0.0f && m_bounds.height > 0.0f) {
+        x0 = std::max(x0, m_bounds.x);
+        y0 = std::max(y0, m_bounds.y);
+        x1 = std::min(x1, m_bounds.x + m_bounds.width);
+        y1 = std::min(y1, m_bounds.y + m_bounds.height);
+    }
+    if (!(x1 > x0) || !(y1 > y0)) {
+        return;
+    }
+    insert(Rect(x0, y0, x1 - x0, y1 - y0));
+
+    // 超过上限时合并面积增量最小的一对
+    while (m_rects.size() > m_maxRects) {
+        size_t bestA = 0;
+        size_t bestB = 1;
+        float bestCost = std::numeric_limits<float>::max();
+        for (size_t a = 0; a < m_rects.size(); ++a) {
+            for (size_t b = a + 1; b < m_rects.size(); ++b) {
+                float cost = area(unite(m_rects[a], m_rects[b])) - area(m_rects[a]) - area(m_rects[b]);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        Rect merged = unite(m_rects[bestA], m_rects[bestB]);
+        m_rects.erase(m_rects.begin() + bestB);
+        m_rects.erase(m_rects.begin() + bestA);
+        insert(merged);
+    }
+}
+
+void DirtyRegion::addAll() {
+    if (m_bounds.width > 0.0f && m_bounds.height > 0.0f) {
+        m_rects.clear();
+        add(m_bounds);
+    }
+}
+
+void DirtyRegion::clear() {
+    m_rects.clear();
+}
+
+bool DirtyRegion::isEmpty() const {
+    return m_rects.empty();
+}
+
+const std::vector<Rect>& DirtyRegion::getRects() const {
+    return m_rects;
+}
+
+float DirtyRegion::getArea() const {
+    float total = 0.0f;
+    for (const Rect& rect : m_rects) {
+        total += area(rect);
+    }
+    return total;
+}
+
+void DirtyRegion::insert(Rect rect) {
+    // 合并后的包围盒可能与其他矩形重叠，从头检查直到没有可合并的矩形
+    size_t index = 0;
+    while (index < m_rects.size()) {
+        const Rect& other = m_rects[index];
+        Rect merged = unite(rect, other);
+        if (overlaps(rect, other) || area(merged) <= (area(rect) + area(other)) * MERGE_WASTE_RATIO) {
+            rect = merged;
+            m_rects.erase(m_rects.begin() + index);
+            index = 0;
+        } else {
+            index++;
+        }
+    }
+    m_rects.push_back(rect);
+}
+
+} // namespace Appgame
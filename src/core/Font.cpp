@@ -0,0 +1,433 @@
+#include "core/Font.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace Appgame {
+
+namespace {
+
+// 距离变换中表示"无穷远"的平方距离
+const float DISTANCE_INFINITY = 1e20f;
+
+// 字形数据文件头
+const uint8_t FONT_MAGIC[4] = {'S', 'D', 'F', '1'};
+
+// 字形的图集像素：RGB为白色，由顶点颜色着色，alpha为距离
+const uint32_t GLYPH_COLOR = 0x00FFFFFFu;
+
+// 单个码点的UTF-8解码，返回消耗的字节数
+size_t decodeCodepoint(const unsigned char* text, size_t length, uint32_t& codepoint) {
+    const uint32_t REPLACEMENT = 0xFFFD;
+    unsigned char lead = text[0];
+    size_t count;
+    uint32_t minimum;
+    if (lead < 0x80) {
+        codepoint = lead;
+        return 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+        count = 2;
+        minimum = 0x80;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        count = 3;
+        minimum = 0x800;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        count = 4;
+        minimum = 0x10000;
+        codepoint = lead & 0x07;
+    } else {
+        codepoint = REPLACEMENT;
+        return 1;
+    }
+
+    // 截断的序列只消耗合法的前缀，后面的字节重新作为首字节解码
+    for (size_t i = 1; i < count; ++i) {
+        if (i >= length || (text[i] & 0xC0) != 0x80) {
+            codepoint = REPLACEMENT;
+            return i;
+        }
+        codepoint = (codepoint << 6) | (text[i] & 0x3F);
+    }
+
+    // 过长编码、代理项和超出范围的码点
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        codepoint = REPLACEMENT;
+    }
+    return count;
+}
+
+// 一维平方距离变换（Felzenszwalb & Huttenlocher下包络抛物线法），结果写回values
+void transform1d(float* values, int count, int stride, float* source, int* vertices, float* bounds) {
+    for (int i = 0; i < count; ++i) {
+        source[i] = values[i * stride];
+    }
+
+    int k = 0;
+    vertices[0] = 0;
+    bounds[0] = -DISTANCE_INFINITY;
+    bounds[1] = DISTANCE_INFINITY;
+    for (int q = 1; q < count; ++q) {
+        // 新抛物线与包络最右一条的交点落在其左界之前时，那一条不再属于下包络
+        float s;
+        while (true) {
+            int v = vertices[k];
+            s = ((source[q] + static_cast<float>(q) * q) - (source[v] + static_cast<float>(v) * v)) / static_cast<float>(2 * (q - v));
+            if (s > bounds[k] || k == 0) {
+                break;
+            }
+            k--;
+        }
+        k++;
+        vertices[k] = q;
+        bounds[k] = s;
+        bounds[k + 1] = DISTANCE_INFINITY;
+    }
+
+    k = 0;
+    for (int q = 0; q < count; ++q) {
+        while (bounds[k + 1] < static_cast<float>(q)) {
+            k++;
+        }
+        float offset = static_cast<float>(q - vertices[k]);
+        values[q * stride] = offset * offset + source[vertices[k]];
+    }
+}
+
+// 二维平方距离变换：先按列再按行
+void transform2d(std::vector<float>& grid, int width, int height) {
+    int size = std::max(width, height);
+    std::vector<float> source(size);
+    std::vector<int> vertices(size);
+    std::vector<float> bounds(size + 1);
+    for (int x = 0; x < width; ++x) {
+        transform1d(&grid[x], height, width, source.data(), vertices.data(), bounds.data());
+    }
+    for (int y = 0; y < height; ++y) {
+        transform1d(&grid[static_cast<size_t>(y) * width], width, 1, source.data(), vertices.data(), bounds.data());
+    }
+}
+
+template<typename T>
+void writeValue(std::vector<uint8_t>& data, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool readValue(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+void decodeUtf8(const std::string& text, std::vector<uint32_t>& codepoints) {
+    codepoints.clear();
+    codepoints.reserve(text.size());
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t offset = 0;
+    while (offset < text.size()) {
+        uint32_t codepoint;
+        offset += decodeCodepoint(bytes + offset, text.size() - offset, codepoint);
+        codepoints.push_back(codepoint);
+    }
+}
+
+void generateDistanceField(const uint8_t* coverage, int width, int height, int spread, std::vector<uint8_t>& field) {
+    spread = std::max(1, spread);
+    int fieldWidth = width + spread * 2;
+    int fieldHeight = height + spread * 2;
+    size_t count = static_cast<size_t>(fieldWidth) * fieldHeight;
+
+    // outside：到最近内部像素的平方距离；inside：到最近外部像素的平方距离
+    std::vector<float> outside(count, DISTANCE_INFINITY);
+    std::vector<float> inside(count, 0.0f);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (coverage[static_cast<size_t>(y) * width + x] >= 128) {
+                size_t index = static_cast<size_t>(y + spread) * fieldWidth + x + spread;
+                outside[index] = 0.0f;
+                inside[index] = DISTANCE_INFINITY;
+            }
+        }
+    }
+    transform2d(outside, fieldWidth, fieldHeight);
+    transform2d(inside, fieldWidth, fieldHeight);
+
+    // 像素中心到边缘的距离比到另一侧像素中心少半个像素
+    field.resize(count);
+    float scale = 0.5f / static_cast<float>(spread);
+    for (size_t i = 0; i < count; ++i) {
+        float distance = outside[i] > 0.0f ? -(std::sqrt(outside[i]) - 0.5f) : std::sqrt(inside[i]) - 0.5f;
+        float value = std::min(std::max(0.5f + distance * scale, 0.0f), 1.0f);
+        field[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+}
+
+SdfFont::SdfFont(GraphicsDevice* device, int baseSize, int spread, int pageSize)
+    : m_device(device)
+    , m_pageSize(pageSize)
+    , m_source(nullptr)
+    , m_baseSize(std::max(1, baseSize))
+    , m_spread(std::max(1, spread))
+    , m_ascent(static_cast<float>(m_baseSize) * 0.8f)
+    , m_lineHeight(static_cast<float>(m_baseSize) * 1.2f)
+    , m_fallback('?')
+    , m_repackThreshold(-1.0f)
+    , m_generationBase(0) {
+    m_stats = Stats();
+    resetAtlas();
+}
+
+SdfFont::~SdfFont() {
+}
+
+void SdfFont::setSource(GlyphSource* source) {
+    m_source = source;
+    m_missing.clear();
+    if (m_source) {
+        m_source->getMetrics(m_baseSize, m_ascent, m_lineHeight);
+    }
+}
+
+size_t SdfFont::preload(const std::string& text) {
+    std::vector<uint32_t> codepoints;
+    decodeUtf8(text, codepoints);
+
+    size_t generated = 0;
+    for (uint32_t codepoint : codepoints) {
+        if (m_glyphs.find(codepoint) == m_glyphs.end() && m_missing.find(codepoint) == m_missing.end() &&
+            generateGlyph(codepoint)) {
+            generated++;
+        }
+    }
+    return generated;
+}
+
+const SdfFont::Glyph* SdfFont::getGlyph(uint32_t codepoint) {
+    auto it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end()) {
+        return &it->second;
+    }
+
+    const Glyph* glyph = nullptr;
+    if (m_missing.find(codepoint) == m_missing.end()) {
+        glyph = generateGlyph(codepoint);
+    }
+    if (!glyph && codepoint != m_fallback) {
+        glyph = getGlyph(m_fallback);
+    }
+    return glyph;
+}
+
+void SdfFont::setFallback(uint32_t codepoint) {
+    m_fallback = codepoint;
+}
+
+void SdfFont::setRepackThreshold(float fragmentation) {
+    m_repackThreshold = fragmentation;
+    m_atlas->setRepackThreshold(fragmentation);
+}
+
+int SdfFont::getBaseSize() const {
+    return m_baseSize;
+}
+
+int SdfFont::getSpread() const {
+    return m_spread;
+}
+
+float SdfFont::getAscent() const {
+    return m_ascent;
+}
+
+float SdfFont::getLineHeight() const {
+    return m_lineHeight;
+}
+
+bool SdfFont::repackIfPending() {
+    return m_atlas->repackIfPending();
+}
+
+unsigned int SdfFont::getGeneration() const {
+    return m_generationBase + m_atlas->getGeneration();
+}
+
+bool SdfFont::saveToMemory(std::vector<uint8_t>& data) const {
+    data.clear();
+    data.insert(data.end(), FONT_MAGIC, FONT_MAGIC + sizeof(FONT_MAGIC));
+    writeValue(data, static_cast<int32_t>(m_baseSize));
+    writeValue(data, static_cast<int32_t>(m_spread));
+    writeValue(data, m_ascent);
+    writeValue(data, m_lineHeight);
+    writeValue(data, static_cast<uint32_t>(m_codepoints.size()));
+
+    // 按生成顺序写出，加载后的装箱结果与生成时一致
+    for (uint32_t codepoint : m_codepoints) {
+        const Glyph& glyph = m_glyphs.at(codepoint);
+        const FieldData& field = m_fields.at(codepoint);
+        writeValue(data, codepoint);
+        writeValue(data, glyph.left);
+        writeValue(data, glyph.top);
+        writeValue(data, glyph.advance);
+        writeValue(data, static_cast<int32_t>(field.width));
+        writeValue(data, static_cast<int32_t>(field.height));
+        data.insert(data.end(), field.values.begin(), field.values.end());
+    }
+    return true;
+}
+
+bool SdfFont::loadFromMemory(const void* data, size_t size) {
+    const uint8_t* cursor = static_cast<const uint8_t*>(data);
+    const uint8_t* end = cursor + size;
+    if (!data || size < sizeof(FONT_MAGIC) || std::memcmp(cursor, FONT_MAGIC, sizeof(FONT_MAGIC)) != 0) {
+        return false;
+    }
+    cursor += sizeof(FONT_MAGIC);
+
+    int32_t baseSize, spread;
+    float ascent, lineHeight;
+    uint32_t count;
+    if (!readValue(cursor, end, baseSize) || !readValue(cursor, end, spread) || !readValue(cursor, end, ascent) ||
+        !readValue(cursor, end, lineHeight) || !readValue(cursor, end, count) || baseSize <= 0 || spread <= 0) {
+        return false;
+    }
+
+    // 先完整解析，数据损坏时保留现有字形
+    std::vector<std::pair<uint32_t, Glyph>> glyphs;
+    std::vector<FieldData> fields;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t codepoint;
+        Glyph glyph;
+        int32_t fieldWidth, fieldHeight;
+        if (!readValue(cursor, end, codepoint) || !readValue(cursor, end, glyph.left) || !readValue(cursor, end, glyph.top) ||
+            !readValue(cursor, end, glyph.advance) || !readValue(cursor, end, fieldWidth) || !readValue(cursor, end, fieldHeight) ||
+            fieldWidth < 0 || fieldHeight < 0) {
+            return false;
+        }
+        size_t bytes = static_cast<size_t>(fieldWidth) * static_cast<size_t>(fieldHeight);
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            return false;
+        }
+        glyph.region = nullptr;
+        glyph.width = static_cast<float>(fieldWidth);
+        glyph.height = static_cast<float>(fieldHeight);
+
+        FieldData field;
+        field.width = fieldWidth;
+        field.height = fieldHeight;
+        field.values.assign(cursor, cursor + bytes);
+        cursor += bytes;
+        glyphs.push_back(std::make_pair(codepoint, glyph));
+        fields.push_back(std::move(field));
+    }
+
+    m_baseSize = baseSize;
+    m_spread = spread;
+    m_ascent = ascent;
+    m_lineHeight = lineHeight;
+    m_glyphs.clear();
+    m_fields.clear();
+    m_missing.clear();
+    m_codepoints.clear();
+    resetAtlas();
+
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        if (!addGlyph(glyphs[i].first, glyphs[i].second, std::move(fields[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const TextureAtlas& SdfFont::getAtlas() const {
+    return *m_atlas;
+}
+
+const SdfFont::Stats& SdfFont::getStats() const {
+    return m_stats;
+}
+
+const SdfFont::Glyph* SdfFont::generateGlyph(uint32_t codepoint) {
+    if (!m_source) {
+        return nullptr;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    GlyphBitmap bitmap;
+    if (!m_source->rasterize(codepoint, m_baseSize, bitmap)) {
+        m_missing.insert(codepoint);
+        m_stats.missing++;
+        return nullptr;
+    }
+
+    Glyph glyph;
+    glyph.region = nullptr;
+    glyph.left = 0.0f;
+    glyph.top = 0.0f;
+    glyph.width = 0.0f;
+    glyph.height = 0.0f;
+    glyph.advance = bitmap.advance;
+
+    FieldData field;
+    field.width = 0;
+    field.height = 0;
+    size_t pixels = static_cast<size_t>(std::max(bitmap.width, 0)) * static_cast<size_t>(std::max(bitmap.height, 0));
+    if (pixels > 0 && bitmap.coverage.size() >= pixels) {
+        generateDistanceField(bitmap.coverage.data(), bitmap.width, bitmap.height, m_spread, field.values);
+        field.width = bitmap.width + m_spread * 2;
+        field.height = bitmap.height + m_spread * 2;
+        glyph.left = bitmap.bearingX - static_cast<float>(m_spread);
+        glyph.top = -(bitmap.bearingY + static_cast<float>(m_spread));
+        glyph.width = static_cast<float>(field.width);
+        glyph.height = static_cast<float>(field.height);
+    }
+
+    m_stats.generated++;
+    m_stats.generateTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return addGlyph(codepoint, glyph, std::move(field));
+}
+
+const SdfFont::Glyph* SdfFont::addGlyph(uint32_t codepoint, const Glyph& metrics, FieldData field) {
+    Glyph glyph = metrics;
+    glyph.region = nullptr;
+    if (field.width > 0 && field.height > 0) {
+        std::vector<uint32_t> pixels(field.values.size());
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = GLYPH_COLOR | (static_cast<uint32_t>(field.values[i]) << 24);
+        }
+        glyph.region = m_atlas->insert(std::to_string(codepoint), field.width, field.height, pixels.data());
+        if (!glyph.region) {
+            return nullptr;
+        }
+    }
+
+    if (m_glyphs.find(codepoint) == m_glyphs.end()) {
+        m_codepoints.push_back(codepoint);
+    }
+    m_fields[codepoint] = std::move(field);
+    Glyph& stored = m_glyphs[codepoint] = glyph;
+    m_stats.glyphs = m_glyphs.size();
+    return &stored;
+}
+
+void SdfFont::resetAtlas() {
+    if (m_atlas) {
+        m_generationBase += m_atlas->getGeneration() + 1;
+    }
+    m_atlas = std::make_unique<TextureAtlas>(m_device, m_pageSize, 1);
+    m_atlas->setDistanceField(static_cast<float>(m_spread));
+    if (m_repackThreshold >= 0.0f) {
+        m_atlas->setRepackThreshold(m_repackThreshold);
+    }
+    m_stats.glyphs = 0;
+}
+
+} // namespace Appgame
@@ -0,0 +1,130 @@
+#include "core/FrameArena.h"
+#include <algorithm>
+#include <atomic>
+
+namespace Appgame {
+
+namespace {
+
+// 对齐到alignment的整数倍（alignment为2的幂）
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+std::atomic<uint64_t> g_heapAllocations(0);
+std::atomic<uint64_t> g_heapFrees(0);
+std::atomic<uint64_t> g_heapBytes(0);
+
+} // namespace
+
+FrameArena::FrameArena(size_t capacity)
+    : m_buffer(nullptr)
+    , m_capacity(capacity)
+    , m_offset(0)
+    , m_peakUsed(0)
+    , m_overflowBytes(0)
+    , m_overflowCount(0)
+{
+    if (m_capacity > 0) {
+        m_buffer = static_cast<char*>(::operator new(m_capacity));
+    }
+}
+
+FrameArena::~FrameArena() {
+    for (void* block : m_overflowBlocks) {
+        ::operator delete(block);
+    }
+    ::operator delete(m_buffer);
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    // 主缓冲区按实际地址对齐，保证任意对齐要求都成立
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer);
+    size_t alignedOffset = alignUp(base + m_offset, alignment) - base;
+    if (m_buffer && alignedOffset + size <= m_capacity) {
+        m_offset = alignedOffset + size;
+        m_peakUsed = std::max(m_peakUsed, m_offset + m_overflowBytes);
+        return m_buffer + alignedOffset;
+    }
+
+    // 容量不足：分配溢出块，下次reset时释放
+    size_t blockSize = size + alignment;
+    char* block = static_cast<char*>(::operator new(blockSize));
+    m_overflowBlocks.push_back(block);
+    m_overflowBytes += blockSize;
+    m_overflowCount++;
+    m_peakUsed = std::max(m_peakUsed, m_offset + m_overflowBytes);
+
+    uintptr_t blockBase = reinterpret_cast<uintptr_t>(block);
+    return block + (alignUp(blockBase, alignment) - blockBase);
+}
+
+void FrameArena::reset() {
+    if (!m_overflowBlocks.empty()) {
+        for (void* block : m_overflowBlocks) {
+            ::operator delete(block);
+        }
+        m_overflowBlocks.clear();
+
+        // 按峰值用量扩大主缓冲区，后续帧不再溢出
+        size_t newCapacity = std::max(m_capacity * 2, alignUp(m_peakUsed, 4096));
+        ::operator delete(m_buffer);
+        m_buffer = static_cast<char*>(::operator new(newCapacity));
+        m_capacity = newCapacity;
+        m_overflowBytes = 0;
+    }
+    m_offset = 0;
+}
+
+FrameArena::Marker FrameArena::getMarker() const {
+    return m_offset;
+}
+
+void FrameArena::rewind(Marker marker) {
+    if (marker <= m_offset) {
+        m_offset = marker;
+    }
+}
+
+size_t FrameArena::getCapacity() const {
+    return m_capacity;
+}
+
+size_t FrameArena::getUsed() const {
+    return m_offset + m_overflowBytes;
+}
+
+size_t FrameArena::getPeakUsed() const {
+    return m_peakUsed;
+}
+
+uint64_t FrameArena::getOverflowCount() const {
+    return m_overflowCount;
+}
+
+HeapStats getHeapStats() {
+    HeapStats stats;
+    stats.allocations = g_heapAllocations.load(std::memory_order_relaxed);
+    stats.frees = g_heapFrees.load(std::memory_order_relaxed);
+    stats.bytes = g_heapBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool isHeapTrackingEnabled() {
+    return g_heapAllocations.load(std::memory_order_relaxed) > 0;
+}
+
+void recordHeapAllocation(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_heapBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void recordHeapFree() {
+    g_heapFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Appgame
@@ -0,0 +1,109 @@
+#include "core/FrameHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Appgame {
+
+FrameTimeHistogram::FrameTimeHistogram() {
+    reset();
+}
+
+void FrameTimeHistogram::record(float milliseconds) {
+    if (!(milliseconds >= 0.0f)) {
+        milliseconds = 0.0f;
+    }
+
+    double micros = std::min(static_cast<double>(milliseconds) * 1000.0, 4294967295.0);
+    uint64_t value = static_cast<uint64_t>(micros + 0.5);
+
+    m_counts[indexFor(value)]++;
+    m_count++;
+    m_sumMicros += static_cast<double>(value);
+    m_minMicros = std::min(m_minMicros, value);
+    m_maxMicros = std::max(m_maxMicros, value);
+}
+
+float FrameTimeHistogram::getPercentile(float percentile) const {
+    if (m_count == 0) {
+        return 0.0f;
+    }
+
+    percentile = std::max(0.0f, std::min(percentile, 100.0f));
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += m_counts[i];
+        if (cumulative >= target) {
+            // 返回桶上界，但不超过实际记录的最大/最小值
+            uint64_t value = std::min(upperBoundFor(i), m_maxMicros);
+            value = std::max(value, m_minMicros);
+            return static_cast<float>(value) / 1000.0f;
+        }
+    }
+    return static_cast<float>(m_maxMicros) / 1000.0f;
+}
+
+uint64_t FrameTimeHistogram::getCount() const {
+    return m_count;
+}
+
+float FrameTimeHistogram::getMin() const {
+    return m_count > 0 ? static_cast<float>(m_minMicros) / 1000.0f : 0.0f;
+}
+
+float FrameTimeHistogram::getMax() const {
+    return static_cast<float>(m_maxMicros) / 1000.0f;
+}
+
+float FrameTimeHistogram::getMean() const {
+    return m_count > 0 ? static_cast<float>(m_sumMicros / static_cast<double>(m_count) / 1000.0) : 0.0f;
+}
+
+void FrameTimeHistogram::merge(const FrameTimeHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_sumMicros += other.m_sumMicros;
+    m_minMicros = std::min(m_minMicros, other.m_minMicros);
+    m_maxMicros = std::max(m_maxMicros, other.m_maxMicros);
+}
+
+void FrameTimeHistogram::reset() {
+    m_counts.fill(0);
+    m_count = 0;
+    m_minMicros = UINT64_MAX;
+    m_maxMicros = 0;
+    m_sumMicros = 0.0;
+}
+
+int FrameTimeHistogram::indexFor(uint64_t microseconds) {
+    if (microseconds < static_cast<uint64_t>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(microseconds);
+    }
+
+    // 最高有效位决定段，段内保留SUB_BUCKET_BITS位精度
+    int msb = 63;
+    while (!(microseconds & (uint64_t(1) << msb))) {
+        --msb;
+    }
+    int shift = msb - (SUB_BUCKET_BITS - 1);
+    int subBucket = static_cast<int>(microseconds >> shift);
+    int index = SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF);
+    return std::min(index, BUCKET_COUNT - 1);
+}
+
+uint64_t FrameTimeHistogram::upperBoundFor(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<uint64_t>(index);
+    }
+
+    int offset = index - SUB_BUCKET_COUNT;
+    int shift = offset / SUB_BUCKET_HALF + 1;
+    uint64_t subBucket = static_cast<uint64_t>(offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+} // namespace Appgame
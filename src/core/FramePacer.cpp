@@ -0,0 +1,134 @@
+#include "core/FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace Appgame {
+
+namespace {
+
+// 自旋等待时让出流水线资源，降低功耗并避免影响超线程的另一逻辑核
+inline void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// 粗粒度睡眠的步长
+const std::chrono::milliseconds SLEEP_STEP(1);
+
+// 睡眠估计值的初始值与上限（毫秒）
+const double INITIAL_SLEEP_ESTIMATE = 2.0;
+const double MAX_SLEEP_ESTIMATE = 8.0;
+
+} // namespace
+
+FramePacer::FramePacer()
+    : m_mode(Mode::HYBRID)
+    , m_missTolerance(0.5f)
+    , m_sleepMean(INITIAL_SLEEP_ESTIMATE)
+    , m_sleepM2(0.0)
+    , m_sleepSamples(0)
+    , m_sleepEstimate(INITIAL_SLEEP_ESTIMATE)
+    , m_missedDeadlines(0)
+{
+}
+
+void FramePacer::setMode(Mode mode) {
+    m_mode = mode;
+}
+
+FramePacer::Mode FramePacer::getMode() const {
+    return m_mode;
+}
+
+void FramePacer::setMissTolerance(float milliseconds) {
+    m_missTolerance = milliseconds;
+}
+
+void FramePacer::waitUntil(std::chrono::steady_clock::time_point deadline) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+        return;
+    }
+
+    switch (m_mode) {
+    case Mode::SLEEP:
+        std::this_thread::sleep_until(deadline);
+        break;
+    case Mode::HYBRID:
+        sleepCoarse(deadline);
+        spinUntil(deadline);
+        break;
+    case Mode::BUSY:
+        spinUntil(deadline);
+        break;
+    }
+
+    float error = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - deadline).count();
+    m_errorHistogram.record(error);
+    if (error > m_missTolerance) {
+        m_missedDeadlines++;
+    }
+}
+
+FramePacer::Stats FramePacer::getStats() const {
+    Stats stats;
+    stats.waitCount = m_errorHistogram.getCount();
+    stats.missedDeadlines = m_missedDeadlines;
+    stats.avgError = m_errorHistogram.getMean();
+    stats.maxError = m_errorHistogram.getMax();
+    stats.p99Error = m_errorHistogram.getPercentile(99.0f);
+    stats.sleepEstimate = static_cast<float>(m_sleepEstimate);
+    return stats;
+}
+
+void FramePacer::resetStats() {
+    m_errorHistogram.reset();
+    m_missedDeadlines = 0;
+}
+
+void FramePacer::sleepCoarse(std::chrono::steady_clock::time_point deadline) {
+    // 只要剩余时间仍大于一次睡眠可能的实际耗时，就继续以1ms为步长睡眠
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        double remaining = std::chrono::duration<double, std::milli>(deadline - now).count();
+        if (remaining <= m_sleepEstimate) {
+            break;
+        }
+
+        std::this_thread::sleep_for(SLEEP_STEP);
+        double slept = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - now).count();
+        updateSleepEstimate(slept);
+    }
+}
+
+void FramePacer::spinUntil(std::chrono::steady_clock::time_point deadline) {
+    while (std::chrono::steady_clock::now() < deadline) {
+        cpuRelax();
+    }
+}
+
+void FramePacer::updateSleepEstimate(double milliseconds) {
+    // 估计值取均值加一个标准差，覆盖绝大多数睡眠过冲
+    m_sleepSamples++;
+    double delta = milliseconds - m_sleepMean;
+    m_sleepMean += delta / static_cast<double>(m_sleepSamples);
+    m_sleepM2 += delta * (milliseconds - m_sleepMean);
+
+    double stddev = m_sleepSamples > 1 ? std::sqrt(m_sleepM2 / static_cast<double>(m_sleepSamples - 1)) : 0.0;
+    m_sleepEstimate = std::min(m_sleepMean + stddev, MAX_SLEEP_ESTIMATE);
+
+    // 定期重新统计，适应系统负载和定时器精度的变化
+    if (m_sleepSamples >= 1000) {
+        m_sleepSamples = 1;
+        m_sleepM2 = 0.0;
+    }
+}
+
+} // namespace Appgame
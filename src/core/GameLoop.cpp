@@ -1,22 +1,79 @@
 #include "core/GameLoop.h"
-#include <thread>
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 namespace Appgame {
 
+namespace {
+
+// 获取当前线程消耗的CPU时间（秒）
+double getThreadCpuTime() {
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    // FILETIME以100纳秒为单位
+    return static_cast<double>(kernel.QuadPart + user.QuadPart) * 1e-7;
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+#endif
+}
+
+} // namespace
+
 GameLoop::GameLoop()
-    : m_timeStepMode(TimeStepMode::FIXED)
+    : m_jobSystem(nullptr)
+    , m_timeStepMode(TimeStepMode::FIXED)
     , m_fixedTimeStep(1.0f / 60.0f) // 默认60fps
     , m_targetFrameTime(1.0f / 60.0f) // 默认60fps
     , m_running(false)
     , m_paused(false)
+    , m_idle(false)
+    , m_wakeRequested(false)
+    , m_redrawRequested(false)
+    , m_idleTimeout(0.25f)
     , m_accumulator(0.0f)
     , m_frameCount(0)
     , m_frameTimeSum(0.0f)
     , m_lastFrameTime(0.0f)
+    , m_windowMaxFrameTime(0.0f)
+    , m_statsElapsed(0.0f)
+    , m_spikeCount(0)
+    , m_frameBudget(0.0f)
+    , m_heapAllocationSum(0)
+    , m_maxHeapAllocations(0)
+    , m_lastHeapAllocations(0)
+    , m_pipelinedRender(false)
+    , m_renderPending(false)
+    , m_renderExit(false)
+    , m_renderParam(0.0f)
+    , m_lastRenderTime(0.0f)
 {
     m_stats.fps = 0.0f;
     m_stats.avgFrameTime = 0.0f;
     m_stats.maxFrameTime = 0.0f;
+    m_headlessStats = HeadlessStats();
+    m_idleStats = IdleStats();
     m_lastTime = std::chrono::steady_clock::now();
 }
 
@@ -29,12 +86,17 @@ void GameLoop::start() {
         m_running = true;
         m_paused = false;
         m_lastTime = std::chrono::steady_clock::now();
+        if (m_pipelinedRender) {
+            startRenderThread();
+        }
         run();
+        stopRenderThread();
     }
 }
 
 void GameLoop::stop() {
     m_running = false;
+    wake();
 }
 
 void GameLoop::pause() {
@@ -43,8 +105,117 @@ void GameLoop::pause() {
 
 void GameLoop::resume() {
     m_paused = false;
-    m_lastTime = std::chrono::steady_clock::now();
-    m_accumulator = 0.0f;
+    wake();
+}
+
+void GameLoop::setIdle(bool idle) {
+    m_idle = idle;
+    if (!idle) {
+        wake();
+    }
+}
+
+bool GameLoop::isIdle() const {
+    return m_idle || m_paused;
+}
+
+void GameLoop::wake() {
+    {
+        // 只在空闲时记录请求，否则遗留的标记会让下一次进入空闲时立即返回
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        if (isIdle()) {
+            m_wakeRequested = true;
+        }
+    }
+    m_idleCondition.notify_all();
+}
+
+void GameLoop::requestRedraw() {
+    {
+        // 非空闲时每帧都在渲染，无需记录
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        if (isIdle()) {
+            m_redrawRequested = true;
+            m_wakeRequested = true;
+        }
+    }
+    m_idleCondition.notify_all();
+}
+
+void GameLoop::setIdleTimeout(float seconds) {
+    std::lock_guard<std::mutex> lock(m_idleMutex);
+    m_idleTimeout = std::max(seconds, 0.0f);
+}
+
+void GameLoop::setIdleCallback(std::function<void()> callback) {
+    m_idleCallback = callback;
+}
+
+void GameLoop::setIdleCondition(std::function<bool()> condition) {
+    m_idlePredicate = condition;
+}
+
+GameLoop::IdleStats GameLoop::getIdleStats() const {
+    IdleStats stats = m_idleStats;
+    stats.cpuUsage = stats.idleSeconds > 0.0 ? static_cast<float>(stats.idleCpuSeconds / stats.idleSeconds) : 0.0f;
+    return stats;
+}
+
+GameLoop::HeadlessStats GameLoop::advance(uint64_t steps) {
+    HeadlessStats stats = HeadlessStats();
+
+    // 回调中调用stop()可提前结束
+    bool wasRunning = m_running;
+    m_running = true;
+
+    double stepTimeSum = 0.0;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point stepStart = begin;
+    while (stats.steps < steps && m_running) {
+        m_frameArena.reset();
+        runUpdate(m_fixedTimeStep);
+        stats.steps++;
+
+        std::chrono::steady_clock::time_point stepEnd = std::chrono::steady_clock::now();
+        float stepTime = std::chrono::duration<float, std::milli>(stepEnd - stepStart).count();
+        stepTimeSum += stepTime;
+        stats.maxStepTime = std::max(stats.maxStepTime, stepTime);
+        stepStart = stepEnd;
+    }
+
+    if (m_running) {
+        m_running = wasRunning;
+    }
+
+    stats.simulatedSeconds = static_cast<double>(stats.steps) * m_fixedTimeStep;
+    stats.wallSeconds = std::chrono::duration<double>(stepStart - begin).count();
+    stats.simSecondsPerWallSecond = stats.wallSeconds > 0.0 ? stats.simulatedSeconds / stats.wallSeconds : 0.0;
+    stats.avgStepTime = stats.steps > 0 ? static_cast<float>(stepTimeSum / static_cast<double>(stats.steps)) : 0.0f;
+
+    // 累计统计
+    double totalStepTime = static_cast<double>(m_headlessStats.avgStepTime) * static_cast<double>(m_headlessStats.steps) + stepTimeSum;
+    m_headlessStats.steps += stats.steps;
+    m_headlessStats.simulatedSeconds += stats.simulatedSeconds;
+    m_headlessStats.wallSeconds += stats.wallSeconds;
+    m_headlessStats.simSecondsPerWallSecond = m_headlessStats.wallSeconds > 0.0 ? m_headlessStats.simulatedSeconds / m_headlessStats.wallSeconds : 0.0;
+    m_headlessStats.avgStepTime = m_headlessStats.steps > 0 ? static_cast<float>(totalStepTime / static_cast<double>(m_headlessStats.steps)) : 0.0f;
+    m_headlessStats.maxStepTime = std::max(m_headlessStats.maxStepTime, stats.maxStepTime);
+
+    return stats;
+}
+
+GameLoop::HeadlessStats GameLoop::runFor(double simSeconds) {
+    if (simSeconds <= 0.0 || m_fixedTimeStep <= 0.0f) {
+        return advance(0);
+    }
+
+    // 容忍千分之一步长的浮点误差，避免多走一步
+    double steps = std::ceil(simSeconds / m_fixedTimeStep - 1e-3);
+    return advance(static_cast<uint64_t>(steps));
+}
+
+const GameLoop::HeadlessStats& GameLoop::getHeadlessStats() const {
+    return m_headlessStats;
 }
 
 void GameLoop::setTimeStepMode(TimeStepMode mode) {
@@ -59,10 +230,103 @@ void GameLoop::setFixedTimeStep(float step) {
     m_fixedTimeStep = step;
 }
 
+void GameLoop::setPacingMode(FramePacer::Mode mode) {
+    m_framePacer.setMode(mode);
+}
+
+FramePacer::Stats GameLoop::getPacingStats() const {
+    return m_framePacer.getStats();
+}
+
+UpdateGovernor& GameLoop::getUpdateGovernor() {
+    return m_updateGovernor;
+}
+
 const GameLoop::Stats& GameLoop::getStats() const {
     return m_stats;
 }
 
+float GameLoop::getLastFrameTime() const {
+    return m_lastFrameTime;
+}
+
+GameLoop::DetailedStats GameLoop::getDetailedStats() const {
+    DetailedStats stats;
+    stats.frameCount = m_frameTimeHistogram.getCount();
+    stats.p50FrameTime = m_frameTimeHistogram.getPercentile(50.0f);
+    stats.p90FrameTime = m_frameTimeHistogram.getPercentile(90.0f);
+    stats.p99FrameTime = m_frameTimeHistogram.getPercentile(99.0f);
+    stats.p999FrameTime = m_frameTimeHistogram.getPercentile(99.9f);
+    stats.minFrameTime = m_frameTimeHistogram.getMin();
+    stats.maxFrameTime = m_frameTimeHistogram.getMax();
+    stats.avgFrameTime = m_frameTimeHistogram.getMean();
+    stats.frameBudget = getFrameBudget();
+    stats.spikeCount = m_spikeCount;
+    stats.update = m_updatePhase.toStats(stats.frameCount);
+    stats.render = m_renderPhase.toStats(stats.frameCount);
+    stats.sleep = m_sleepPhase.toStats(stats.frameCount);
+    stats.pacing = m_framePacer.getStats();
+    stats.memory.heapAllocationsPerFrame = stats.frameCount > 0 ? static_cast<float>(static_cast<double>(m_heapAllocationSum) / static_cast<double>(stats.frameCount)) : 0.0f;
+    stats.memory.maxHeapAllocationsPerFrame = m_maxHeapAllocations;
+    stats.memory.lastHeapAllocations = m_lastHeapAllocations;
+    stats.memory.arenaCapacity = m_frameArena.getCapacity();
+    stats.memory.arenaPeakUsed = m_frameArena.getPeakUsed();
+    stats.memory.arenaOverflowCount = m_frameArena.getOverflowCount();
+    stats.governor = m_updateGovernor.getStats();
+    return stats;
+}
+
+void GameLoop::resetDetailedStats() {
+    m_frameTimeHistogram.reset();
+    m_updatePhase = PhaseAccumulator();
+    m_renderPhase = PhaseAccumulator();
+    m_sleepPhase = PhaseAccumulator();
+    m_spikeCount = 0;
+    m_heapAllocationSum = 0;
+    m_maxHeapAllocations = 0;
+    m_lastHeapAllocations = 0;
+    m_framePacer.resetStats();
+    m_updateGovernor.resetStats();
+}
+
+void GameLoop::setFrameBudget(float milliseconds) {
+    m_frameBudget = milliseconds;
+}
+
+const FrameTimeHistogram& GameLoop::getFrameTimeHistogram() const {
+    return m_frameTimeHistogram;
+}
+
+FrameArena& GameLoop::getFrameArena() {
+    return m_frameArena;
+}
+
+float GameLoop::getFrameBudget() const {
+    return m_frameBudget > 0.0f ? m_frameBudget : m_targetFrameTime * 1000.0f;
+}
+
+void GameLoop::PhaseAccumulator::record(float milliseconds) {
+    sum += milliseconds;
+    if (milliseconds > max) {
+        max = milliseconds;
+    }
+}
+
+GameLoop::PhaseStats GameLoop::PhaseAccumulator::toStats(uint64_t count) const {
+    PhaseStats stats;
+    stats.average = count > 0 ? static_cast<float>(sum / static_cast<double>(count)) : 0.0f;
+    stats.max = max;
+    return stats;
+}
+
+void GameLoop::setPipelinedRender(bool enabled) {
+    m_pipelinedRender = enabled;
+}
+
+void GameLoop::setPublishCallback(std::function<void(float)> callback) {
+    m_publishCallback = callback;
+}
+
 void GameLoop::setUpdateCallback(std::function<void(float)> callback) {
     m_updateCallback = callback;
 }
@@ -71,10 +335,92 @@ void GameLoop::setRenderCallback(std::function<void(float)> callback) {
     m_renderCallback = callback;
 }
 
+int GameLoop::addSystem(const std::string& name, std::function<void(float)> update, const std::vector<int>& dependencies) {
+    int id = static_cast<int>(m_systems.size());
+
+    // 只允许依赖已注册的系统，保证依赖图无环
+    for (int dependency : dependencies) {
+        if (dependency < 0 || dependency >= id) {
+            return -1;
+        }
+    }
+
+    SystemNode node;
+    node.name = name;
+    node.update = update;
+    node.dependencies = dependencies;
+    m_systems.push_back(node);
+    return id;
+}
+
+void GameLoop::clearSystems() {
+    m_systems.clear();
+}
+
+void GameLoop::setJobSystem(JobSystem* jobSystem) {
+    m_jobSystem = jobSystem;
+}
+
+void GameLoop::runUpdate(float deltaTime) {
+    if (m_updateCallback) {
+        m_updateCallback(deltaTime);
+    }
+    runSystems(deltaTime);
+}
+
+void GameLoop::runSystems(float deltaTime) {
+    if (m_systems.empty()) {
+        return;
+    }
+
+    if (!m_jobSystem) {
+        for (auto& system : m_systems) {
+            if (system.update) {
+                system.update(deltaTime);
+            }
+        }
+        return;
+    }
+
+    // 每个系统作为一个任务节点，依赖完成后才会被调度
+    std::vector<JobHandle> handles(m_systems.size());
+    std::vector<JobHandle> dependencies;
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+        SystemNode* system = &m_systems[i];
+        dependencies.clear();
+        for (int dependency : system->dependencies) {
+            dependencies.push_back(handles[dependency]);
+        }
+        handles[i] = m_jobSystem->schedule([system, deltaTime]() {
+            if (system->update) {
+                system->update(deltaTime);
+            }
+        }, dependencies);
+    }
+
+    for (const auto& handle : handles) {
+        m_jobSystem->wait(handle);
+    }
+}
+
 void GameLoop::run() {
     while (m_running) {
+        updateIdleCondition();
+        if (isIdle()) {
+            runIdle();
+            updateIdleCondition();
+
+            // 空闲时间不计入模拟时间，退出空闲后重新开始累计
+            m_lastTime = std::chrono::steady_clock::now();
+            if (!isIdle()) {
+                m_accumulator = 0.0f;
+            }
+            continue;
+        }
+
         m_currentTime = std::chrono::steady_clock::now();
-        float deltaTime = std::chrono::duration<float>(m_currentTime - m_lastTime).count();
+        float frameInterval = std::chrono::duration<float>(m_currentTime - m_lastTime).count();
+        float deltaTime = frameInterval;
         m_lastTime = m_currentTime;
 
         // 限制最大deltaTime，防止大延迟导致的问题
@@ -82,65 +428,215 @@ void GameLoop::run() {
             deltaTime = 0.1f;
         }
 
-        if (!m_paused) {
-            if (m_timeStepMode == TimeStepMode::FIXED) {
-                // 固定时间步长模式
-                m_accumulator += deltaTime;
-                while (m_accumulator >= m_fixedTimeStep) {
-                    if (m_updateCallback) {
-                        m_updateCallback(m_fixedTimeStep);
-                    }
-                    m_accumulator -= m_fixedTimeStep;
-                }
-
-                // 渲染插值
-                float alpha = m_accumulator / m_fixedTimeStep;
-                if (m_renderCallback) {
-                    m_renderCallback(alpha);
-                }
-            } else {
-                // 可变时间步长模式
-                if (m_updateCallback) {
-                    m_updateCallback(deltaTime);
-                }
-                if (m_renderCallback) {
-                    m_renderCallback(deltaTime);
-                }
+        // 上一帧的帧内存全部失效
+        m_frameArena.reset();
+        uint64_t heapAllocationsBefore = getHeapStats().allocations;
+
+        float renderParam;
+        int steps = 0;
+        if (m_timeStepMode == TimeStepMode::FIXED) {
+            // 固定时间步长模式，补偿步数受调节器限制，避免更新越慢积压越多
+            m_accumulator += deltaTime;
+            steps = m_updateGovernor.beginFrame(m_accumulator, m_fixedTimeStep);
+            for (int i = 0; i < steps; ++i) {
+                runUpdate(m_fixedTimeStep);
+                m_accumulator -= m_fixedTimeStep;
             }
 
-            // 更新统计信息
-            updateStats();
+            // 渲染插值
+            renderParam = m_accumulator / m_fixedTimeStep;
+        } else {
+            // 可变时间步长模式
+            runUpdate(deltaTime);
+            renderParam = deltaTime;
+        }
+
+        std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
+        float renderTime;
+        if (m_renderThread.joinable()) {
+            // 流水线模式：在更新线程发布快照，渲染交给渲染线程与下一帧更新并行执行
+            if (m_publishCallback) {
+                m_publishCallback(renderParam);
+            }
+            renderTime = submitPipelinedRender(renderParam);
+        } else {
+            if (m_renderCallback) {
+                m_renderCallback(renderParam);
+            }
+            renderTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+        }
+        std::chrono::steady_clock::time_point renderEnd = std::chrono::steady_clock::now();
+
+        // 更新统计信息
+        float updateTime = std::chrono::duration<float, std::milli>(renderStart - m_currentTime).count();
+        float frameTime = std::chrono::duration<float, std::milli>(renderEnd - m_currentTime).count();
+        updateStats(updateTime, renderTime, frameTime, frameInterval * 1000.0f);
+        if (m_timeStepMode == TimeStepMode::FIXED) {
+            m_updateGovernor.endFrame(steps, m_fixedTimeStep, frameTime);
+        }
+        recordHeapAllocations(getHeapStats().allocations - heapAllocationsBefore);
+
+        // 帧率控制
+        waitForNextFrame();
+    }
+}
+
+void GameLoop::updateIdleCondition() {
+    if (m_idlePredicate) {
+        m_idle = m_idlePredicate();
+    }
+}
+
+void GameLoop::runIdle() {
+    std::chrono::steady_clock::time_point idleStart = std::chrono::steady_clock::now();
+    double cpuStart = getThreadCpuTime();
+
+    bool woken;
+    bool redraw;
+    {
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+        auto shouldWake = [this]() { return m_wakeRequested || !m_running || !isIdle(); };
+        if (m_idleTimeout > 0.0f) {
+            auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(m_idleTimeout));
+            woken = m_idleCondition.wait_until(lock, idleStart + timeout, shouldWake);
+        } else {
+            m_idleCondition.wait(lock, shouldWake);
+            woken = true;
+        }
+        m_wakeRequested = false;
+        redraw = m_redrawRequested;
+        m_redrawRequested = false;
+    }
+
+    m_idleStats.wakeups++;
+    if (woken) {
+        m_idleStats.explicitWakeups++;
+    } else {
+        m_idleStats.timerWakeups++;
+    }
+
+    // 处理平台消息，回调中可调用resume()/setIdle(false)/stop()
+    if (m_idleCallback && m_running) {
+        m_idleCallback();
+    }
 
-            // 帧率控制
-            float frameTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_currentTime).count();
-            float sleepTime = m_targetFrameTime - frameTime;
-            if (sleepTime > 0.0f) {
-                std::this_thread::sleep_for(std::chrono::duration<float>(sleepTime));
+    if (redraw && m_running) {
+        m_idleStats.redraws++;
+        if (m_renderThread.joinable()) {
+            if (m_publishCallback) {
+                m_publishCallback(0.0f);
             }
+            submitPipelinedRender(0.0f);
+        } else if (m_renderCallback) {
+            m_renderCallback(0.0f);
         }
     }
+
+    m_idleStats.idleSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - idleStart).count();
+    m_idleStats.idleCpuSeconds += getThreadCpuTime() - cpuStart;
+}
+
+void GameLoop::startRenderThread() {
+    if (m_renderThread.joinable()) {
+        return;
+    }
+
+    m_renderPending = false;
+    m_renderExit = false;
+    m_lastRenderTime = 0.0f;
+    m_renderThread = std::thread(&GameLoop::renderThreadMain, this);
 }
 
-void GameLoop::updateStats() {
+void GameLoop::stopRenderThread() {
+    if (!m_renderThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_renderMutex);
+        m_renderExit = true;
+    }
+    m_renderCondition.notify_all();
+    m_renderThread.join();
+}
+
+void GameLoop::renderThreadMain() {
+    std::unique_lock<std::mutex> lock(m_renderMutex);
+    while (true) {
+        m_renderCondition.wait(lock, [this]() { return m_renderPending || m_renderExit; });
+        if (!m_renderPending) {
+            break;
+        }
+
+        float renderParam = m_renderParam;
+        lock.unlock();
+
+        std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
+        if (m_renderCallback) {
+            m_renderCallback(renderParam);
+        }
+        float renderTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+
+        lock.lock();
+        m_lastRenderTime = renderTime;
+        m_renderPending = false;
+        m_renderCondition.notify_all();
+    }
+}
+
+float GameLoop::submitPipelinedRender(float renderParam) {
+    std::unique_lock<std::mutex> lock(m_renderMutex);
+
+    // 渲染线程最多落后一帧：等待上一帧渲染完成后再提交本帧
+    m_renderCondition.wait(lock, [this]() { return !m_renderPending; });
+    float previousRenderTime = m_lastRenderTime;
+
+    m_renderParam = renderParam;
+    m_renderPending = true;
+    m_renderCondition.notify_all();
+    return previousRenderTime;
+}
+
+void GameLoop::waitForNextFrame() {
+    std::chrono::steady_clock::time_point sleepStart = std::chrono::steady_clock::now();
+    auto frameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(m_targetFrameTime));
+    m_framePacer.waitUntil(m_currentTime + frameDuration);
+    m_sleepPhase.record(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - sleepStart).count());
+}
+
+void GameLoop::recordHeapAllocations(uint64_t allocations) {
+    m_heapAllocationSum += allocations;
+    m_lastHeapAllocations = allocations;
+    m_maxHeapAllocations = std::max(m_maxHeapAllocations, allocations);
+}
+
+void GameLoop::updateStats(float updateTime, float renderTime, float frameTime, float frameInterval) {
     m_frameCount++;
-    float frameTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_currentTime).count() * 1000.0f; // 转换为毫秒
     m_frameTimeSum += frameTime;
     m_lastFrameTime = frameTime;
 
-    if (frameTime > m_stats.maxFrameTime) {
-        m_stats.maxFrameTime = frameTime;
+    if (frameTime > m_windowMaxFrameTime) {
+        m_windowMaxFrameTime = frameTime;
+    }
+
+    // 详细统计：直方图、卡顿计数和阶段耗时
+    m_frameTimeHistogram.record(frameTime);
+    m_updatePhase.record(updateTime);
+    m_renderPhase.record(renderTime);
+    if (frameTime > getFrameBudget()) {
+        m_spikeCount++;
     }
 
-    // 每秒更新一次统计信息
-    static float lastSecond = 0.0f;
-    lastSecond += frameTime / 1000.0f;
-    if (lastSecond >= 1.0f) {
-        m_stats.fps = m_frameCount / lastSecond;
+    // 每秒（按实际经过时间）更新一次统计信息
+    m_statsElapsed += frameInterval / 1000.0f;
+    if (m_statsElapsed >= 1.0f) {
+        m_stats.fps = m_frameCount / m_statsElapsed;
         m_stats.avgFrameTime = m_frameTimeSum / m_frameCount;
+        m_stats.maxFrameTime = m_windowMaxFrameTime;
         m_frameCount = 0;
         m_frameTimeSum = 0.0f;
-        m_stats.maxFrameTime = 0.0f;
-        lastSecond = 0.0f;
+        m_windowMaxFrameTime = 0.0f;
+        m_statsElapsed = 0.0f;
     }
 }
 
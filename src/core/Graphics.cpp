@@ -1,10 +1,220 @@
 #include "core/Graphics.h"
+#include "core/SoftwareGraphics.h"
+#include "core/QuadKernel.h"
+#include "core/RenderCommand.h"
+#include "core/StreamBuffer.h"
+#include "core/TextureAtlas.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 
 namespace Appgame {
 
+namespace {
+
+// 默认每次刷新容纳的四边形数量
+const size_t DEFAULT_BATCH_CAPACITY = 2048;
+
+// 批量提交时每次变换的四边形数量（顶点位置暂存在栈上）
+const size_t TRANSFORM_CHUNK = 64;
+
+// 排序键布局：图层(16位) | 着色器槽位(16位) | 纹理槽位(32位)
+const int LAYER_SHIFT = 48;
+const int SHADER_SHIFT = 32;
+const uint64_t SHADER_MASK = 0xFFFFull << SHADER_SHIFT;
+const uint64_t LAYER_MASK = 0xFFFFull << LAYER_SHIFT;
+
+// 折线中距离小于此值的相邻点视为重合
+const float POLYLINE_EPSILON = 1e-4f;
+
+// 在槽位表中查找或追加，槽位号按本帧首次使用的顺序分配，保证排序结果确定
+template <typename T>
+uint64_t findSlot(std::vector<T*>& slots, T* value) {
+    for (size_t i = slots.size(); i > 0; --i) {
+        if (slots[i - 1] == value) {
+            return i - 1;
+        }
+    }
+    slots.push_back(value);
+    return slots.size() - 1;
+}
+
+float clampUnit(float value) {
+    return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+}
+
+const float* readFloats(const uint8_t* vertex, const VertexElement& element) {
+    return reinterpret_cast<const float*>(vertex + element.offset);
+}
+
+} // namespace
+
+uint32_t PackedVertex::packColor(const Color& color) {
+    uint32_t r = static_cast<uint32_t>(clampUnit(color.r) * 255.0f + 0.5f);
+    uint32_t g = static_cast<uint32_t>(clampUnit(color.g) * 255.0f + 0.5f);
+    uint32_t b = static_cast<uint32_t>(clampUnit(color.b) * 255.0f + 0.5f);
+    uint32_t a = static_cast<uint32_t>(clampUnit(color.a) * 255.0f + 0.5f);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+uint16_t PackedVertex::packUnorm16(float value) {
+    return static_cast<uint16_t>(clampUnit(value) * 65535.0f + 0.5f);
+}
+
+VertexFormat::VertexFormat(uint32_t stride)
+    : stride(stride)
+    , elementCount(0)
+{
+}
+
+VertexFormat& VertexFormat::add(VertexAttribute attribute, VertexElementType type, uint32_t offset) {
+    if (elementCount < MAX_ELEMENTS) {
+        elements[elementCount].attribute = attribute;
+        elements[elementCount].type = type;
+        elements[elementCount].offset = offset;
+        elementCount++;
+    }
+    return *this;
+}
+
+const VertexElement* VertexFormat::find(VertexAttribute attribute) const {
+    for (int i = 0; i < elementCount; ++i) {
+        if (elements[i].attribute == attribute) {
+            return &elements[i];
+        }
+    }
+    return nullptr;
+}
+
+Vertex VertexFormat::decode(const void* vertices, size_t index) const {
+    const uint8_t* vertex = static_cast<const uint8_t*>(vertices) + index * stride;
+    Vertex result(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, Color(1.0f, 1.0f, 1.0f, 1.0f));
+
+    for (int i = 0; i < elementCount; ++i) {
+        const VertexElement& element = elements[i];
+        float values[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        switch (element.type) {
+            case VertexElementType::FLOAT2:
+                values[0] = readFloats(vertex, element)[0];
+                values[1] = readFloats(vertex, element)[1];
+                break;
+            case VertexElementType::FLOAT3:
+                for (int c = 0; c < 3; ++c) {
+                    values[c] = readFloats(vertex, element)[c];
+                }
+                break;
+            case VertexElementType::FLOAT4:
+                for (int c = 0; c < 4; ++c) {
+                    values[c] = readFloats(vertex, element)[c];
+                }
+                break;
+            case VertexElementType::UNORM16X2: {
+                const uint16_t* packed = reinterpret_cast<const uint16_t*>(vertex + element.offset);
+                values[0] = packed[0] / 65535.0f;
+                values[1] = packed[1] / 65535.0f;
+                break;
+            }
+            case VertexElementType::UNORM8X4:
+                for (int c = 0; c < 4; ++c) {
+                    values[c] = vertex[element.offset + c] / 255.0f;
+                }
+                break;
+        }
+
+        switch (element.attribute) {
+            case VertexAttribute::POSITION:
+                result.x = values[0];
+                result.y = values[1];
+                result.z = element.type == VertexElementType::FLOAT2 ? 0.0f : values[2];
+                break;
+            case VertexAttribute::TEXCOORD:
+                result.u = values[0];
+                result.v = values[1];
+                break;
+            case VertexAttribute::COLOR:
+                result.color = Color(values[0], values[1], values[2], values[3]);
+                break;
+        }
+    }
+    return result;
+}
+
+bool VertexFormat::operator==(const VertexFormat& other) const {
+    if (stride != other.stride || elementCount != other.elementCount) {
+        return false;
+    }
+    for (int i = 0; i < elementCount; ++i) {
+        if (elements[i].attribute != other.elements[i].attribute ||
+            elements[i].type != other.elements[i].type ||
+            elements[i].offset != other.elements[i].offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VertexFormat::operator!=(const VertexFormat& other) const {
+    return !(*this == other);
+}
+
+const VertexFormat& VertexFormat::standard() {
+    static const VertexFormat format = VertexFormat(sizeof(Vertex))
+        .add(VertexAttribute::POSITION, VertexElementType::FLOAT3, offsetof(Vertex, x))
+        .add(VertexAttribute::TEXCOORD, VertexElementType::FLOAT2, offsetof(Vertex, u))
+        .add(VertexAttribute::COLOR, VertexElementType::FLOAT4, offsetof(Vertex, color));
+    return format;
+}
+
+const VertexFormat& VertexFormat::compact() {
+    static const VertexFormat format = VertexFormat(sizeof(PackedVertex))
+        .add(VertexAttribute::POSITION, VertexElementType::FLOAT2, offsetof(PackedVertex, x))
+        .add(VertexAttribute::TEXCOORD, VertexElementType::UNORM16X2, offsetof(PackedVertex, u))
+        .add(VertexAttribute::COLOR, VertexElementType::UNORM8X4, offsetof(PackedVertex, color));
+    return format;
+}
+
+const char* const FRAME_UNIFORMS_BLOCK = "FrameUniforms";
+
+namespace {
+
+// 解析uniform块时使用，避免每次构造字符串
+const std::string FRAME_UNIFORMS_BLOCK_NAME(FRAME_UNIFORMS_BLOCK);
+
+} // namespace
+
+FrameUniforms::FrameUniforms()
+    : time(0.0f)
+{
+    // 默认为单位矩阵和白色（不改变颜色）
+    for (int i = 0; i < 16; ++i) {
+        projection[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+    for (int i = 0; i < 4; ++i) {
+        tint[i] = 1.0f;
+    }
+    for (int i = 0; i < 3; ++i) {
+        padding[i] = 0.0f;
+    }
+}
+
 Renderer::Renderer(std::unique_ptr<GraphicsDevice> device)
     : m_device(std::move(device))
+    , m_compactVertices(false)
+    , m_instancingEnabled(true)
+    , m_batchCapacity(DEFAULT_BATCH_CAPACITY)
+    , m_layer(0)
+    , m_shader(nullptr)
+    , m_hasFrameUniforms(false)
+    , m_presorted(false)
+    , m_cullingEnabled(false)
+    , m_scissorEnabled(false)
+    , m_targetTexture(nullptr)
 {
+    m_renderStats = RenderStats();
+    m_vertices.reserve(m_batchCapacity * 4);
+    m_indices.reserve(m_batchCapacity * 6);
+    m_quads.reserve(m_batchCapacity);
 }
 
 Renderer::~Renderer() {
@@ -14,6 +224,7 @@ bool Renderer::init() {
     if (!m_device->init()) {
         return false;
     }
+    m_capabilities = m_device->getCapabilities();
 
     setupDefaultShader();
     return true;
@@ -21,95 +232,277 @@ bool Renderer::init() {
 
 void Renderer::beginRender() {
     m_vertices.clear();
+    m_packedVertices.clear();
     m_indices.clear();
+    m_quads.clear();
+    m_instances.clear();
+    m_textureSlots.clear();
+    m_shaderSlots.clear();
+    m_shaderBlocks.clear();
+    m_frameUniformShaders.clear();
+    m_renderStats = RenderStats();
 }
 
 void Renderer::endRender() {
     flush();
+    if (m_streamBuffer) {
+        m_streamBuffer->endFrame();
+    }
     m_device->swapBuffers();
 }
 
+void Renderer::setLayer(int layer) {
+    m_layer = layer;
+}
+
+int Renderer::getLayer() const {
+    return m_layer;
+}
+
+void Renderer::setShader(Shader* shader) {
+    m_shader = shader;
+}
+
+void Renderer::setStreamBuffer(size_t capacity, unsigned int framesInFlight) {
+    flush();
+    if (capacity > 0) {
+        m_streamBuffer.reset(new StreamBuffer(m_device.get(), capacity, framesInFlight));
+    } else {
+        m_streamBuffer.reset();
+    }
+}
+
+const StreamBuffer* Renderer::getStreamBuffer() const {
+    return m_streamBuffer.get();
+}
+
+void Renderer::setFrameUniforms(const FrameUniforms& uniforms) {
+    // 已绑定的着色器持有旧数据，下次绑定时重新上传
+    flush();
+    m_frameUniforms = uniforms;
+    m_hasFrameUniforms = true;
+    m_frameUniformShaders.clear();
+}
+
+void Renderer::setBatchCapacity(size_t quads) {
+    flush();
+    m_batchCapacity = quads > 0 ? quads : 1;
+    if (m_compactVertices) {
+        m_packedVertices.reserve(m_batchCapacity * 4);
+    } else {
+        m_vertices.reserve(m_batchCapacity * 4);
+    }
+    m_indices.reserve(m_batchCapacity * 6);
+    m_quads.reserve(m_batchCapacity);
+}
+
+const RenderStats& Renderer::getRenderStats() const {
+    return m_renderStats;
+}
+
+bool Renderer::setVertexFormat(const VertexFormat& format) {
+    bool compact = format == VertexFormat::compact();
+    if (!compact && format != VertexFormat::standard()) {
+        return false;
+    }
+
+    if (compact != m_compactVertices) {
+        flush();
+        m_compactVertices = compact;
+        if (m_compactVertices) {
+            m_packedVertices.reserve(m_batchCapacity * 4);
+        } else {
+            m_vertices.reserve(m_batchCapacity * 4);
+        }
+    }
+    return true;
+}
+
+const VertexFormat& Renderer::getVertexFormat() const {
+    return m_compactVertices ? VertexFormat::compact() : VertexFormat::standard();
+}
+
 void Renderer::drawSprite(const Texture& texture, const Rect& srcRect, const Rect& dstRect, float rotation, const Color& color) {
-    // 计算顶点
-    float centerX = dstRect.x + dstRect.width * 0.5f;
-    float centerY = dstRect.y + dstRect.height * 0.5f;
-
-    // 生成四个顶点
-    std::vector<Vertex> vertices;
-    vertices.reserve(4);
-
-    // 左上角
-    float x1 = dstRect.x - centerX;
-    float y1 = dstRect.y - centerY;
-    vertices.emplace_back(x1, y1, 0.0f, srcRect.x, srcRect.y, color);
-
-    // 右上角
-    float x2 = dstRect.x + dstRect.width - centerX;
-    float y2 = dstRect.y - centerY;
-    vertices.emplace_back(x2, y2, 0.0f, srcRect.x + srcRect.width, srcRect.y, color);
-
-    // 左下角
-    float x3 = dstRect.x - centerX;
-    float y3 = dstRect.y + dstRect.height - centerY;
-    vertices.emplace_back(x3, y3, 0.0f, srcRect.x, srcRect.y + srcRect.height, color);
-
-    // 右下角
-    float x4 = dstRect.x + dstRect.width - centerX;
-    float y4 = dstRect.y + dstRect.height - centerY;
-    vertices.emplace_back(x4, y4, 0.0f, srcRect.x + srcRect.width, srcRect.y + srcRect.height, color);
-
-    // 应用旋转
-    if (rotation != 0.0f) {
-        float cosTheta = cosf(rotation);
-        float sinTheta = sinf(rotation);
-
-        for (auto& vertex : vertices) {
-            float x = vertex.x;
-            float y = vertex.y;
-            vertex.x = x * cosTheta - y * sinTheta + centerX;
-            vertex.y = x * sinTheta + y * cosTheta + centerY;
+    // 与drawSprites使用同一变换，结果一致
+    SpriteInstance instance;
+    instance.x = dstRect.x + dstRect.width * 0.5f;
+    instance.y = dstRect.y + dstRect.height * 0.5f;
+    instance.width = dstRect.width;
+    instance.height = dstRect.height;
+    instance.rotation = rotation;
+
+    float positions[8];
+    transformSpritesScalar(&instance, 1, positions);
+    if (m_cullingEnabled && cullQuad(positions)) {
+        return;
+    }
+    writeQuad(allocateQuad(&texture), positions, srcRect.x, srcRect.y, srcRect.x + srcRect.width, srcRect.y + srcRect.height, color);
+}
+
+void Renderer::drawSprite(const AtlasRegion& region, const Rect& srcRect, const Rect& dstRect, float rotation, const Color& color) {
+    drawSprite(*region.texture, region.mapUV(srcRect), dstRect, rotation, color);
+}
+
+void Renderer::drawSprites(const Texture& texture, const SpriteInstance* instances, size_t count) {
+    if (isInstancingActive()) {
+        // 只写入每实例数据，连续的实例作为一项参与排序，超出容量时分段
+        size_t entryIndex = m_quads.size();
+        bool entryOpen = false;
+        for (size_t i = 0; i < count; ++i) {
+            const SpriteInstance& instance = instances[i];
+            if (m_cullingEnabled && cullSprite(instance)) {
+                continue;
+            }
+            if (getPendingQuadCount() >= m_batchCapacity) {
+                flush();
+                m_renderStats.breaks[static_cast<int>(BatchBreak::CAPACITY)]++;
+                entryOpen = false;
+            }
+            if (!entryOpen) {
+                QuadEntry entry;
+                entry.key = makeSortKey(&texture);
+                entry.order = static_cast<unsigned int>(m_quads.size());
+                entry.first = static_cast<unsigned int>(m_instances.size());
+                entry.instanceCount = 0;
+                entryIndex = m_quads.size();
+                m_quads.push_back(entry);
+                entryOpen = true;
+            }
+
+            PackedSpriteInstance packed;
+            packed.x = instance.x;
+            packed.y = instance.y;
+            packed.rotation = instance.rotation;
+            packed.scaleX = instance.width;
+            packed.scaleY = instance.height;
+            packed.u0 = PackedVertex::packUnorm16(instance.u0);
+            packed.v0 = PackedVertex::packUnorm16(instance.v0);
+            packed.u1 = PackedVertex::packUnorm16(instance.u1);
+            packed.v1 = PackedVertex::packUnorm16(instance.v1);
+            packed.color = PackedVertex::packColor(instance.color);
+            m_instances.push_back(packed);
+            m_quads[entryIndex].instanceCount++;
+            m_renderStats.quads++;
+            m_renderStats.instances++;
         }
-    } else {
-        // 不旋转时直接偏移
-        for (auto& vertex : vertices) {
-            vertex.x += centerX;
-            vertex.y += centerY;
+        return;
+    }
+
+    float positions[TRANSFORM_CHUNK * 8];
+    for (size_t start = 0; start < count; start += TRANSFORM_CHUNK) {
+        size_t chunk = std::min(TRANSFORM_CHUNK, count - start);
+        transformSprites(instances + start, chunk, positions);
+        for (size_t i = 0; i < chunk; ++i) {
+            const SpriteInstance& instance = instances[start + i];
+            if (m_cullingEnabled && cullQuad(&positions[i * 8])) {
+                continue;
+            }
+            writeQuad(allocateQuad(&texture), &positions[i * 8], instance.u0, instance.v0, instance.u1, instance.v1, instance.color);
         }
     }
+}
 
-    // 添加到顶点缓冲区
-    unsigned int baseIndex = m_vertices.size();
-    m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+void Renderer::setCullRect(const Rect& rect) {
+    m_cullRect = rect;
+    m_cullingEnabled = true;
+}
 
-    // 添加索引
-    m_indices.push_back(baseIndex);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 3);
+void Renderer::clearCullRect() {
+    m_cullingEnabled = false;
+}
 
-    // 检查是否需要刷新
-    if (m_vertices.size() > 1000 || m_indices.size() > 3000) {
-        flush();
+bool Renderer::isCullingEnabled() const {
+    return m_cullingEnabled;
+}
+
+const Rect& Renderer::getCullRect() const {
+    return m_cullRect;
+}
+
+bool Renderer::setScissorRect(const Rect& rect) {
+    if (!m_capabilities.scissor) {
+        return false;
+    }
+
+    int x0 = static_cast<int>(std::floor(rect.x));
+    int y0 = static_cast<int>(std::floor(rect.y));
+    int x1 = static_cast<int>(std::ceil(rect.x + rect.width));
+    int y1 = static_cast<int>(std::ceil(rect.y + rect.height));
+    Rect snapped(static_cast<float>(x0), static_cast<float>(y0), static_cast<float>(x1 - x0), static_cast<float>(y1 - y0));
+    if (m_scissorEnabled && snapped.x == m_scissorRect.x && snapped.y == m_scissorRect.y &&
+        snapped.width == m_scissorRect.width && snapped.height == m_scissorRect.height) {
+        return true;
+    }
+
+    // 已提交的绘制使用之前的裁剪矩形
+    flush();
+    m_device->setScissor(true, x0, y0, x1 - x0, y1 - y0);
+    m_scissorRect = snapped;
+    m_scissorEnabled = true;
+    return true;
+}
+
+void Renderer::clearScissorRect() {
+    if (!m_scissorEnabled) {
+        return;
+    }
+    flush();
+    m_device->setScissor(false, 0, 0, 0, 0);
+    m_scissorEnabled = false;
+}
+
+bool Renderer::isScissorEnabled() const {
+    return m_scissorEnabled;
+}
+
+const Rect& Renderer::getScissorRect() const {
+    return m_scissorRect;
+}
+
+bool Renderer::cullQuad(const float* positions) {
+    float minX = std::min(std::min(positions[0], positions[2]), std::min(positions[4], positions[6]));
+    float maxX = std::max(std::max(positions[0], positions[2]), std::max(positions[4], positions[6]));
+    float minY = std::min(std::min(positions[1], positions[3]), std::min(positions[5], positions[7]));
+    float maxY = std::max(std::max(positions[1], positions[3]), std::max(positions[5], positions[7]));
+    if (maxX < m_cullRect.x || minX > m_cullRect.x + m_cullRect.width ||
+        maxY < m_cullRect.y || minY > m_cullRect.y + m_cullRect.height) {
+        m_renderStats.culled++;
+        return true;
+    }
+    return false;
+}
+
+bool Renderer::cullSprite(const SpriteInstance& instance) {
+    // 任意旋转下四边形都在半径为(宽+高)/2的正方形内
+    float radius = (std::fabs(instance.width) + std::fabs(instance.height)) * 0.5f;
+    if (instance.x + radius < m_cullRect.x || instance.x - radius > m_cullRect.x + m_cullRect.width ||
+        instance.y + radius < m_cullRect.y || instance.y - radius > m_cullRect.y + m_cullRect.height) {
+        m_renderStats.culled++;
+        return true;
     }
+    return false;
+}
+
+void Renderer::setInstancingEnabled(bool enabled) {
+    m_instancingEnabled = enabled;
+}
+
+bool Renderer::isInstancingActive() const {
+    return m_instancingEnabled && m_capabilities.instancing;
 }
 
 void Renderer::drawRect(const Rect& rect, const Color& color) {
     // 添加四个顶点
-    unsigned int baseIndex = m_vertices.size();
-    m_vertices.emplace_back(rect.x, rect.y, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(rect.x + rect.width, rect.y, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(rect.x, rect.y + rect.height, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(rect.x + rect.width, rect.y + rect.height, 0.0f, 0.0f, 0.0f, color);
-
-    // 添加索引
-    m_indices.push_back(baseIndex);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 3);
+    float positions[8] = {
+        rect.x, rect.y,
+        rect.x + rect.width, rect.y,
+        rect.x, rect.y + rect.height,
+        rect.x + rect.width, rect.y + rect.height
+    };
+    if (m_cullingEnabled && cullQuad(positions)) {
+        return;
+    }
+    writeQuad(allocateQuad(nullptr), positions, 0.0f, 0.0f, 0.0f, 0.0f, color);
 }
 
 void Renderer::drawLine(float x1, float y1, float x2, float y2, float width, const Color& color) {
@@ -117,53 +510,440 @@ void Renderer::drawLine(float x1, float y1, float x2, float y2, float width, con
     float dx = x2 - x1;
     float dy = y2 - y1;
     float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
 
     // 计算垂直方向向量
     float nx = -dy / length * width * 0.5f;
     float ny = dx / length * width * 0.5f;
 
     // 添加四个顶点
-    unsigned int baseIndex = m_vertices.size();
-    m_vertices.emplace_back(x1 + nx, y1 + ny, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(x2 + nx, y2 + ny, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(x1 - nx, y1 - ny, 0.0f, 0.0f, 0.0f, color);
-    m_vertices.emplace_back(x2 - nx, y2 - ny, 0.0f, 0.0f, 0.0f, color);
+    float positions[8] = {
+        x1 + nx, y1 + ny,
+        x2 + nx, y2 + ny,
+        x1 - nx, y1 - ny,
+        x2 - nx, y2 - ny
+    };
+    if (m_cullingEnabled && cullQuad(positions)) {
+        return;
+    }
+    writeQuad(allocateQuad(nullptr), positions, 0.0f, 0.0f, 0.0f, 0.0f, color);
+}
+
+void Renderer::drawPolyline(const float* points, size_t count, const PolylineStyle& style) {
+    // 去掉重合的相邻点，按(x, y, 到起点的距离)记录节点
+    std::vector<float>& nodes = m_polylineScratch;
+    nodes.clear();
+    for (size_t i = 0; i < count; ++i) {
+        float x = points[i * 2];
+        float y = points[i * 2 + 1];
+        if (!nodes.empty()) {
+            size_t last = nodes.size() - 3;
+            float dx = x - nodes[last];
+            float dy = y - nodes[last + 1];
+            float length = sqrtf(dx * dx + dy * dy);
+            if (length < POLYLINE_EPSILON) {
+                continue;
+            }
+            nodes.push_back(x);
+            nodes.push_back(y);
+            nodes.push_back(nodes[last + 2] + length);
+        } else {
+            nodes.push_back(x);
+            nodes.push_back(y);
+            nodes.push_back(0.0f);
+        }
+    }
+    size_t nodeCount = nodes.size() / 3;
+    if (nodeCount < 2) {
+        return;
+    }
+
+    float startHalf = style.width * 0.5f;
+    float endHalf = (style.endWidth < 0.0f ? style.width : style.endWidth) * 0.5f;
+    float totalLength = nodes[(nodeCount - 1) * 3 + 2];
+
+    // 第i段的单位方向和长度
+    auto segment = [&nodes](size_t i, float& dx, float& dy) {
+        dx = nodes[(i + 1) * 3] - nodes[i * 3];
+        dy = nodes[(i + 1) * 3 + 1] - nodes[i * 3 + 1];
+        float length = nodes[(i + 1) * 3 + 2] - nodes[i * 3 + 2];
+        dx /= length;
+        dy /= length;
+        return length;
+    };
+
+    // 起点为平头
+    float dx0, dy0;
+    float length0 = segment(0, dx0, dy0);
+    float startPlus[2] = {nodes[0] - dy0 * startHalf, nodes[1] + dx0 * startHalf};
+    float startMinus[2] = {nodes[0] + dy0 * startHalf, nodes[1] - dx0 * startHalf};
 
-    // 添加索引
-    m_indices.push_back(baseIndex);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 2);
-    m_indices.push_back(baseIndex + 1);
-    m_indices.push_back(baseIndex + 3);
+    for (size_t i = 0; i + 1 < nodeCount; ++i) {
+        float px = nodes[(i + 1) * 3];
+        float py = nodes[(i + 1) * 3 + 1];
+        float half = startHalf + (endHalf - startHalf) * nodes[(i + 1) * 3 + 2] / totalLength;
+        float n0x = -dy0 * half;
+        float n0y = dx0 * half;
+
+        // 本段终点和下一段起点在连接点两侧的位置，默认与终点平头一致
+        float endPlus[2] = {px + n0x, py + n0y};
+        float endMinus[2] = {px - n0x, py - n0y};
+        float nextPlus[2] = {endPlus[0], endPlus[1]};
+        float nextMinus[2] = {endMinus[0], endMinus[1]};
+        float bevel[6] = {};
+        bool hasBevel = false;
+
+        float dx1 = 0.0f, dy1 = 0.0f, length1 = 0.0f;
+        if (i + 2 < nodeCount) {
+            length1 = segment(i + 1, dx1, dy1);
+            float n1x = -dy1 * half;
+            float n1y = dx1 * half;
+
+            // 尖角方向为两段法线的角平分线，长度为半宽除以半角余弦
+            float mx = -dy0 - dy1;
+            float my = dx0 + dx1;
+            float mLength = sqrtf(mx * mx + my * my);
+            float cosHalf = mLength * 0.5f;
+            float miterScale = cosHalf > POLYLINE_EPSILON ? 1.0f / cosHalf : 0.0f;
+            if (miterScale > 0.0f) {
+                mx *= half * miterScale / mLength;
+                my *= half * miterScale / mLength;
+            }
+
+            if (style.join == LineJoin::MITER && miterScale > 0.0f && miterScale <= style.miterLimit) {
+                endPlus[0] = nextPlus[0] = px + mx;
+                endPlus[1] = nextPlus[1] = py + my;
+                endMinus[0] = nextMinus[0] = px - mx;
+                endMinus[1] = nextMinus[1] = py - my;
+            } else {
+                // 斜角：外侧各用本段法线，用一个三角形填补缺口；内侧交点不超出相邻线段时两段共享
+                float side = dx0 * dy1 - dy0 * dx1 > 0.0f ? -1.0f : 1.0f;
+                float outerEnd[2] = {px + side * n0x, py + side * n0y};
+                float outerNext[2] = {px + side * n1x, py + side * n1y};
+                float inner[2] = {px, py};
+                float* innerEnd = side > 0.0f ? endMinus : endPlus;
+                float* innerNext = side > 0.0f ? nextMinus : nextPlus;
+                if (miterScale > 0.0f && half * miterScale <= std::min(length0, length1)) {
+                    inner[0] = innerEnd[0] = innerNext[0] = px - side * mx;
+                    inner[1] = innerEnd[1] = innerNext[1] = py - side * my;
+                } else {
+                    innerNext[0] = px - side * n1x;
+                    innerNext[1] = py - side * n1y;
+                }
+                float* outerEndTarget = side > 0.0f ? endPlus : endMinus;
+                float* outerNextTarget = side > 0.0f ? nextPlus : nextMinus;
+                outerEndTarget[0] = outerEnd[0];
+                outerEndTarget[1] = outerEnd[1];
+                outerNextTarget[0] = outerNext[0];
+                outerNextTarget[1] = outerNext[1];
+
+                bevel[0] = inner[0];
+                bevel[1] = inner[1];
+                bevel[2] = outerEnd[0];
+                bevel[3] = outerEnd[1];
+                bevel[4] = outerNext[0];
+                bevel[5] = outerNext[1];
+                hasBevel = true;
+            }
+        }
+
+        float positions[8] = {
+            startPlus[0], startPlus[1],
+            endPlus[0], endPlus[1],
+            startMinus[0], startMinus[1],
+            endMinus[0], endMinus[1]
+        };
+        if (!m_cullingEnabled || !cullQuad(positions)) {
+            writeQuad(allocateQuad(nullptr), positions, 0.0f, 0.0f, 0.0f, 0.0f, style.color);
+        }
+        if (hasBevel) {
+            // 三角形以最后两个顶点重合的四边形提交
+            float triangle[8] = {bevel[0], bevel[1], bevel[2], bevel[3], bevel[4], bevel[5], bevel[4], bevel[5]};
+            if (!m_cullingEnabled || !cullQuad(triangle)) {
+                writeQuad(allocateQuad(nullptr), triangle, 0.0f, 0.0f, 0.0f, 0.0f, style.color);
+            }
+        }
+
+        startPlus[0] = nextPlus[0];
+        startPlus[1] = nextPlus[1];
+        startMinus[0] = nextMinus[0];
+        startMinus[1] = nextMinus[1];
+        dx0 = dx1;
+        dy0 = dy1;
+        length0 = length1;
+    }
 }
 
-void Renderer::setTargetTexture(Texture* texture) {
-    // 这里需要实现渲染目标的设置
+void Renderer::drawLines(const LineInstance* lines, size_t count) {
+    float positions[TRANSFORM_CHUNK * 8];
+    for (size_t start = 0; start < count; start += TRANSFORM_CHUNK) {
+        size_t chunk = std::min(TRANSFORM_CHUNK, count - start);
+        transformLines(lines + start, chunk, positions);
+        for (size_t i = 0; i < chunk; ++i) {
+            if (m_cullingEnabled && cullQuad(&positions[i * 8])) {
+                continue;
+            }
+            writeQuad(allocateQuad(nullptr), &positions[i * 8], 0.0f, 0.0f, 0.0f, 0.0f, lines[start + i].color);
+        }
+    }
+}
+
+void Renderer::drawCommands(const RenderCommand* const* commands, size_t count) {
+    flush();
+
+    // 命令已按排序键排好，逐个写入并保持顺序，相邻的相同状态仍合并为一个批次
+    int layer = m_layer;
+    Shader* shader = m_shader;
+    m_presorted = true;
+    for (size_t i = 0; i < count; ++i) {
+        const RenderCommand& command = *commands[i];
+        m_layer = static_cast<int>(command.key >> LAYER_SHIFT) - 32768;
+        m_shader = command.shader;
+        if (m_cullingEnabled && cullQuad(command.positions)) {
+            continue;
+        }
+        writeQuad(allocateQuad(command.texture), command.positions, command.u0, command.v0, command.u1, command.v1, command.color);
+    }
+    flush();
+    m_presorted = false;
+    m_layer = layer;
+    m_shader = shader;
+}
+
+bool Renderer::setTargetTexture(Texture* texture) {
+    if (texture == m_targetTexture) {
+        return true;
+    }
+
+    // 已提交的绘制属于当前目标
+    flush();
+    if (!m_device->setRenderTarget(texture)) {
+        return false;
+    }
+    m_targetTexture = texture;
+    return true;
+}
+
+Texture* Renderer::getTargetTexture() const {
+    return m_targetTexture;
 }
 
 GraphicsDevice* Renderer::getDevice() {
     return m_device.get();
 }
 
+unsigned int Renderer::allocateQuad(const Texture* texture) {
+    // 缓冲区已满时刷新，这是排序键不变时唯一的提前刷新原因
+    if (getPendingQuadCount() >= m_batchCapacity) {
+        flush();
+        m_renderStats.breaks[static_cast<int>(BatchBreak::CAPACITY)]++;
+    }
+
+    QuadEntry entry;
+    entry.key = makeSortKey(texture);
+    entry.order = static_cast<unsigned int>(m_quads.size());
+    entry.first = static_cast<unsigned int>(m_compactVertices ? m_packedVertices.size() : m_vertices.size());
+    entry.instanceCount = 0;
+    m_quads.push_back(entry);
+    m_renderStats.quads++;
+
+    if (m_compactVertices) {
+        m_packedVertices.resize(entry.first + 4);
+    } else {
+        m_vertices.resize(entry.first + 4);
+    }
+    return entry.first;
+}
+
+void Renderer::writeQuad(unsigned int firstVertex, const float* positions, float u0, float v0, float u1, float v1, const Color& color) {
+    // 顶点直接写入批处理缓冲区
+    if (m_compactVertices) {
+        // 颜色和UV每个四边形只量化一次
+        uint32_t packedColor = PackedVertex::packColor(color);
+        uint16_t pu0 = PackedVertex::packUnorm16(u0);
+        uint16_t pv0 = PackedVertex::packUnorm16(v0);
+        uint16_t pu1 = PackedVertex::packUnorm16(u1);
+        uint16_t pv1 = PackedVertex::packUnorm16(v1);
+
+        PackedVertex* vertices = &m_packedVertices[firstVertex];
+        vertices[0] = {positions[0], positions[1], pu0, pv0, packedColor};
+        vertices[1] = {positions[2], positions[3], pu1, pv0, packedColor};
+        vertices[2] = {positions[4], positions[5], pu0, pv1, packedColor};
+        vertices[3] = {positions[6], positions[7], pu1, pv1, packedColor};
+    } else {
+        Vertex* vertices = &m_vertices[firstVertex];
+        vertices[0] = Vertex(positions[0], positions[1], 0.0f, u0, v0, color);
+        vertices[1] = Vertex(positions[2], positions[3], 0.0f, u1, v0, color);
+        vertices[2] = Vertex(positions[4], positions[5], 0.0f, u0, v1, color);
+        vertices[3] = Vertex(positions[6], positions[7], 0.0f, u1, v1, color);
+    }
+}
+
+uint64_t Renderer::makeSortKey(const Texture* texture) {
+    uint64_t layer = static_cast<uint64_t>(static_cast<uint16_t>(m_layer + 32768));
+    Shader* current = m_shader ? m_shader : m_defaultShader.get();
+    uint64_t shader = findSlot(m_shaderSlots, current);
+    if (shader == m_shaderBlocks.size()) {
+        // 着色器首次分配槽位时解析一次uniform块，刷新时只使用缓存的句柄
+        m_shaderBlocks.push_back(current ? current->resolveBlock(FRAME_UNIFORMS_BLOCK_NAME) : UniformHandle());
+    }
+    shader &= 0xFFFF;
+    uint64_t textureSlot = findSlot(m_textureSlots, texture) & 0xFFFFFFFF;
+    return (layer << LAYER_SHIFT) | (shader << SHADER_SHIFT) | textureSlot;
+}
+
+size_t Renderer::getPendingQuadCount() const {
+    size_t vertexCount = m_compactVertices ? m_packedVertices.size() : m_vertices.size();
+    return vertexCount / 4 + m_instances.size();
+}
+
+void Renderer::drawInstancedRange(const PackedSpriteInstance* instances, size_t count, const Texture* texture) {
+    // 超出设备单次实例数上限时拆分
+    size_t maxInstances = m_capabilities.maxInstancesPerDraw > 0 ? m_capabilities.maxInstancesPerDraw : count;
+    for (size_t start = 0; start < count; start += maxInstances) {
+        if (start > 0) {
+            m_renderStats.breaks[static_cast<int>(BatchBreak::CAPACITY)]++;
+        }
+        m_device->drawInstanced(instances + start, std::min(maxInstances, count - start), texture);
+        m_renderStats.batches++;
+    }
+}
+
 void Renderer::flush() {
-    if (m_vertices.empty() || m_indices.empty()) {
+    if (m_quads.empty()) {
         return;
     }
+    auto flushStart = std::chrono::steady_clock::now();
 
-    // 使用默认着色器
-    m_defaultShader->use();
+    // 按(图层, 着色器, 纹理)排序，排序键相同时保持提交顺序
+    if (!m_presorted) {
+        std::sort(m_quads.begin(), m_quads.end(), [](const QuadEntry& a, const QuadEntry& b) {
+            return a.key != b.key ? a.key < b.key : a.order < b.order;
+        });
+    }
 
-    // 这里需要实现实际的渲染逻辑
-    // 包括设置顶点缓冲区、索引缓冲区、纹理绑定等
+    // 按排序后的顺序为逐顶点四边形生成索引，顶点保持原位不复制
+    m_indices.clear();
+    for (const auto& quad : m_quads) {
+        if (quad.instanceCount > 0) {
+            continue;
+        }
+        unsigned int baseIndex = quad.first;
+        m_indices.push_back(baseIndex);
+        m_indices.push_back(baseIndex + 1);
+        m_indices.push_back(baseIndex + 2);
+        m_indices.push_back(baseIndex + 2);
+        m_indices.push_back(baseIndex + 1);
+        m_indices.push_back(baseIndex + 3);
+    }
+
+    const void* vertexData = m_compactVertices ? static_cast<const void*>(m_packedVertices.data()) : static_cast<const void*>(m_vertices.data());
+    const VertexFormat& format = getVertexFormat();
+    size_t vertexCount = m_compactVertices ? m_packedVertices.size() : m_vertices.size();
+    const unsigned int* indexData = m_indices.data();
+    const PackedSpriteInstance* instanceData = m_instances.data();
+    if (m_streamBuffer) {
+        // 上传到环形缓冲区，放不下时直接使用批处理缓冲区
+        const void* streamedVertices = vertexCount > 0 ? m_streamBuffer->write(vertexData, vertexCount * format.stride) : vertexData;
+        const void* streamedIndices = m_indices.empty() ? indexData : m_streamBuffer->write(indexData, m_indices.size() * sizeof(unsigned int));
+        const void* streamedInstances = m_instances.empty() ? instanceData : m_streamBuffer->write(instanceData, m_instances.size() * sizeof(PackedSpriteInstance));
+        if (streamedVertices && streamedIndices && streamedInstances) {
+            vertexData = streamedVertices;
+            indexData = static_cast<const unsigned int*>(streamedIndices);
+            instanceData = static_cast<const PackedSpriteInstance*>(streamedInstances);
+        }
+    }
+    Shader* boundShader = nullptr;
+    size_t indexOffset = 0;
+    size_t batchStart = 0;
+    while (batchStart < m_quads.size()) {
+        uint64_t key = m_quads[batchStart].key;
+        size_t shaderSlot = static_cast<size_t>((key & SHADER_MASK) >> SHADER_SHIFT);
+        Shader* shader = m_shaderSlots[shaderSlot];
+        const Texture* texture = m_textureSlots[key & 0xFFFFFFFF];
+        if (shader && shader != boundShader) {
+            shader->use();
+            boundShader = shader;
+            if (m_hasFrameUniforms && std::find(m_frameUniformShaders.begin(), m_frameUniformShaders.end(), shader) == m_frameUniformShaders.end()) {
+                shader->setUniformBlock(m_shaderBlocks[shaderSlot], &m_frameUniforms, sizeof(FrameUniforms));
+                m_frameUniformShaders.push_back(shader);
+            }
+        }
+
+        // 排序键相同的一段内，连续的逐顶点四边形合并为一次drawIndexed，连续的实例合并为一次drawInstanced
+        size_t runStart = batchStart;
+        while (runStart < m_quads.size() && m_quads[runStart].key == key) {
+            bool instanced = m_quads[runStart].instanceCount > 0;
+            size_t runEnd = runStart + 1;
+            while (runEnd < m_quads.size() && m_quads[runEnd].key == key && (m_quads[runEnd].instanceCount > 0) == instanced) {
+                runEnd++;
+            }
+            if (runStart > batchStart) {
+                m_renderStats.breaks[static_cast<int>(BatchBreak::INSTANCING)]++;
+            }
+
+            if (instanced) {
+                // 实例在缓冲区中连续时直接提交，否则先收集
+                bool contiguous = true;
+                size_t instanceCount = m_quads[runStart].instanceCount;
+                for (size_t i = runStart + 1; i < runEnd; ++i) {
+                    contiguous = contiguous && m_quads[i].first == m_quads[i - 1].first + m_quads[i - 1].instanceCount;
+                    instanceCount += m_quads[i].instanceCount;
+                }
+                if (contiguous) {
+                    drawInstancedRange(instanceData + m_quads[runStart].first, instanceCount, texture);
+                } else {
+                    m_instanceScratch.clear();
+                    for (size_t i = runStart; i < runEnd; ++i) {
+                        const PackedSpriteInstance* first = &m_instances[m_quads[i].first];
+                        m_instanceScratch.insert(m_instanceScratch.end(), first, first + m_quads[i].instanceCount);
+                    }
+                    drawInstancedRange(m_instanceScratch.data(), m_instanceScratch.size(), texture);
+                }
+            } else {
+                size_t indexCount = (runEnd - runStart) * 6;
+                m_device->drawIndexed(vertexData, format, vertexCount, indexData + indexOffset, indexCount, texture);
+                m_renderStats.batches++;
+                indexOffset += indexCount;
+            }
+            runStart = runEnd;
+        }
+
+        // 记录与下一批次之间的中断原因
+        if (runStart < m_quads.size()) {
+            uint64_t next = m_quads[runStart].key;
+            if ((key & LAYER_MASK) != (next & LAYER_MASK)) {
+                m_renderStats.breaks[static_cast<int>(BatchBreak::LAYER)]++;
+            } else if ((key & SHADER_MASK) != (next & SHADER_MASK)) {
+                m_renderStats.breaks[static_cast<int>(BatchBreak::SHADER)]++;
+            } else {
+                m_renderStats.breaks[static_cast<int>(BatchBreak::TEXTURE)]++;
+            }
+        }
+        batchStart = runStart;
+    }
+    m_renderStats.flushes++;
+    m_renderStats.vertices += static_cast<unsigned int>(vertexCount + m_instances.size() * 4);
+    m_renderStats.indices += static_cast<unsigned int>(m_indices.size());
+    m_renderStats.triangles += static_cast<unsigned int>(m_indices.size() / 3 + m_instances.size() * 2);
+    m_renderStats.uploadBytes += vertexCount * format.stride + m_indices.size() * sizeof(unsigned int) + m_instances.size() * sizeof(PackedSpriteInstance);
+    m_renderStats.flushTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - flushStart).count();
 
     m_vertices.clear();
+    m_packedVertices.clear();
     m_indices.clear();
+    m_quads.clear();
+    m_instances.clear();
 }
 
 void Renderer::setupDefaultShader() {
     // 创建默认着色器
-    m_defaultShader = std::make_unique<Shader>();
+    m_defaultShader = m_device->createShader();
+    if (!m_defaultShader) {
+        return;
+    }
 
     // 默认顶点着色器
     std::string vertexSource = R"(
@@ -233,25 +1013,23 @@ void GraphicsManager::cleanup() {
     }
 }
 
-std::unique_ptr<Renderer> GraphicsManager::createRenderer() {
+std::unique_ptr<Renderer> GraphicsManager::createRenderer(int width, int height) {
     // 创建图形设备
-    // 这里需要实现平台特定的图形设备创建
-    std::unique_ptr<GraphicsDevice> device;
-    
+    // 目前只有软件光栅化设备，平台GPU设备接入后在这里选择
+    std::unique_ptr<GraphicsDevice> device = std::make_unique<SoftwareGraphicsDevice>(width, height);
+
     // 创建渲染器
     return std::make_unique<Renderer>(std::move(device));
 }
 
 std::unique_ptr<Shader> GraphicsManager::createShader() {
     // 创建着色器
-    // 这里需要实现平台特定的着色器创建
-    return std::make_unique<Shader>();
+    return std::make_unique<SoftwareShader>();
 }
 
 std::unique_ptr<Texture> GraphicsManager::createTexture() {
     // 创建纹理
-    // 这里需要实现平台特定的纹理创建
-    return std::make_unique<Texture>();
+    return std::make_unique<SoftwareTexture>();
 }
 
 } // namespace Appgame
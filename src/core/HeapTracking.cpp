@@ -0,0 +1,69 @@
+#include "core/FrameArena.h"
+#include <cstdlib>
+#include <new>
+
+// 替换全局operator new/delete以统计堆分配次数
+// 每次分配都有原子计数开销，不编入AppgameCore，只由测试、基准测试（以及开启APPGAME_TRACK_HEAP_ALLOCATIONS时的游戏）链接
+namespace {
+
+void* trackedAllocate(size_t size) {
+    Appgame::recordHeapAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void trackedFree(void* pointer) {
+    if (pointer) {
+        Appgame::recordHeapFree();
+        std::free(pointer);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    trackedFree(pointer);
+}
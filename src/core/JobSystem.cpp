@@ -0,0 +1,296 @@
+#include "core/JobSystem.h"
+#include <algorithm>
+
+namespace Appgame {
+
+// 完成计数器：remaining归零时唤醒所有等待它的后续任务
+struct JobCounter {
+    std::atomic<int> remaining;
+    std::mutex mutex;
+    bool done;
+    std::vector<std::shared_ptr<JobSystem::Job>> continuations;
+
+    explicit JobCounter(int count)
+        : remaining(count), done(count == 0) {}
+};
+
+struct JobSystem::Job {
+    std::function<void()> func;
+    std::shared_ptr<JobCounter> counter;
+    std::atomic<int> pendingDependencies;
+
+    Job(std::function<void()> f, std::shared_ptr<JobCounter> c)
+        : func(std::move(f)), counter(std::move(c)), pendingDependencies(1) {}
+};
+
+namespace {
+
+// 当前线程所属的任务系统及队列索引
+struct WorkerContext {
+    const JobSystem* owner = nullptr;
+    int index = -1;
+};
+
+thread_local WorkerContext t_workerContext;
+
+} // namespace
+
+// JobHandle 实现
+
+JobHandle::JobHandle(std::shared_ptr<JobCounter> counter)
+    : m_counter(std::move(counter)) {
+}
+
+bool JobHandle::isValid() const {
+    return m_counter != nullptr;
+}
+
+bool JobHandle::isComplete() const {
+    return !m_counter || m_counter->remaining.load(std::memory_order_acquire) == 0;
+}
+
+// JobSystem 实现
+
+JobSystem::JobSystem()
+    : m_queuedJobs(0)
+    , m_running(false)
+    , m_jobsExecuted(0)
+    , m_jobsStolen(0)
+{
+}
+
+JobSystem::~JobSystem() {
+    cleanup();
+}
+
+bool JobSystem::init(unsigned int workerCount) {
+    if (m_running) {
+        return true;
+    }
+
+    if (workerCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    // 每个工作线程一个队列，最后一个为外部线程共享队列
+    m_queues.clear();
+    for (unsigned int i = 0; i <= workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_running = true;
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerMain, this, i);
+    }
+    return true;
+}
+
+void JobSystem::cleanup() {
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+    m_queues.clear();
+    m_queuedJobs = 0;
+}
+
+JobHandle JobSystem::schedule(std::function<void()> job) {
+    return submit(std::move(job), std::make_shared<JobCounter>(1), {});
+}
+
+JobHandle JobSystem::schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies) {
+    return submit(std::move(job), std::make_shared<JobCounter>(1), dependencies);
+}
+
+JobHandle JobSystem::parallelFor(size_t count, size_t grainSize, std::function<void(size_t begin, size_t end)> body) {
+    if (count == 0) {
+        return JobHandle(std::make_shared<JobCounter>(0));
+    }
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+    auto counter = std::make_shared<JobCounter>(static_cast<int>(chunkCount));
+    auto sharedBody = std::make_shared<std::function<void(size_t, size_t)>>(std::move(body));
+
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        size_t begin = chunk * grainSize;
+        size_t end = std::min(begin + grainSize, count);
+        submit([sharedBody, begin, end]() { (*sharedBody)(begin, end); }, counter, {});
+    }
+    return JobHandle(counter);
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    int ownIndex = currentQueueIndex();
+    while (!handle.isComplete()) {
+        std::shared_ptr<Job> job = acquireJob(ownIndex);
+        if (job) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+unsigned int JobSystem::getWorkerCount() const {
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+bool JobSystem::isRunning() const {
+    return m_running;
+}
+
+JobSystem::Stats JobSystem::getStats() const {
+    Stats stats;
+    stats.jobsExecuted = m_jobsExecuted.load();
+    stats.jobsStolen = m_jobsStolen.load();
+    return stats;
+}
+
+void JobSystem::workerMain(unsigned int index) {
+    t_workerContext.owner = this;
+    t_workerContext.index = static_cast<int>(index);
+
+    while (m_running) {
+        std::shared_ptr<Job> job = acquireJob(static_cast<int>(index));
+        if (job) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepCondition.wait(lock, [this]() {
+            return m_queuedJobs.load() > 0 || !m_running;
+        });
+    }
+
+    t_workerContext = WorkerContext();
+}
+
+JobHandle JobSystem::submit(std::function<void()> func, std::shared_ptr<JobCounter> counter, const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<Job>(std::move(func), counter);
+
+    // 登记到尚未完成的依赖上，pendingDependencies初始的1防止在登记过程中被提前提交
+    for (const auto& dependency : dependencies) {
+        if (!dependency.m_counter) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency.m_counter->mutex);
+        if (!dependency.m_counter->done) {
+            job->pendingDependencies.fetch_add(1);
+            dependency.m_counter->continuations.push_back(job);
+        }
+    }
+
+    if (job->pendingDependencies.fetch_sub(1) == 1) {
+        enqueue(job);
+    }
+    return JobHandle(counter);
+}
+
+void JobSystem::enqueue(std::shared_ptr<Job> job) {
+    // 未初始化时直接在调用线程执行
+    if (!m_running || m_queues.empty()) {
+        execute(job);
+        return;
+    }
+
+    WorkerQueue& queue = *m_queues[currentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_queuedJobs.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_one();
+}
+
+std::shared_ptr<JobSystem::Job> JobSystem::acquireJob(int ownIndex) {
+    if (m_queues.empty() || m_queuedJobs.load() <= 0) {
+        return nullptr;
+    }
+
+    // 本队列：后进先出，缓存局部性更好
+    if (ownIndex >= 0) {
+        WorkerQueue& own = *m_queues[ownIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            std::shared_ptr<Job> job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+
+    // 窃取：从相邻队列开始，取最早入队的任务
+    size_t queueCount = m_queues.size();
+    size_t start = ownIndex >= 0 ? static_cast<size_t>(ownIndex) + 1 : 0;
+    for (size_t i = 0; i < queueCount; ++i) {
+        size_t victim = (start + i) % queueCount;
+        if (static_cast<int>(victim) == ownIndex) {
+            continue;
+        }
+        WorkerQueue& queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            std::shared_ptr<Job> job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_queuedJobs.fetch_sub(1);
+            m_jobsStolen.fetch_add(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(const std::shared_ptr<Job>& job) {
+    if (job->func) {
+        job->func();
+    }
+    m_jobsExecuted.fetch_add(1);
+
+    JobCounter& counter = *job->counter;
+    if (counter.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // 计数归零：提交所有依赖已满足的后续任务
+    std::vector<std::shared_ptr<Job>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        counter.done = true;
+        continuations.swap(counter.continuations);
+    }
+    for (auto& continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1) == 1) {
+            enqueue(std::move(continuation));
+        }
+    }
+}
+
+int JobSystem::currentQueueIndex() const {
+    if (t_workerContext.owner == this) {
+        return t_workerContext.index;
+    }
+    return static_cast<int>(m_queues.size()) - 1;
+}
+
+} // namespace Appgame
@@ -0,0 +1,99 @@
+#include "core/LayerCache.h"
+#include <cmath>
+
+namespace Appgame {
+
+LayerCache::LayerCache()
+    : m_key(0)
+    , m_valid(false)
+    , m_width(0)
+    , m_height(0)
+{
+    m_stats = Stats();
+}
+
+LayerCache::~LayerCache() {
+}
+
+void LayerCache::draw(Renderer& renderer, uint64_t key, const Rect& dstRect, const DrawFunction& drawLayer) {
+    int width = static_cast<int>(std::ceil(dstRect.width));
+    int height = static_cast<int>(std::ceil(dstRect.height));
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    if (!m_valid || m_key != key || m_width != width || m_height != height) {
+        if (!rebuild(renderer, width, height, drawLayer)) {
+            m_valid = false;
+            m_stats.fallbacks++;
+            drawLayer(renderer, dstRect.x, dstRect.y);
+            return;
+        }
+        m_key = key;
+        m_valid = true;
+        m_stats.rebuilds++;
+    } else {
+        m_stats.hits++;
+    }
+
+    // 纹理与dstRect像素一一对应
+    renderer.drawSprite(*m_texture, Rect(0.0f, 0.0f, dstRect.width / width, dstRect.height / height), dstRect);
+}
+
+void LayerCache::invalidate() {
+    m_valid = false;
+}
+
+bool LayerCache::isValid(uint64_t key) const {
+    return m_valid && m_key == key;
+}
+
+const Texture* LayerCache::getTexture() const {
+    return m_valid ? m_texture.get() : nullptr;
+}
+
+const LayerCache::Stats& LayerCache::getStats() const {
+    return m_stats;
+}
+
+bool LayerCache::rebuild(Renderer& renderer, int width, int height, const DrawFunction& drawLayer) {
+    GraphicsDevice* device = renderer.getDevice();
+    if (!device || !device->getCapabilities().renderTargets || renderer.getTargetTexture()) {
+        return false;
+    }
+
+    if (!m_texture || m_width != width || m_height != height) {
+        m_texture = device->createTexture();
+        if (!m_texture || !m_texture->create(width, height)) {
+            m_texture.reset();
+            return false;
+        }
+        m_width = width;
+        m_height = height;
+    }
+    if (!renderer.setTargetTexture(m_texture.get())) {
+        return false;
+    }
+
+    // 合成时使用图层本地坐标，暂时关闭按屏幕设置的剔除矩形和裁剪矩形
+    bool culling = renderer.isCullingEnabled();
+    Rect cullRect = renderer.getCullRect();
+    renderer.clearCullRect();
+    bool scissor = renderer.isScissorEnabled();
+    Rect scissorRect = renderer.getScissorRect();
+    renderer.clearScissorRect();
+
+    device->clear(Color(0.0f, 0.0f, 0.0f, 0.0f));
+    drawLayer(renderer, 0.0f, 0.0f);
+    renderer.setTargetTexture(nullptr);
+
+    if (culling) {
+        renderer.setCullRect(cullRect);
+    }
+    if (scissor) {
+        renderer.setScissorRect(scissorRect);
+    }
+    return true;
+}
+
+} // namespace Appgame
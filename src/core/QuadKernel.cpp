@@ -0,0 +1,503 @@
+#include "core/QuadKernel.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define APPGAME_QUAD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APPGAME_QUAD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define APPGAME_QUAD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Appgame {
+
+namespace {
+
+// sincos近似：按π/2分象限，余角用多项式逼近（系数取自Cephes sinf/cosf）
+const float TWO_OVER_PI = 0.636619772367581343f;
+const float PI_OVER_2_PART1 = 1.5703125f;
+const float PI_OVER_2_PART2 = 4.837512969970703125e-4f;
+const float PI_OVER_2_PART3 = 7.54978995489188216e-8f;
+const float SIN_C1 = -1.6666654611e-1f;
+const float SIN_C2 = 8.3321608736e-3f;
+const float SIN_C3 = -1.9515295891e-4f;
+const float COS_C1 = 4.166664568298827e-2f;
+const float COS_C2 = -1.388731625493765e-3f;
+const float COS_C3 = 2.443315711809948e-5f;
+
+// 长度平方低于该值的线段视为长度为0
+const float MIN_LINE_LENGTH_SQUARED = 1e-12f;
+
+// 变换单个精灵（标量实现与SIMD尾部共用）
+void transformSprite(const SpriteInstance& instance, float* out) {
+    float sine, cosine;
+    fastSinCos(instance.rotation, sine, cosine);
+
+    float halfWidth = instance.width * 0.5f;
+    float halfHeight = instance.height * 0.5f;
+    float hwc = halfWidth * cosine;
+    float hws = halfWidth * sine;
+    float hhc = halfHeight * cosine;
+    float hhs = halfHeight * sine;
+
+    out[0] = (instance.x - hwc) + hhs;
+    out[1] = (instance.y - hws) - hhc;
+    out[2] = (instance.x + hwc) + hhs;
+    out[3] = (instance.y + hws) - hhc;
+    out[4] = (instance.x - hwc) - hhs;
+    out[5] = (instance.y - hws) + hhc;
+    out[6] = (instance.x + hwc) - hhs;
+    out[7] = (instance.y + hws) + hhc;
+}
+
+void transformLine(const LineInstance& line, float* out) {
+    float dx = line.x2 - line.x1;
+    float dy = line.y2 - line.y1;
+    float lengthSquared = dx * dx + dy * dy;
+    float scale = lengthSquared > MIN_LINE_LENGTH_SQUARED ? line.width * 0.5f / std::sqrt(lengthSquared) : 0.0f;
+    float nx = -dy * scale;
+    float ny = dx * scale;
+
+    out[0] = line.x1 + nx;
+    out[1] = line.y1 + ny;
+    out[2] = line.x2 + nx;
+    out[3] = line.y2 + ny;
+    out[4] = line.x1 - nx;
+    out[5] = line.y1 - ny;
+    out[6] = line.x2 - nx;
+    out[7] = line.y2 - ny;
+}
+
+#if defined(APPGAME_QUAD_SSE2)
+
+void sinCos4(__m128 angle, __m128& sine, __m128& cosine) {
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(TWO_OVER_PI)));
+    __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(angle, _mm_mul_ps(q, _mm_set1_ps(PI_OVER_2_PART1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(PI_OVER_2_PART2)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(PI_OVER_2_PART3)));
+    __m128 z = _mm_mul_ps(r, r);
+
+    __m128 sinPoly = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(SIN_C3)), _mm_set1_ps(SIN_C2));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SIN_C1));
+    sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, _mm_mul_ps(z, r)), r);
+
+    __m128 cosPoly = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(COS_C3)), _mm_set1_ps(COS_C2));
+    cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(COS_C1));
+    cosPoly = _mm_mul_ps(cosPoly, _mm_mul_ps(z, z));
+    cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(_mm_set1_ps(0.5f), z));
+    cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+    // 奇数象限交换sin/cos，再按象限取符号
+    __m128i one = _mm_set1_epi32(1);
+    __m128i two = _mm_set1_epi32(2);
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+    __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+    sine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cosPoly), _mm_andnot_ps(swap, sinPoly)), sinSign);
+    cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sinPoly), _mm_andnot_ps(swap, cosPoly)), cosSign);
+}
+
+// 4个四边形的8个分量向量转置后写出
+void storeQuads4(__m128 v0, __m128 v1, __m128 v2, __m128 v3, __m128 v4, __m128 v5, __m128 v6, __m128 v7, float* out) {
+    _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+    _MM_TRANSPOSE4_PS(v4, v5, v6, v7);
+    _mm_storeu_ps(out, v0);
+    _mm_storeu_ps(out + 4, v4);
+    _mm_storeu_ps(out + 8, v1);
+    _mm_storeu_ps(out + 12, v5);
+    _mm_storeu_ps(out + 16, v2);
+    _mm_storeu_ps(out + 20, v6);
+    _mm_storeu_ps(out + 24, v3);
+    _mm_storeu_ps(out + 28, v7);
+}
+
+size_t transformSpritesSIMD(const SpriteInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; i + 4 <= count; i += 4, in += 4, out += 32) {
+        __m128 x = _mm_set_ps(in[3].x, in[2].x, in[1].x, in[0].x);
+        __m128 y = _mm_set_ps(in[3].y, in[2].y, in[1].y, in[0].y);
+        __m128 halfWidth = _mm_mul_ps(_mm_set_ps(in[3].width, in[2].width, in[1].width, in[0].width), half);
+        __m128 halfHeight = _mm_mul_ps(_mm_set_ps(in[3].height, in[2].height, in[1].height, in[0].height), half);
+        __m128 sine, cosine;
+        sinCos4(_mm_set_ps(in[3].rotation, in[2].rotation, in[1].rotation, in[0].rotation), sine, cosine);
+
+        __m128 hwc = _mm_mul_ps(halfWidth, cosine);
+        __m128 hws = _mm_mul_ps(halfWidth, sine);
+        __m128 hhc = _mm_mul_ps(halfHeight, cosine);
+        __m128 hhs = _mm_mul_ps(halfHeight, sine);
+        __m128 left = _mm_sub_ps(x, hwc);
+        __m128 right = _mm_add_ps(x, hwc);
+        __m128 leftY = _mm_sub_ps(y, hws);
+        __m128 rightY = _mm_add_ps(y, hws);
+
+        storeQuads4(_mm_add_ps(left, hhs), _mm_sub_ps(leftY, hhc),
+                    _mm_add_ps(right, hhs), _mm_sub_ps(rightY, hhc),
+                    _mm_sub_ps(left, hhs), _mm_add_ps(leftY, hhc),
+                    _mm_sub_ps(right, hhs), _mm_add_ps(rightY, hhc), out);
+    }
+    return i;
+}
+
+size_t transformLinesSIMD(const LineInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, in += 4, out += 32) {
+        __m128 x1 = _mm_set_ps(in[3].x1, in[2].x1, in[1].x1, in[0].x1);
+        __m128 y1 = _mm_set_ps(in[3].y1, in[2].y1, in[1].y1, in[0].y1);
+        __m128 x2 = _mm_set_ps(in[3].x2, in[2].x2, in[1].x2, in[0].x2);
+        __m128 y2 = _mm_set_ps(in[3].y2, in[2].y2, in[1].y2, in[0].y2);
+        __m128 halfWidth = _mm_mul_ps(_mm_set_ps(in[3].width, in[2].width, in[1].width, in[0].width), _mm_set1_ps(0.5f));
+
+        // 近似倒数平方根加一次牛顿迭代，长度为0的线段法线置0
+        __m128 dx = _mm_sub_ps(x2, x1);
+        __m128 dy = _mm_sub_ps(y2, y1);
+        __m128 lengthSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 valid = _mm_cmpgt_ps(lengthSquared, _mm_set1_ps(MIN_LINE_LENGTH_SQUARED));
+        __m128 inverse = _mm_rsqrt_ps(lengthSquared);
+        inverse = _mm_mul_ps(inverse, _mm_sub_ps(_mm_set1_ps(1.5f),
+                                                  _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), lengthSquared), _mm_mul_ps(inverse, inverse))));
+        __m128 scale = _mm_and_ps(valid, _mm_mul_ps(inverse, halfWidth));
+        __m128 nx = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(dy, scale));
+        __m128 ny = _mm_mul_ps(dx, scale);
+
+        storeQuads4(_mm_add_ps(x1, nx), _mm_add_ps(y1, ny),
+                    _mm_add_ps(x2, nx), _mm_add_ps(y2, ny),
+                    _mm_sub_ps(x1, nx), _mm_sub_ps(y1, ny),
+                    _mm_sub_ps(x2, nx), _mm_sub_ps(y2, ny), out);
+    }
+    return i;
+}
+
+#elif defined(APPGAME_QUAD_AVX2)
+
+void sinCos8(__m256 angle, __m256& sine, __m256& cosine) {
+    __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(angle, _mm256_set1_ps(TWO_OVER_PI)));
+    __m256 q = _mm256_cvtepi32_ps(quadrant);
+    __m256 r = _mm256_sub_ps(angle, _mm256_mul_ps(q, _mm256_set1_ps(PI_OVER_2_PART1)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(PI_OVER_2_PART2)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(PI_OVER_2_PART3)));
+    __m256 z = _mm256_mul_ps(r, r);
+
+    __m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(SIN_C3)), _mm256_set1_ps(SIN_C2));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(SIN_C1));
+    sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, _mm256_mul_ps(z, r)), r);
+
+    __m256 cosPoly = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(COS_C3)), _mm256_set1_ps(COS_C2));
+    cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(COS_C1));
+    cosPoly = _mm256_mul_ps(cosPoly, _mm256_mul_ps(z, z));
+    cosPoly = _mm256_sub_ps(cosPoly, _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+    cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i two = _mm256_set1_epi32(2);
+    __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+    __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30));
+    __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30));
+    sine = _mm256_xor_ps(_mm256_blendv_ps(sinPoly, cosPoly, swap), sinSign);
+    cosine = _mm256_xor_ps(_mm256_blendv_ps(cosPoly, sinPoly, swap), cosSign);
+}
+
+// 8x8转置：输入为8个分量向量（每个含8个四边形），输出每个四边形的8个分量
+void storeQuads8(__m256 v0, __m256 v1, __m256 v2, __m256 v3, __m256 v4, __m256 v5, __m256 v6, __m256 v7, float* out) {
+    __m256 t0 = _mm256_unpacklo_ps(v0, v1);
+    __m256 t1 = _mm256_unpackhi_ps(v0, v1);
+    __m256 t2 = _mm256_unpacklo_ps(v2, v3);
+    __m256 t3 = _mm256_unpackhi_ps(v2, v3);
+    __m256 t4 = _mm256_unpacklo_ps(v4, v5);
+    __m256 t5 = _mm256_unpackhi_ps(v4, v5);
+    __m256 t6 = _mm256_unpacklo_ps(v6, v7);
+    __m256 t7 = _mm256_unpackhi_ps(v6, v7);
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44);
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, 0x44);
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44);
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, 0x44);
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+    _mm256_storeu_ps(out, _mm256_permute2f128_ps(s0, s4, 0x20));
+    _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(s1, s5, 0x20));
+    _mm256_storeu_ps(out + 16, _mm256_permute2f128_ps(s2, s6, 0x20));
+    _mm256_storeu_ps(out + 24, _mm256_permute2f128_ps(s3, s7, 0x20));
+    _mm256_storeu_ps(out + 32, _mm256_permute2f128_ps(s0, s4, 0x31));
+    _mm256_storeu_ps(out + 40, _mm256_permute2f128_ps(s1, s5, 0x31));
+    _mm256_storeu_ps(out + 48, _mm256_permute2f128_ps(s2, s6, 0x31));
+    _mm256_storeu_ps(out + 56, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+
+#define APPGAME_GATHER8(field) \
+    _mm256_set_ps(in[7].field, in[6].field, in[5].field, in[4].field, in[3].field, in[2].field, in[1].field, in[0].field)
+
+size_t transformSpritesSIMD(const SpriteInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (; i + 8 <= count; i += 8, in += 8, out += 64) {
+        __m256 x = APPGAME_GATHER8(x);
+        __m256 y = APPGAME_GATHER8(y);
+        __m256 halfWidth = _mm256_mul_ps(APPGAME_GATHER8(width), half);
+        __m256 halfHeight = _mm256_mul_ps(APPGAME_GATHER8(height), half);
+        __m256 sine, cosine;
+        sinCos8(APPGAME_GATHER8(rotation), sine, cosine);
+
+        __m256 hwc = _mm256_mul_ps(halfWidth, cosine);
+        __m256 hws = _mm256_mul_ps(halfWidth, sine);
+        __m256 hhc = _mm256_mul_ps(halfHeight, cosine);
+        __m256 hhs = _mm256_mul_ps(halfHeight, sine);
+        __m256 left = _mm256_sub_ps(x, hwc);
+        __m256 right = _mm256_add_ps(x, hwc);
+        __m256 leftY = _mm256_sub_ps(y, hws);
+        __m256 rightY = _mm256_add_ps(y, hws);
+
+        storeQuads8(_mm256_add_ps(left, hhs), _mm256_sub_ps(leftY, hhc),
+                    _mm256_add_ps(right, hhs), _mm256_sub_ps(rightY, hhc),
+                    _mm256_sub_ps(left, hhs), _mm256_add_ps(leftY, hhc),
+                    _mm256_sub_ps(right, hhs), _mm256_add_ps(rightY, hhc), out);
+    }
+    return i;
+}
+
+size_t transformLinesSIMD(const LineInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, in += 8, out += 64) {
+        __m256 x1 = APPGAME_GATHER8(x1);
+        __m256 y1 = APPGAME_GATHER8(y1);
+        __m256 x2 = APPGAME_GATHER8(x2);
+        __m256 y2 = APPGAME_GATHER8(y2);
+        __m256 halfWidth = _mm256_mul_ps(APPGAME_GATHER8(width), _mm256_set1_ps(0.5f));
+
+        __m256 dx = _mm256_sub_ps(x2, x1);
+        __m256 dy = _mm256_sub_ps(y2, y1);
+        __m256 lengthSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 valid = _mm256_cmp_ps(lengthSquared, _mm256_set1_ps(MIN_LINE_LENGTH_SQUARED), _CMP_GT_OQ);
+        __m256 inverse = _mm256_rsqrt_ps(lengthSquared);
+        inverse = _mm256_mul_ps(inverse, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                                        _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), lengthSquared), _mm256_mul_ps(inverse, inverse))));
+        __m256 scale = _mm256_and_ps(valid, _mm256_mul_ps(inverse, halfWidth));
+        __m256 nx = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(dy, scale));
+        __m256 ny = _mm256_mul_ps(dx, scale);
+
+        storeQuads8(_mm256_add_ps(x1, nx), _mm256_add_ps(y1, ny),
+                    _mm256_add_ps(x2, nx), _mm256_add_ps(y2, ny),
+                    _mm256_sub_ps(x1, nx), _mm256_sub_ps(y1, ny),
+                    _mm256_sub_ps(x2, nx), _mm256_sub_ps(y2, ny), out);
+    }
+    return i;
+}
+
+#undef APPGAME_GATHER8
+
+#elif defined(APPGAME_QUAD_NEON)
+
+void sinCos4(float32x4_t angle, float32x4_t& sine, float32x4_t& cosine) {
+    int32x4_t quadrant = vcvtnq_s32_f32(vmulq_f32(angle, vdupq_n_f32(TWO_OVER_PI)));
+    float32x4_t q = vcvtq_f32_s32(quadrant);
+    float32x4_t r = vsubq_f32(angle, vmulq_f32(q, vdupq_n_f32(PI_OVER_2_PART1)));
+    r = vsubq_f32(r, vmulq_f32(q, vdupq_n_f32(PI_OVER_2_PART2)));
+    r = vsubq_f32(r, vmulq_f32(q, vdupq_n_f32(PI_OVER_2_PART3)));
+    float32x4_t z = vmulq_f32(r, r);
+
+    float32x4_t sinPoly = vaddq_f32(vmulq_f32(z, vdupq_n_f32(SIN_C3)), vdupq_n_f32(SIN_C2));
+    sinPoly = vaddq_f32(vmulq_f32(sinPoly, z), vdupq_n_f32(SIN_C1));
+    sinPoly = vaddq_f32(vmulq_f32(sinPoly, vmulq_f32(z, r)), r);
+
+    float32x4_t cosPoly = vaddq_f32(vmulq_f32(z, vdupq_n_f32(COS_C3)), vdupq_n_f32(COS_C2));
+    cosPoly = vaddq_f32(vmulq_f32(cosPoly, z), vdupq_n_f32(COS_C1));
+    cosPoly = vmulq_f32(cosPoly, vmulq_f32(z, z));
+    cosPoly = vsubq_f32(cosPoly, vmulq_f32(vdupq_n_f32(0.5f), z));
+    cosPoly = vaddq_f32(cosPoly, vdupq_n_f32(1.0f));
+
+    int32x4_t one = vdupq_n_s32(1);
+    int32x4_t two = vdupq_n_s32(2);
+    uint32x4_t swap = vceqq_s32(vandq_s32(quadrant, one), one);
+    uint32x4_t sinSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(quadrant, two), 30));
+    uint32x4_t cosSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(vaddq_s32(quadrant, one), two), 30));
+    sine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, cosPoly, sinPoly)), sinSign));
+    cosine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, sinPoly, cosPoly)), cosSign));
+}
+
+// 交错写出后按四边形重排（每个四边形前后两半各4个float）
+void storeQuads4(float32x4_t v0, float32x4_t v1, float32x4_t v2, float32x4_t v3,
+                 float32x4_t v4, float32x4_t v5, float32x4_t v6, float32x4_t v7, float* out) {
+    float front[16];
+    float back[16];
+    float32x4x4_t first = {{v0, v1, v2, v3}};
+    float32x4x4_t second = {{v4, v5, v6, v7}};
+    vst4q_f32(front, first);
+    vst4q_f32(back, second);
+    for (int quad = 0; quad < 4; ++quad) {
+        std::memcpy(out + quad * 8, front + quad * 4, 4 * sizeof(float));
+        std::memcpy(out + quad * 8 + 4, back + quad * 4, 4 * sizeof(float));
+    }
+}
+
+float32x4_t gather4(float a, float b, float c, float d) {
+    float values[4] = {a, b, c, d};
+    return vld1q_f32(values);
+}
+
+#define APPGAME_GATHER4(field) gather4(in[0].field, in[1].field, in[2].field, in[3].field)
+
+size_t transformSpritesSIMD(const SpriteInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    for (; i + 4 <= count; i += 4, in += 4, out += 32) {
+        float32x4_t x = APPGAME_GATHER4(x);
+        float32x4_t y = APPGAME_GATHER4(y);
+        float32x4_t halfWidth = vmulq_f32(APPGAME_GATHER4(width), half);
+        float32x4_t halfHeight = vmulq_f32(APPGAME_GATHER4(height), half);
+        float32x4_t sine, cosine;
+        sinCos4(APPGAME_GATHER4(rotation), sine, cosine);
+
+        float32x4_t hwc = vmulq_f32(halfWidth, cosine);
+        float32x4_t hws = vmulq_f32(halfWidth, sine);
+        float32x4_t hhc = vmulq_f32(halfHeight, cosine);
+        float32x4_t hhs = vmulq_f32(halfHeight, sine);
+        float32x4_t left = vsubq_f32(x, hwc);
+        float32x4_t right = vaddq_f32(x, hwc);
+        float32x4_t leftY = vsubq_f32(y, hws);
+        float32x4_t rightY = vaddq_f32(y, hws);
+
+        storeQuads4(vaddq_f32(left, hhs), vsubq_f32(leftY, hhc),
+                    vaddq_f32(right, hhs), vsubq_f32(rightY, hhc),
+                    vsubq_f32(left, hhs), vaddq_f32(leftY, hhc),
+                    vsubq_f32(right, hhs), vaddq_f32(rightY, hhc), out);
+    }
+    return i;
+}
+
+size_t transformLinesSIMD(const LineInstance* in, size_t count, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, in += 4, out += 32) {
+        float32x4_t x1 = APPGAME_GATHER4(x1);
+        float32x4_t y1 = APPGAME_GATHER4(y1);
+        float32x4_t x2 = APPGAME_GATHER4(x2);
+        float32x4_t y2 = APPGAME_GATHER4(y2);
+        float32x4_t halfWidth = vmulq_f32(APPGAME_GATHER4(width), vdupq_n_f32(0.5f));
+
+        float32x4_t dx = vsubq_f32(x2, x1);
+        float32x4_t dy = vsubq_f32(y2, y1);
+        float32x4_t lengthSquared = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        uint32x4_t valid = vcgtq_f32(lengthSquared, vdupq_n_f32(MIN_LINE_LENGTH_SQUARED));
+        float32x4_t inverse = vrsqrteq_f32(lengthSquared);
+        inverse = vmulq_f32(inverse, vrsqrtsq_f32(vmulq_f32(lengthSquared, inverse), inverse));
+        inverse = vmulq_f32(inverse, vrsqrtsq_f32(vmulq_f32(lengthSquared, inverse), inverse));
+        float32x4_t scale = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vmulq_f32(inverse, halfWidth))));
+        float32x4_t nx = vnegq_f32(vmulq_f32(dy, scale));
+        float32x4_t ny = vmulq_f32(dx, scale);
+
+        storeQuads4(vaddq_f32(x1, nx), vaddq_f32(y1, ny),
+                    vaddq_f32(x2, nx), vaddq_f32(y2, ny),
+                    vsubq_f32(x1, nx), vsubq_f32(y1, ny),
+                    vsubq_f32(x2, nx), vsubq_f32(y2, ny), out);
+    }
+    return i;
+}
+
+#undef APPGAME_GATHER4
+
+#else
+
+size_t transformSpritesSIMD(const SpriteInstance*, size_t, float*) {
+    return 0;
+}
+
+size_t transformLinesSIMD(const LineInstance*, size_t, float*) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+QuadKernelType getQuadKernelType() {
+#if defined(APPGAME_QUAD_AVX2)
+    return QuadKernelType::AVX2;
+#elif defined(APPGAME_QUAD_SSE2)
+    return QuadKernelType::SSE2;
+#elif defined(APPGAME_QUAD_NEON)
+    return QuadKernelType::NEON;
+#else
+    return QuadKernelType::SCALAR;
+#endif
+}
+
+const char* getQuadKernelName() {
+    switch (getQuadKernelType()) {
+        case QuadKernelType::AVX2:
+            return "AVX2";
+        case QuadKernelType::SSE2:
+            return "SSE2";
+        case QuadKernelType::NEON:
+            return "NEON";
+        case QuadKernelType::SCALAR:
+            break;
+    }
+    return "Scalar";
+}
+
+int getQuadKernelWidth() {
+    switch (getQuadKernelType()) {
+        case QuadKernelType::AVX2:
+            return 8;
+        case QuadKernelType::SSE2:
+        case QuadKernelType::NEON:
+            return 4;
+        case QuadKernelType::SCALAR:
+            break;
+    }
+    return 1;
+}
+
+void fastSinCos(float angle, float& sine, float& cosine) {
+    // 与SIMD实现相同的运算顺序（就近舍入取象限）
+    int quadrant = static_cast<int>(std::nearbyint(angle * TWO_OVER_PI));
+    float q = static_cast<float>(quadrant);
+    float r = angle - q * PI_OVER_2_PART1;
+    r = r - q * PI_OVER_2_PART2;
+    r = r - q * PI_OVER_2_PART3;
+    float z = r * r;
+
+    float sinPoly = ((z * SIN_C3 + SIN_C2) * z + SIN_C1) * (z * r) + r;
+    float cosPoly = ((z * COS_C3 + COS_C2) * z + COS_C1) * (z * z);
+    cosPoly = cosPoly - 0.5f * z;
+    cosPoly = cosPoly + 1.0f;
+
+    bool swap = (quadrant & 1) != 0;
+    sine = swap ? cosPoly : sinPoly;
+    cosine = swap ? sinPoly : cosPoly;
+    if (quadrant & 2) {
+        sine = -sine;
+    }
+    if ((quadrant + 1) & 2) {
+        cosine = -cosine;
+    }
+}
+
+void transformSprites(const SpriteInstance* instances, size_t count, float* positions) {
+    size_t done = transformSpritesSIMD(instances, count, positions);
+    transformSpritesScalar(instances + done, count - done, positions + done * 8);
+}
+
+void transformSpritesScalar(const SpriteInstance* instances, size_t count, float* positions) {
+    for (size_t i = 0; i < count; ++i) {
+        transformSprite(instances[i], positions + i * 8);
+    }
+}
+
+void transformLines(const LineInstance* lines, size_t count, float* positions) {
+    size_t done = transformLinesSIMD(lines, count, positions);
+    transformLinesScalar(lines + done, count - done, positions + done * 8);
+}
+
+void transformLinesScalar(const LineInstance* lines, size_t count, float* positions) {
+    for (size_t i = 0; i < count; ++i) {
+        transformLine(lines[i], positions + i * 8);
+    }
+}
+
+} // namespace Appgame
@@ -0,0 +1,267 @@
+#include "core/RenderCommand.h"
+#include "core/QuadKernel.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace Appgame {
+
+namespace {
+
+// 排序键各字段
+const int LAYER_SHIFT = 48;
+const uint64_t TRANSLUCENT_BIT = 1ull << 47;
+const uint64_t DEPTH_MASK = (1ull << 23) - 1;
+const uint64_t MATERIAL_MASK = (1ull << 24) - 1;
+
+// 不透明：材质在深度之上；半透明：深度在材质之上
+const int OPAQUE_MATERIAL_SHIFT = 23;
+const int TRANSLUCENT_DEPTH_SHIFT = 24;
+
+// 批量录制时每次变换的四边形数量
+const size_t TRANSFORM_CHUNK = 64;
+
+// 把浮点深度映射为保持顺序的无符号整数，取高23位（符号、指数和14位尾数）
+uint64_t quantizeDepth(float depth) {
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return (bits >> 9) & DEPTH_MASK;
+}
+
+} // namespace
+
+RenderCommandBuffer::RenderCommandBuffer()
+    : m_layer(0)
+    , m_depth(0.0f)
+    , m_translucent(true)
+    , m_shader(nullptr) {
+}
+
+void RenderCommandBuffer::clear() {
+    m_commands.clear();
+}
+
+void RenderCommandBuffer::setLayer(int layer) {
+    m_layer = layer;
+}
+
+int RenderCommandBuffer::getLayer() const {
+    return m_layer;
+}
+
+void RenderCommandBuffer::setDepth(float depth) {
+    m_depth = depth;
+}
+
+float RenderCommandBuffer::getDepth() const {
+    return m_depth;
+}
+
+void RenderCommandBuffer::setTranslucent(bool translucent) {
+    m_translucent = translucent;
+}
+
+bool RenderCommandBuffer::isTranslucent() const {
+    return m_translucent;
+}
+
+void RenderCommandBuffer::setShader(Shader* shader) {
+    m_shader = shader;
+}
+
+void RenderCommandBuffer::drawSprite(const Texture& texture, const Rect& srcRect, const Rect& dstRect, float rotation, const Color& color) {
+    // 与Renderer::drawSprite使用同一变换
+    SpriteInstance instance;
+    instance.x = dstRect.x + dstRect.width * 0.5f;
+    instance.y = dstRect.y + dstRect.height * 0.5f;
+    instance.width = dstRect.width;
+    instance.height = dstRect.height;
+    instance.rotation = rotation;
+
+    RenderCommand& command = append(&texture, color);
+    transformSpritesScalar(&instance, 1, command.positions);
+    command.u0 = srcRect.x;
+    command.v0 = srcRect.y;
+    command.u1 = srcRect.x + srcRect.width;
+    command.v1 = srcRect.y + srcRect.height;
+}
+
+void RenderCommandBuffer::drawSprites(const Texture& texture, const SpriteInstance* instances, size_t count) {
+    float positions[TRANSFORM_CHUNK * 8];
+    for (size_t start = 0; start < count; start += TRANSFORM_CHUNK) {
+        size_t chunk = std::min(TRANSFORM_CHUNK, count - start);
+        transformSprites(instances + start, chunk, positions);
+        for (size_t i = 0; i < chunk; ++i) {
+            const SpriteInstance& instance = instances[start + i];
+            RenderCommand& command = append(&texture, instance.color);
+            std::memcpy(command.positions, &positions[i * 8], sizeof(command.positions));
+            command.u0 = instance.u0;
+            command.v0 = instance.v0;
+            command.u1 = instance.u1;
+            command.v1 = instance.v1;
+        }
+    }
+}
+
+void RenderCommandBuffer::drawRect(const Rect& rect, const Color& color) {
+    float positions[8] = {
+        rect.x, rect.y,
+        rect.x + rect.width, rect.y,
+        rect.x, rect.y + rect.height,
+        rect.x + rect.width, rect.y + rect.height
+    };
+    RenderCommand& command = append(nullptr, color);
+    std::memcpy(command.positions, positions, sizeof(positions));
+}
+
+void RenderCommandBuffer::drawLine(float x1, float y1, float x2, float y2, float width, const Color& color) {
+    LineInstance line = {x1, y1, x2, y2, width, color};
+    drawLines(&line, 1);
+}
+
+void RenderCommandBuffer::drawLines(const LineInstance* lines, size_t count) {
+    float positions[TRANSFORM_CHUNK * 8];
+    for (size_t start = 0; start < count; start += TRANSFORM_CHUNK) {
+        size_t chunk = std::min(TRANSFORM_CHUNK, count - start);
+        transformLines(lines + start, chunk, positions);
+        for (size_t i = 0; i < chunk; ++i) {
+            RenderCommand& command = append(nullptr, lines[start + i].color);
+            std::memcpy(command.positions, &positions[i * 8], sizeof(command.positions));
+        }
+    }
+}
+
+const std::vector<RenderCommand>& RenderCommandBuffer::getCommands() const {
+    return m_commands;
+}
+
+uint64_t RenderCommandBuffer::makeSortKey(int layer, bool translucent, float depth, uint32_t material) {
+    uint64_t key = static_cast<uint64_t>(static_cast<uint16_t>(layer + 32768)) << LAYER_SHIFT;
+    uint64_t depthBits = quantizeDepth(depth);
+    uint64_t materialBits = material & MATERIAL_MASK;
+    if (translucent) {
+        return key | TRANSLUCENT_BIT | (depthBits << TRANSLUCENT_DEPTH_SHIFT) | materialBits;
+    }
+    return key | (materialBits << OPAQUE_MATERIAL_SHIFT) | depthBits;
+}
+
+RenderCommand& RenderCommandBuffer::append(const Texture* texture, const Color& color) {
+    m_commands.emplace_back();
+    RenderCommand& command = m_commands.back();
+    command.key = makeSortKey(m_layer, m_translucent || color.a < 1.0f, m_depth, 0);
+    command.texture = texture;
+    command.shader = m_shader;
+    command.u0 = 0.0f;
+    command.v0 = 0.0f;
+    command.u1 = 0.0f;
+    command.v1 = 0.0f;
+    command.color = color;
+    return command;
+}
+
+size_t RenderCommandQueue::MaterialHash::operator()(const Material& material) const {
+    return std::hash<const void*>()(material.first) * 31 + std::hash<const void*>()(material.second);
+}
+
+RenderCommandQueue::RenderCommandQueue()
+    : m_lastCommandCount(0)
+    , m_lastMaterialCount(0) {
+}
+
+RenderCommandQueue::~RenderCommandQueue() {
+}
+
+RenderCommandBuffer& RenderCommandQueue::createBuffer() {
+    m_buffers.push_back(std::make_unique<RenderCommandBuffer>());
+    return *m_buffers.back();
+}
+
+RenderCommandBuffer& RenderCommandQueue::getBuffer(size_t index) {
+    return *m_buffers[index];
+}
+
+size_t RenderCommandQueue::getBufferCount() const {
+    return m_buffers.size();
+}
+
+void RenderCommandQueue::execute(Renderer& renderer) {
+    // 按缓冲区顺序合并，材质号按首次出现的顺序分配，保证结果确定
+    m_entries.clear();
+    m_materials.clear();
+    for (const auto& buffer : m_buffers) {
+        for (const RenderCommand& command : buffer->getCommands()) {
+            auto result = m_materials.emplace(Material(command.shader, command.texture), static_cast<uint32_t>(m_materials.size()));
+            uint64_t material = result.first->second & MATERIAL_MASK;
+            SortEntry entry;
+            entry.key = command.key | ((command.key & TRANSLUCENT_BIT) ? material : (material << OPAQUE_MATERIAL_SHIFT));
+            entry.command = &command;
+            m_entries.push_back(entry);
+        }
+    }
+    m_lastCommandCount = m_entries.size();
+    m_lastMaterialCount = m_materials.size();
+
+    radixSort();
+
+    m_sorted.clear();
+    for (const SortEntry& entry : m_entries) {
+        m_sorted.push_back(entry.command);
+    }
+    renderer.drawCommands(m_sorted.data(), m_sorted.size());
+
+    for (const auto& buffer : m_buffers) {
+        buffer->clear();
+    }
+}
+
+size_t RenderCommandQueue::getLastCommandCount() const {
+    return m_lastCommandCount;
+}
+
+size_t RenderCommandQueue::getLastMaterialCount() const {
+    return m_lastMaterialCount;
+}
+
+void RenderCommandQueue::radixSort() {
+    size_t count = m_entries.size();
+    if (count < 2) {
+        return;
+    }
+    m_scratch.resize(count);
+
+    // 一次遍历统计所有字节的直方图
+    size_t histograms[8][256] = {};
+    for (const SortEntry& entry : m_entries) {
+        for (int pass = 0; pass < 8; ++pass) {
+            histograms[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    SortEntry* source = m_entries.data();
+    SortEntry* destination = m_scratch.data();
+    for (int pass = 0; pass < 8; ++pass) {
+        size_t* histogram = histograms[pass];
+        int shift = pass * 8;
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            size_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != m_entries.data()) {
+        m_entries.swap(m_scratch);
+    }
+}
+
+} // namespace Appgame
@@ -0,0 +1,1135 @@
+#include "core/SoftwareGraphics.h"
+#include "core/JobSystem.h"
+#include "core/QuadKernel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APPGAME_SOFTWARE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace Appgame {
+
+namespace {
+
+// 分块大小（像素）
+const int TILE_SIZE = 64;
+
+// 顶点坐标吸附到1/16像素，保证共享边两侧的边函数严格相反
+const float SUBPIXEL_SCALE = 16.0f;
+
+// PPM尺寸上限
+const int MAX_IMAGE_SIZE = 16384;
+
+// 实例化绘制每次解包的实例数
+const size_t INSTANCE_CHUNK = 64;
+
+float clamp01(float value) {
+    return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+}
+
+float clampFloat(float value, float minValue, float maxValue) {
+    return value > minValue ? (value < maxValue ? value : maxValue) : minValue;
+}
+
+// 解包RGBA8像素（R在最低字节）
+Color unpackColor(uint32_t pixel) {
+    return Color((pixel & 0xFF) / 255.0f, ((pixel >> 8) & 0xFF) / 255.0f,
+                 ((pixel >> 16) & 0xFF) / 255.0f, (pixel >> 24) / 255.0f);
+}
+
+float snap(float value) {
+    return std::floor(value * SUBPIXEL_SCALE + 0.5f) / SUBPIXEL_SCALE;
+}
+
+uint32_t toByte(float value) {
+    return static_cast<uint32_t>(std::nearbyint(clampFloat(value, 0.0f, 255.0f)));
+}
+
+// 0-255范围的通道值打包为RGBA8
+uint32_t packBytes(float r, float g, float b, float a) {
+    return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+}
+
+uint32_t packColor(const Color& color) {
+    return packBytes(clamp01(color.r) * 255.0f, clamp01(color.g) * 255.0f,
+                     clamp01(color.b) * 255.0f, clamp01(color.a) * 255.0f);
+}
+
+// 双线性采样的四个纹素坐标及权重（边缘钳制）
+struct BilinearTap {
+    int x0, y0, x1, y1;
+    float tx, ty;
+};
+
+BilinearTap computeTap(int width, int height, float u, float v) {
+    // 纹素中心位于(i+0.5)/size，NaN与越界坐标钳制到边缘
+    float fx = clampFloat(u * width - 0.5f, -1.0f, static_cast<float>(width));
+    float fy = clampFloat(v * height - 0.5f, -1.0f, static_cast<float>(height));
+    float floorX = std::floor(fx);
+    float floorY = std::floor(fy);
+
+    BilinearTap tap;
+    tap.tx = fx - floorX;
+    tap.ty = fy - floorY;
+    int x = static_cast<int>(floorX);
+    int y = static_cast<int>(floorY);
+    tap.x0 = std::min(std::max(x, 0), width - 1);
+    tap.y0 = std::min(std::max(y, 0), height - 1);
+    tap.x1 = std::min(std::max(x + 1, 0), width - 1);
+    tap.y1 = std::min(std::max(y + 1, 0), height - 1);
+    return tap;
+}
+
+// 标量双线性采样，结果为0-255范围
+void sampleBilinear(const uint32_t* pixels, int width, int height, float u, float v, float out[4]) {
+    BilinearTap tap = computeTap(width, height, u, v);
+    uint32_t c00 = pixels[tap.y0 * width + tap.x0];
+    uint32_t c10 = pixels[tap.y0 * width + tap.x1];
+    uint32_t c01 = pixels[tap.y1 * width + tap.x0];
+    uint32_t c11 = pixels[tap.y1 * width + tap.x1];
+
+    for (int channel = 0; channel < 4; ++channel) {
+        int shift = channel * 8;
+        float p00 = static_cast<float>((c00 >> shift) & 0xFF);
+        float p10 = static_cast<float>((c10 >> shift) & 0xFF);
+        float p01 = static_cast<float>((c01 >> shift) & 0xFF);
+        float p11 = static_cast<float>((c11 >> shift) & 0xFF);
+        float top = p00 + (p10 - p00) * tap.tx;
+        float bottom = p01 + (p11 - p01) * tap.tx;
+        out[channel] = top + (bottom - top) * tap.ty;
+    }
+}
+
+#ifdef APPGAME_SOFTWARE_SSE2
+
+// 覆盖掩码中的像素数量
+uint64_t countLanes(int mask) {
+    uint64_t count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+}
+
+// 单个RGBA8像素展开为4个浮点通道
+__m128 unpackPixel(uint32_t pixel) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_cvtsi32_si128(static_cast<int>(pixel));
+    __m128i words = _mm_unpacklo_epi8(bytes, zero);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+}
+
+// SIMD双线性采样：一个向量同时插值4个通道，结果为0-1范围
+__m128 sampleBilinearSSE(const uint32_t* pixels, int width, int height, float u, float v) {
+    BilinearTap tap = computeTap(width, height, u, v);
+    __m128 c00 = unpackPixel(pixels[tap.y0 * width + tap.x0]);
+    __m128 c10 = unpackPixel(pixels[tap.y0 * width + tap.x1]);
+    __m128 c01 = unpackPixel(pixels[tap.y1 * width + tap.x0]);
+    __m128 c11 = unpackPixel(pixels[tap.y1 * width + tap.x1]);
+
+    __m128 tx = _mm_set1_ps(tap.tx);
+    __m128 top = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), tx));
+    __m128 bottom = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), tx));
+    __m128 result = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(tap.ty)));
+    return _mm_mul_ps(result, _mm_set1_ps(1.0f / 255.0f));
+}
+
+#endif // APPGAME_SOFTWARE_SSE2
+
+// 用同一颜色填充一段像素
+void fillSpan(uint32_t* destination, int count, uint32_t value) {
+    int x = 0;
+#if defined(__AVX__)
+    __m256 wide = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(value)));
+    for (; x + 8 <= count; x += 8) {
+        _mm256_storeu_ps(reinterpret_cast<float*>(destination + x), wide);
+    }
+#endif
+#ifdef APPGAME_SOFTWARE_SSE2
+    __m128i packed = _mm_set1_epi32(static_cast<int>(value));
+    for (; x + 4 <= count; x += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x), packed);
+    }
+#endif
+    for (; x < count; ++x) {
+        destination[x] = value;
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SoftwareTexture
+// ---------------------------------------------------------------------------
+
+SoftwareTexture::SoftwareTexture()
+    : m_width(0)
+    , m_height(0)
+    , m_distanceFieldSpread(0.0f)
+{
+}
+
+bool SoftwareTexture::loadFromFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return loadFromMemory(data.data(), data.size());
+}
+
+bool SoftwareTexture::loadFromMemory(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (!bytes || size < 2 || bytes[0] != 'P' || bytes[1] != '6') {
+        return false;
+    }
+
+    // 解析文件头：宽、高、最大值，中间可有空白与#注释
+    size_t position = 2;
+    auto readNumber = [&](int& value) {
+        while (position < size) {
+            if (bytes[position] == '#') {
+                while (position < size && bytes[position] != '\n') {
+                    position++;
+                }
+            } else if (bytes[position] == ' ' || bytes[position] == '\t' || bytes[position] == '\r' || bytes[position] == '\n') {
+                position++;
+            } else {
+                break;
+            }
+        }
+        if (position >= size || bytes[position] < '0' || bytes[position] > '9') {
+            return false;
+        }
+        value = 0;
+        while (position < size && bytes[position] >= '0' && bytes[position] <= '9') {
+            value = value * 10 + (bytes[position] - '0');
+            if (value > MAX_IMAGE_SIZE) {
+                return false;
+            }
+            position++;
+        }
+        return true;
+    };
+
+    int width = 0;
+    int height = 0;
+    int maxValue = 0;
+    if (!readNumber(width) || !readNumber(height) || !readNumber(maxValue)) {
+        return false;
+    }
+    if (width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) {
+        return false;
+    }
+
+    // 文件头后紧跟一个空白字符
+    position++;
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    if (position > size || size - position < pixelCount * 3) {
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_pixels.resize(pixelCount);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const unsigned char* rgb = bytes + position + i * 3;
+        uint32_t r = rgb[0] * 255u / maxValue;
+        uint32_t g = rgb[1] * 255u / maxValue;
+        uint32_t b = rgb[2] * 255u / maxValue;
+        m_pixels[i] = r | (g << 8) | (b << 16) | (0xFFu << 24);
+    }
+    return true;
+}
+
+void SoftwareTexture::bind(int unit) {
+}
+
+int SoftwareTexture::getWidth() const {
+    return m_width;
+}
+
+int SoftwareTexture::getHeight() const {
+    return m_height;
+}
+
+bool SoftwareTexture::create(int width, int height, const uint32_t* pixels) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(static_cast<size_t>(width) * height, 0);
+    if (pixels) {
+        std::memcpy(m_pixels.data(), pixels, m_pixels.size() * sizeof(uint32_t));
+    }
+    return true;
+}
+
+bool SoftwareTexture::update(int x, int y, int width, int height, const uint32_t* pixels) {
+    if (!pixels || m_pixels.empty() || x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > m_width || y + height > m_height) {
+        return false;
+    }
+
+    for (int row = 0; row < height; ++row) {
+        std::memcpy(&m_pixels[static_cast<size_t>(y + row) * m_width + x], pixels + static_cast<size_t>(row) * width, width * sizeof(uint32_t));
+    }
+    return true;
+}
+
+void SoftwareTexture::setDistanceField(float spread) {
+    m_distanceFieldSpread = std::max(spread, 0.0f);
+}
+
+float SoftwareTexture::getDistanceField() const {
+    return m_distanceFieldSpread;
+}
+
+const uint32_t* SoftwareTexture::getPixels() const {
+    return m_pixels.data();
+}
+
+uint32_t* SoftwareTexture::getPixels() {
+    return m_pixels.data();
+}
+
+Color SoftwareTexture::sample(float u, float v) const {
+    if (m_pixels.empty()) {
+        return Color(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    float texel[4];
+    sampleBilinear(m_pixels.data(), m_width, m_height, u, v, texel);
+    return Color(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f);
+}
+
+// ---------------------------------------------------------------------------
+// SoftwareShader
+// ---------------------------------------------------------------------------
+
+SoftwareShader::SoftwareShader()
+    : m_compiled(false)
+{
+}
+
+bool SoftwareShader::compile(const std::string& vertexSource, const std::string& fragmentSource) {
+    // 软件管线不执行着色器代码，只检查源码是否存在
+    m_compiled = !vertexSource.empty() && !fragmentSource.empty();
+    return m_compiled;
+}
+
+void SoftwareShader::use() {
+}
+
+UniformHandle SoftwareShader::resolve(const std::string& name) {
+    auto it = m_uniformIndices.find(name);
+    if (it != m_uniformIndices.end()) {
+        return UniformHandle(it->second);
+    }
+    int index = static_cast<int>(m_uniforms.size());
+    UniformValue value = UniformValue();
+    m_uniforms.push_back(value);
+    m_uniformIndices[name] = index;
+    return UniformHandle(index);
+}
+
+UniformHandle SoftwareShader::resolveBlock(const std::string& name) {
+    auto it = m_blockIndices.find(name);
+    if (it != m_blockIndices.end()) {
+        return UniformHandle(it->second);
+    }
+    int index = static_cast<int>(m_blocks.size());
+    m_blocks.emplace_back();
+    m_blockIndices[name] = index;
+    return UniformHandle(index);
+}
+
+void SoftwareShader::setUniform1i(UniformHandle handle, int value) {
+    float converted = static_cast<float>(value);
+    storeUniform(handle, &converted, 1);
+}
+
+void SoftwareShader::setUniform1f(UniformHandle handle, float value) {
+    storeUniform(handle, &value, 1);
+}
+
+void SoftwareShader::setUniform2f(UniformHandle handle, float x, float y) {
+    float values[2] = {x, y};
+    storeUniform(handle, values, 2);
+}
+
+void SoftwareShader::setUniform3f(UniformHandle handle, float x, float y, float z) {
+    float values[3] = {x, y, z};
+    storeUniform(handle, values, 3);
+}
+
+void SoftwareShader::setUniform4f(UniformHandle handle, float x, float y, float z, float w) {
+    float values[4] = {x, y, z, w};
+    storeUniform(handle, values, 4);
+}
+
+void SoftwareShader::setUniformMatrix4f(UniformHandle handle, const float* matrix) {
+    storeUniform(handle, matrix, 16);
+}
+
+void SoftwareShader::setUniformBlock(UniformHandle handle, const void* data, size_t size) {
+    if (!handle.isValid() || handle.index >= static_cast<int>(m_blocks.size())) {
+        return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_blocks[handle.index].assign(bytes, bytes + size);
+}
+
+bool SoftwareShader::isCompiled() const {
+    return m_compiled;
+}
+
+const float* SoftwareShader::getUniform(const std::string& name) const {
+    auto it = m_uniformIndices.find(name);
+    if (it == m_uniformIndices.end() || m_uniforms[it->second].count == 0) {
+        return nullptr;
+    }
+    return m_uniforms[it->second].values;
+}
+
+const void* SoftwareShader::getUniformBlock(const std::string& name, size_t* size) const {
+    auto it = m_blockIndices.find(name);
+    if (it == m_blockIndices.end() || m_blocks[it->second].empty()) {
+        return nullptr;
+    }
+    if (size) {
+        *size = m_blocks[it->second].size();
+    }
+    return m_blocks[it->second].data();
+}
+
+void SoftwareShader::storeUniform(UniformHandle handle, const float* values, int count) {
+    if (!handle.isValid() || handle.index >= static_cast<int>(m_uniforms.size())) {
+        return;
+    }
+    UniformValue& value = m_uniforms[handle.index];
+    std::copy(values, values + count, value.values);
+    value.count = count;
+}
+
+// ---------------------------------------------------------------------------
+// SoftwareGraphicsDevice
+// ---------------------------------------------------------------------------
+
+SoftwareGraphicsDevice::SoftwareGraphicsDevice(int width, int height)
+    : m_width(std::max(width, 0))
+    , m_height(std::max(height, 0))
+    , m_viewportX(0)
+    , m_viewportY(0)
+    , m_viewportWidth(std::max(width, 0))
+    , m_viewportHeight(std::max(height, 0))
+    , m_scissorEnabled(false)
+    , m_scissor{0, 0, 0, 0}
+    , m_target(nullptr)
+    , m_savedWidth(0)
+    , m_savedHeight(0)
+    , m_tilesX(0)
+    , m_tilesY(0)
+    , m_jobSystem(nullptr)
+    , m_lastFence(0)
+    , m_signaledFence(0)
+    , m_frameLatency(0)
+{
+    m_stats = Stats();
+    m_frameStats = Stats();
+}
+
+SoftwareGraphicsDevice::~SoftwareGraphicsDevice() {
+}
+
+bool SoftwareGraphicsDevice::init() {
+    if (m_width <= 0 || m_height <= 0) {
+        return false;
+    }
+
+    m_colorBuffer.assign(static_cast<size_t>(m_width) * m_height, 0);
+    m_activeTiles.clear();
+    m_triangles.clear();
+    resizeTiles();
+    return true;
+}
+
+void SoftwareGraphicsDevice::cleanup() {
+    // 丢弃未光栅化的绘制
+    for (uint32_t tile : m_activeTiles) {
+        m_tileBins[tile].clear();
+    }
+    m_activeTiles.clear();
+    m_triangles.clear();
+}
+
+void SoftwareGraphicsDevice::swapBuffers() {
+    resolve();
+    m_stats = m_frameStats;
+    m_frameStats = Stats();
+
+    // 模拟的GPU完成一帧，围栏按插入顺序完成
+    for (auto& pending : m_pendingFences) {
+        if (pending.second > 0) {
+            pending.second--;
+        }
+    }
+    size_t signaled = 0;
+    while (signaled < m_pendingFences.size() && m_pendingFences[signaled].second == 0) {
+        m_signaledFence = std::max(m_signaledFence, m_pendingFences[signaled].first);
+        signaled++;
+    }
+    m_pendingFences.erase(m_pendingFences.begin(), m_pendingFences.begin() + signaled);
+}
+
+void SoftwareGraphicsDevice::setViewport(int x, int y, int width, int height) {
+    m_viewportX = x;
+    m_viewportY = y;
+    m_viewportWidth = std::max(width, 0);
+    m_viewportHeight = std::max(height, 0);
+}
+
+void SoftwareGraphicsDevice::getViewport(int& x, int& y, int& width, int& height) const {
+    x = m_viewportX;
+    y = m_viewportY;
+    width = m_viewportWidth;
+    height = m_viewportHeight;
+}
+
+void SoftwareGraphicsDevice::clear(const Color& color) {
+    resolve();
+    if (m_colorBuffer.empty()) {
+        return;
+    }
+
+    int x0, y0, x1, y1;
+    getClipRect(x0, y0, x1, y1);
+    uint32_t packed = packColor(color);
+    for (int y = y0; y < y1 && x0 < x1; ++y) {
+        fillSpan(&m_colorBuffer[static_cast<size_t>(y) * m_width + x0], x1 - x0, packed);
+    }
+}
+
+void SoftwareGraphicsDevice::drawIndexed(const void* vertices, const VertexFormat& format, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) {
+    if (m_colorBuffer.empty() || !vertices || !indices) {
+        return;
+    }
+    m_frameStats.drawCalls++;
+
+    // 非软件纹理和当前渲染目标无法采样，按无纹理绘制
+    const SoftwareTexture* softwareTexture = dynamic_cast<const SoftwareTexture*>(texture);
+    if (softwareTexture && (softwareTexture->getWidth() == 0 || softwareTexture == m_target)) {
+        softwareTexture = nullptr;
+    }
+
+    // 标准格式直接读取，其他格式按描述解码
+    const Vertex* standardVertices = format == VertexFormat::standard() ? static_cast<const Vertex*>(vertices) : nullptr;
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) {
+            m_frameStats.culledTriangles++;
+            continue;
+        }
+        if (standardVertices) {
+            setupTriangle(standardVertices[indices[i]], standardVertices[indices[i + 1]], standardVertices[indices[i + 2]], softwareTexture);
+        } else {
+            setupTriangle(format.decode(vertices, indices[i]), format.decode(vertices, indices[i + 1]),
+                          format.decode(vertices, indices[i + 2]), softwareTexture);
+        }
+    }
+}
+
+DeviceCapabilities SoftwareGraphicsDevice::getCapabilities() const {
+    DeviceCapabilities capabilities;
+    capabilities.instancing = true;
+    capabilities.renderTargets = true;
+    capabilities.scissor = true;
+    return capabilities;
+}
+
+bool SoftwareGraphicsDevice::setRenderTarget(Texture* texture) {
+    SoftwareTexture* target = dynamic_cast<SoftwareTexture*>(texture);
+    if ((texture && (!target || target->getWidth() == 0)) || (m_colorBuffer.empty() && !m_target)) {
+        return false;
+    }
+    if (target == m_target) {
+        return true;
+    }
+
+    // 之前的绘制属于当前目标
+    resolve();
+
+    if (m_target) {
+        m_colorBuffer.swap(m_target->m_pixels);
+        m_colorBuffer.swap(m_savedColorBuffer);
+        m_width = m_savedWidth;
+        m_height = m_savedHeight;
+        setViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+    }
+    if (target) {
+        m_savedWidth = m_width;
+        m_savedHeight = m_height;
+        getViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+        m_savedColorBuffer.swap(m_colorBuffer);
+        m_colorBuffer.swap(target->m_pixels);
+        m_width = target->getWidth();
+        m_height = target->getHeight();
+        setViewport(0, 0, m_width, m_height);
+    }
+    m_target = target;
+    resizeTiles();
+    return true;
+}
+
+void SoftwareGraphicsDevice::setScissor(bool enabled, int x, int y, int width, int height) {
+    // 已建立的三角形按建立时的裁剪区域装箱，无需先光栅化
+    m_scissorEnabled = enabled;
+    m_scissor[0] = x;
+    m_scissor[1] = y;
+    m_scissor[2] = std::max(width, 0);
+    m_scissor[3] = std::max(height, 0);
+}
+
+void SoftwareGraphicsDevice::drawInstanced(const PackedSpriteInstance* instances, size_t count, const Texture* texture) {
+    if (m_colorBuffer.empty() || !instances) {
+        return;
+    }
+    m_frameStats.drawCalls++;
+
+    const SoftwareTexture* softwareTexture = dynamic_cast<const SoftwareTexture*>(texture);
+    if (softwareTexture && (softwareTexture->getWidth() == 0 || softwareTexture == m_target)) {
+        softwareTexture = nullptr;
+    }
+
+    // 分块解包实例，用四边形内核变换单位四边形，三角形顺序与Renderer的索引一致
+    SpriteInstance sprites[INSTANCE_CHUNK];
+    float positions[INSTANCE_CHUNK * 8];
+    for (size_t start = 0; start < count; start += INSTANCE_CHUNK) {
+        size_t chunk = std::min(INSTANCE_CHUNK, count - start);
+        for (size_t i = 0; i < chunk; ++i) {
+            const PackedSpriteInstance& instance = instances[start + i];
+            SpriteInstance& sprite = sprites[i];
+            sprite.x = instance.x;
+            sprite.y = instance.y;
+            sprite.width = instance.scaleX;
+            sprite.height = instance.scaleY;
+            sprite.rotation = instance.rotation;
+        }
+        transformSprites(sprites, chunk, positions);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            const PackedSpriteInstance& instance = instances[start + i];
+            float u0 = instance.u0 / 65535.0f;
+            float v0 = instance.v0 / 65535.0f;
+            float u1 = instance.u1 / 65535.0f;
+            float v1 = instance.v1 / 65535.0f;
+            Color color = unpackColor(instance.color);
+            const float* quad = &positions[i * 8];
+            Vertex topLeft(quad[0], quad[1], 0.0f, u0, v0, color);
+            Vertex topRight(quad[2], quad[3], 0.0f, u1, v0, color);
+            Vertex bottomLeft(quad[4], quad[5], 0.0f, u0, v1, color);
+            Vertex bottomRight(quad[6], quad[7], 0.0f, u1, v1, color);
+            setupTriangle(topLeft, topRight, bottomLeft, softwareTexture);
+            setupTriangle(bottomLeft, topRight, bottomRight, softwareTexture);
+        }
+    }
+}
+
+std::unique_ptr<Shader> SoftwareGraphicsDevice::createShader() {
+    return std::make_unique<SoftwareShader>();
+}
+
+std::unique_ptr<Texture> SoftwareGraphicsDevice::createTexture() {
+    return std::make_unique<SoftwareTexture>();
+}
+
+FenceID SoftwareGraphicsDevice::insertFence() {
+    FenceID fence = ++m_lastFence;
+    if (m_frameLatency == 0) {
+        m_signaledFence = fence;
+    } else {
+        m_pendingFences.push_back(std::make_pair(fence, m_frameLatency));
+    }
+    return fence;
+}
+
+bool SoftwareGraphicsDevice::isFenceSignaled(FenceID fence) const {
+    return fence <= m_signaledFence;
+}
+
+void SoftwareGraphicsDevice::waitFence(FenceID fence) {
+    // 模拟的GPU立即追上：完成该围栏及之前的所有围栏
+    if (fence <= m_signaledFence) {
+        return;
+    }
+    resolve();
+    size_t signaled = 0;
+    while (signaled < m_pendingFences.size() && m_pendingFences[signaled].first <= fence) {
+        signaled++;
+    }
+    m_pendingFences.erase(m_pendingFences.begin(), m_pendingFences.begin() + signaled);
+    m_signaledFence = std::max(m_signaledFence, std::min(fence, m_lastFence));
+}
+
+void SoftwareGraphicsDevice::setFrameLatency(unsigned int frames) {
+    m_frameLatency = frames;
+}
+
+void SoftwareGraphicsDevice::setJobSystem(JobSystem* jobSystem) {
+    m_jobSystem = jobSystem;
+}
+
+void SoftwareGraphicsDevice::resolve() {
+    if (m_triangles.empty()) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 分块互不重叠，可以无锁并行；块内按提交顺序绘制
+    if (m_jobSystem && m_jobSystem->isRunning() && m_activeTiles.size() > 1) {
+        JobHandle handle = m_jobSystem->parallelFor(m_activeTiles.size(), 1, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                rasterizeTile(m_activeTiles[i]);
+            }
+        });
+        m_jobSystem->wait(handle);
+    } else {
+        for (uint32_t tile : m_activeTiles) {
+            rasterizeTile(tile);
+        }
+    }
+
+    for (uint32_t tile : m_activeTiles) {
+        m_frameStats.pixels += m_tilePixels[tile];
+        m_tilePixels[tile] = 0;
+        m_tileBins[tile].clear();
+    }
+    m_frameStats.tileJobs += m_activeTiles.size();
+    m_frameStats.triangles += m_triangles.size();
+    m_activeTiles.clear();
+    m_triangles.clear();
+
+    auto endTime = std::chrono::steady_clock::now();
+    m_frameStats.rasterTime += std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+int SoftwareGraphicsDevice::getWidth() const {
+    return m_width;
+}
+
+int SoftwareGraphicsDevice::getHeight() const {
+    return m_height;
+}
+
+const uint32_t* SoftwareGraphicsDevice::getPixels() const {
+    return m_colorBuffer.data();
+}
+
+Color SoftwareGraphicsDevice::getPixel(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height || m_colorBuffer.empty()) {
+        return Color(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    return unpackColor(m_colorBuffer[static_cast<size_t>(y) * m_width + x]);
+}
+
+uint64_t SoftwareGraphicsDevice::getFramebufferHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t pixel : m_colorBuffer) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (pixel >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+bool SoftwareGraphicsDevice::saveToFile(const std::string& filePath) const {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file || m_colorBuffer.empty()) {
+        return false;
+    }
+
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+    std::vector<unsigned char> rgb(m_colorBuffer.size() * 3);
+    for (size_t i = 0; i < m_colorBuffer.size(); ++i) {
+        rgb[i * 3] = static_cast<unsigned char>(m_colorBuffer[i] & 0xFF);
+        rgb[i * 3 + 1] = static_cast<unsigned char>((m_colorBuffer[i] >> 8) & 0xFF);
+        rgb[i * 3 + 2] = static_cast<unsigned char>((m_colorBuffer[i] >> 16) & 0xFF);
+    }
+    file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+    return static_cast<bool>(file);
+}
+
+const SoftwareGraphicsDevice::Stats& SoftwareGraphicsDevice::getStats() const {
+    return m_stats;
+}
+
+void SoftwareGraphicsDevice::resizeTiles() {
+    m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+    m_tileBins.assign(static_cast<size_t>(m_tilesX) * m_tilesY, std::vector<uint32_t>());
+    m_tilePixels.assign(m_tileBins.size(), 0);
+}
+
+void SoftwareGraphicsDevice::getClipRect(int& x0, int& y0, int& x1, int& y1) const {
+    x0 = std::max(m_viewportX, 0);
+    y0 = std::max(m_viewportY, 0);
+    x1 = std::min(m_viewportX + m_viewportWidth, m_width);
+    y1 = std::min(m_viewportY + m_viewportHeight, m_height);
+    if (m_scissorEnabled) {
+        x0 = std::max(x0, m_viewportX + m_scissor[0]);
+        y0 = std::max(y0, m_viewportY + m_scissor[1]);
+        x1 = std::min(x1, m_viewportX + m_scissor[0] + m_scissor[2]);
+        y1 = std::min(y1, m_viewportY + m_scissor[1] + m_scissor[3]);
+    }
+}
+
+void SoftwareGraphicsDevice::setupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const SoftwareTexture* texture) {
+    const Vertex* source[3] = {&v0, &v1, &v2};
+    float x[3], y[3];
+    for (int i = 0; i < 3; ++i) {
+        x[i] = snap(source[i]->x + m_viewportX);
+        y[i] = snap(source[i]->y + m_viewportY);
+    }
+
+    // 统一为正面积（屏幕坐标y向下），2D渲染不做背面剔除
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (!(std::fabs(area) > 0.0f)) {
+        m_frameStats.culledTriangles++;
+        return;
+    }
+    if (area < 0.0f) {
+        std::swap(source[1], source[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        area = -area;
+    }
+
+    // 包围盒裁剪到视口、裁剪矩形与帧缓冲区
+    int clip[4];
+    getClipRect(clip[0], clip[1], clip[2], clip[3]);
+    float clipX0 = static_cast<float>(clip[0]);
+    float clipY0 = static_cast<float>(clip[1]);
+    float clipX1 = static_cast<float>(std::max(clip[2], clip[0]));
+    float clipY1 = static_cast<float>(std::max(clip[3], clip[1]));
+
+    Triangle triangle;
+    triangle.minX = static_cast<int>(std::floor(clampFloat(std::min({x[0], x[1], x[2]}), clipX0, clipX1)));
+    triangle.minY = static_cast<int>(std::floor(clampFloat(std::min({y[0], y[1], y[2]}), clipY0, clipY1)));
+    triangle.maxX = static_cast<int>(std::ceil(clampFloat(std::max({x[0], x[1], x[2]}), clipX0, clipX1)));
+    triangle.maxY = static_cast<int>(std::ceil(clampFloat(std::max({y[0], y[1], y[2]}), clipY0, clipY1)));
+    if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY) {
+        m_frameStats.culledTriangles++;
+        return;
+    }
+
+    // 边i与顶点i相对，w_i/面积即顶点i的重心坐标
+    for (int i = 0; i < 3; ++i) {
+        int a = (i + 1) % 3;
+        int b = (i + 2) % 3;
+        float edgeA = y[a] - y[b];
+        float edgeB = x[b] - x[a];
+        triangle.edgeA[i] = edgeA;
+        triangle.edgeB[i] = edgeB;
+
+        // 参考点取两端点中较小者，反向的共享边使用同一参考点
+        bool aFirst = y[a] < y[b] || (y[a] == y[b] && x[a] < x[b]);
+        triangle.edgeX[i] = aFirst ? x[a] : x[b];
+        triangle.edgeY[i] = aFirst ? y[a] : y[b];
+
+        // 内部在边的右侧为左边，水平边且内部在下方为上边
+        triangle.topLeft[i] = edgeA > 0.0f || (edgeA == 0.0f && edgeB > 0.0f);
+    }
+    triangle.invArea = 1.0f / area;
+
+    for (int i = 0; i < 3; ++i) {
+        triangle.u[i] = source[i]->u;
+        triangle.v[i] = source[i]->v;
+        triangle.r[i] = clamp01(source[i]->color.r);
+        triangle.g[i] = clamp01(source[i]->color.g);
+        triangle.b[i] = clamp01(source[i]->color.b);
+        triangle.a[i] = clamp01(source[i]->color.a);
+    }
+    triangle.texture = texture;
+
+    // 距离场：由UV梯度得到每个像素跨越的纹素数，把以纹素计的距离换算为像素
+    triangle.distanceScale = 0.0f;
+    if (texture && texture->getDistanceField() > 0.0f) {
+        float dudx = 0.0f, dudy = 0.0f, dvdx = 0.0f, dvdy = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            dudx += triangle.edgeA[i] * source[i]->u;
+            dudy += triangle.edgeB[i] * source[i]->u;
+            dvdx += triangle.edgeA[i] * source[i]->v;
+            dvdy += triangle.edgeB[i] * source[i]->v;
+        }
+        float width = static_cast<float>(texture->getWidth()) * triangle.invArea;
+        float height = static_cast<float>(texture->getHeight()) * triangle.invArea;
+        dudx *= width;
+        dudy *= width;
+        dvdx *= height;
+        dvdy *= height;
+        float texelsPerPixel = std::sqrt(std::max(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy));
+        triangle.distanceScale = 2.0f * texture->getDistanceField() / std::max(texelsPerPixel, 1e-6f);
+    }
+
+    const Color& color = source[0]->color;
+    triangle.flat = !texture && triangle.a[0] >= 1.0f;
+    for (int i = 1; i < 3 && triangle.flat; ++i) {
+        const Color& other = source[i]->color;
+        triangle.flat = other.r == color.r && other.g == color.g && other.b == color.b && other.a == color.a;
+    }
+    triangle.flatColor = packColor(color);
+
+    // 装箱到覆盖的分块
+    uint32_t index = static_cast<uint32_t>(m_triangles.size());
+    m_triangles.push_back(triangle);
+
+    int tileX0 = triangle.minX / TILE_SIZE;
+    int tileY0 = triangle.minY / TILE_SIZE;
+    int tileX1 = (triangle.maxX - 1) / TILE_SIZE;
+    int tileY1 = (triangle.maxY - 1) / TILE_SIZE;
+    for (int tileY = tileY0; tileY <= tileY1; ++tileY) {
+        for (int tileX = tileX0; tileX <= tileX1; ++tileX) {
+            uint32_t tile = static_cast<uint32_t>(tileY * m_tilesX + tileX);
+            if (m_tileBins[tile].empty()) {
+                m_activeTiles.push_back(tile);
+            }
+            m_tileBins[tile].push_back(index);
+        }
+    }
+}
+
+void SoftwareGraphicsDevice::rasterizeTile(size_t tileIndex) {
+    int tileX0 = static_cast<int>(tileIndex % m_tilesX) * TILE_SIZE;
+    int tileY0 = static_cast<int>(tileIndex / m_tilesX) * TILE_SIZE;
+    int tileX1 = std::min(tileX0 + TILE_SIZE, m_width);
+    int tileY1 = std::min(tileY0 + TILE_SIZE, m_height);
+
+    uint64_t pixels = 0;
+    for (uint32_t index : m_tileBins[tileIndex]) {
+        const Triangle& triangle = m_triangles[index];
+        rasterizeTriangle(triangle,
+                          std::max(triangle.minX, tileX0), std::max(triangle.minY, tileY0),
+                          std::min(triangle.maxX, tileX1), std::min(triangle.maxY, tileY1),
+                          pixels);
+    }
+    m_tilePixels[tileIndex] = pixels;
+}
+
+void SoftwareGraphicsDevice::rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1, int y1, uint64_t& pixels) {
+    const SoftwareTexture* texture = triangle.texture;
+
+    for (int y = y0; y < y1; ++y) {
+        float py = static_cast<float>(y) + 0.5f;
+        float rowTerm[3];
+        for (int i = 0; i < 3; ++i) {
+            rowTerm[i] = triangle.edgeB[i] * (py - triangle.edgeY[i]);
+        }
+        uint32_t* row = &m_colorBuffer[static_cast<size_t>(y) * m_width];
+        int x = x0;
+
+#if defined(__AVX__)
+        // 纯色三角形：8像素一组计算覆盖并掩码写入
+        if (triangle.flat) {
+            const __m256 laneOffset = _mm256_set_ps(7.5f, 6.5f, 5.5f, 4.5f, 3.5f, 2.5f, 1.5f, 0.5f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 limit = _mm256_set1_ps(static_cast<float>(x1));
+            const __m256 color = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(triangle.flatColor)));
+            for (; x < x1; x += 8) {
+                __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), laneOffset);
+                __m256 inside = _mm256_cmp_ps(px, limit, _CMP_LT_OQ);
+                for (int i = 0; i < 3; ++i) {
+                    __m256 w = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(triangle.edgeA[i]),
+                                                           _mm256_sub_ps(px, _mm256_set1_ps(triangle.edgeX[i]))),
+                                             _mm256_set1_ps(rowTerm[i]));
+                    __m256 cover = triangle.topLeft[i] ? _mm256_cmp_ps(w, zero, _CMP_GE_OQ) : _mm256_cmp_ps(w, zero, _CMP_GT_OQ);
+                    inside = _mm256_and_ps(inside, cover);
+                }
+                int mask = _mm256_movemask_ps(inside);
+                if (mask == 0) {
+                    continue;
+                }
+                // 掩码为0的通道不会访问内存，行尾无需特殊处理
+                _mm256_maskstore_ps(reinterpret_cast<float*>(row + x), _mm256_castps_si256(inside), color);
+                pixels += countLanes(mask);
+            }
+            continue;
+        }
+#endif
+
+#ifdef APPGAME_SOFTWARE_SSE2
+        const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 limit = _mm_set1_ps(static_cast<float>(x1));
+        const __m128 invArea = _mm_set1_ps(triangle.invArea);
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+        for (; x < x1; x += 4) {
+            __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+            __m128 inside = _mm_cmplt_ps(px, limit);
+            __m128 w[3];
+            for (int i = 0; i < 3; ++i) {
+                w[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[i]), _mm_sub_ps(px, _mm_set1_ps(triangle.edgeX[i]))),
+                                  _mm_set1_ps(rowTerm[i]));
+                __m128 cover = triangle.topLeft[i] ? _mm_cmpge_ps(w[i], zero) : _mm_cmpgt_ps(w[i], zero);
+                inside = _mm_and_ps(inside, cover);
+            }
+            int mask = _mm_movemask_ps(inside);
+            if (mask == 0) {
+                continue;
+            }
+
+            // 分块右边界前不足4个像素时在临时缓冲区中读改写，不能写到相邻分块（可能正由其他线程绘制）
+            uint32_t spill[4];
+            uint32_t* target = row + x;
+            int valid = std::min(4, x1 - x);
+            if (valid < 4) {
+                std::memcpy(spill, target, valid * sizeof(uint32_t));
+                target = spill;
+            }
+
+            __m128i maskBits = _mm_castps_si128(inside);
+            __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target));
+            __m128i result;
+
+            if (triangle.flat) {
+                __m128i color = _mm_set1_epi32(static_cast<int>(triangle.flatColor));
+                result = _mm_or_si128(_mm_and_si128(maskBits, color), _mm_andnot_si128(maskBits, destination));
+            } else {
+                // 重心坐标插值顶点属性
+                __m128 l0 = _mm_mul_ps(w[0], invArea);
+                __m128 l1 = _mm_mul_ps(w[1], invArea);
+                __m128 l2 = _mm_mul_ps(w[2], invArea);
+                auto interpolate = [&](const float* attribute) {
+                    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, _mm_set1_ps(attribute[0])),
+                                                 _mm_mul_ps(l1, _mm_set1_ps(attribute[1]))),
+                                      _mm_mul_ps(l2, _mm_set1_ps(attribute[2])));
+                };
+                __m128 sr = interpolate(triangle.r);
+                __m128 sg = interpolate(triangle.g);
+                __m128 sb = interpolate(triangle.b);
+                __m128 sa = interpolate(triangle.a);
+
+                if (texture) {
+                    alignas(16) float us[4];
+                    alignas(16) float vs[4];
+                    _mm_store_ps(us, interpolate(triangle.u));
+                    _mm_store_ps(vs, interpolate(triangle.v));
+                    __m128 texel[4];
+                    for (int lane = 0; lane < 4; ++lane) {
+                        texel[lane] = (mask & (1 << lane))
+                            ? sampleBilinearSSE(texture->getPixels(), texture->getWidth(), texture->getHeight(), us[lane], vs[lane])
+                            : zero;
+                    }
+                    // 每像素RGBA转置为每通道4像素
+                    _MM_TRANSPOSE4_PS(texel[0], texel[1], texel[2], texel[3]);
+                    if (triangle.distanceScale > 0.0f) {
+                        __m128 half = _mm_set1_ps(0.5f);
+                        __m128 coverage = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(texel[3], half), _mm_set1_ps(triangle.distanceScale)), half);
+                        texel[3] = _mm_min_ps(_mm_max_ps(coverage, zero), one);
+                    }
+                    sr = _mm_mul_ps(sr, texel[0]);
+                    sg = _mm_mul_ps(sg, texel[1]);
+                    sb = _mm_mul_ps(sb, texel[2]);
+                    sa = _mm_mul_ps(sa, texel[3]);
+                }
+
+                sr = _mm_min_ps(_mm_max_ps(sr, zero), one);
+                sg = _mm_min_ps(_mm_max_ps(sg, zero), one);
+                sb = _mm_min_ps(_mm_max_ps(sb, zero), one);
+                sa = _mm_min_ps(_mm_max_ps(sa, zero), one);
+
+                // 源alpha混合：out = src*a + dst*(1-a)
+                __m128 dr = _mm_cvtepi32_ps(_mm_and_si128(destination, byteMask));
+                __m128 dg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(destination, 8), byteMask));
+                __m128 db = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(destination, 16), byteMask));
+                __m128 da = _mm_cvtepi32_ps(_mm_srli_epi32(destination, 24));
+                __m128 inverseAlpha = _mm_sub_ps(one, sa);
+                __m128 alphaScale = _mm_mul_ps(sa, scale);
+
+                __m128i outR = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(sr, alphaScale), _mm_mul_ps(dr, inverseAlpha)));
+                __m128i outG = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(sg, alphaScale), _mm_mul_ps(dg, inverseAlpha)));
+                __m128i outB = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(sb, alphaScale), _mm_mul_ps(db, inverseAlpha)));
+                __m128i outA = _mm_cvtps_epi32(_mm_add_ps(alphaScale, _mm_mul_ps(da, inverseAlpha)));
+
+                __m128i packed = _mm_or_si128(_mm_or_si128(outR, _mm_slli_epi32(outG, 8)),
+                                              _mm_or_si128(_mm_slli_epi32(outB, 16), _mm_slli_epi32(outA, 24)));
+                result = _mm_or_si128(_mm_and_si128(maskBits, packed), _mm_andnot_si128(maskBits, destination));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(target), result);
+            if (target == spill) {
+                std::memcpy(row + x, spill, valid * sizeof(uint32_t));
+            }
+            pixels += countLanes(mask);
+        }
+#else
+        // 标量实现（非x86平台）
+        for (; x < x1; ++x) {
+            float px = static_cast<float>(x) + 0.5f;
+            float w[3];
+            bool covered = true;
+            for (int i = 0; i < 3; ++i) {
+                w[i] = triangle.edgeA[i] * (px - triangle.edgeX[i]) + rowTerm[i];
+                covered = covered && (triangle.topLeft[i] ? w[i] >= 0.0f : w[i] > 0.0f);
+            }
+            if (!covered) {
+                continue;
+            }
+
+            pixels++;
+            if (triangle.flat) {
+                row[x] = triangle.flatColor;
+                continue;
+            }
+
+            float l0 = w[0] * triangle.invArea;
+            float l1 = w[1] * triangle.invArea;
+            float l2 = w[2] * triangle.invArea;
+            auto interpolate = [&](const float* attribute) {
+                return l0 * attribute[0] + l1 * attribute[1] + l2 * attribute[2];
+            };
+            float source[4] = {interpolate(triangle.r), interpolate(triangle.g), interpolate(triangle.b), interpolate(triangle.a)};
+            if (texture) {
+                float texel[4];
+                sampleBilinear(texture->getPixels(), texture->getWidth(), texture->getHeight(),
+                               interpolate(triangle.u), interpolate(triangle.v), texel);
+                if (triangle.distanceScale > 0.0f) {
+                    texel[3] = clamp01((texel[3] / 255.0f - 0.5f) * triangle.distanceScale + 0.5f) * 255.0f;
+                }
+                for (int channel = 0; channel < 4; ++channel) {
+                    source[channel] *= texel[channel] / 255.0f;
+                }
+            }
+            for (int channel = 0; channel < 4; ++channel) {
+                source[channel] = clamp01(source[channel]);
+            }
+
+            uint32_t destination = row[x];
+            float inverseAlpha = 1.0f - source[3];
+            float alphaScale = source[3] * 255.0f;
+            row[x] = packBytes(source[0] * alphaScale + (destination & 0xFF) * inverseAlpha,
+                               source[1] * alphaScale + ((destination >> 8) & 0xFF) * inverseAlpha,
+                               source[2] * alphaScale + ((destination >> 16) & 0xFF) * inverseAlpha,
+                               alphaScale + (destination >> 24) * inverseAlpha);
+        }
+#endif
+    }
+}
+
+} // namespace Appgame
@@ -0,0 +1,108 @@
+#include "core/StreamBuffer.h"
+#include <chrono>
+#include <cstring>
+
+namespace Appgame {
+
+StreamBuffer::StreamBuffer(GraphicsDevice* device, size_t capacity, unsigned int framesInFlight)
+    : m_device(device)
+    , m_storage(capacity)
+    , m_maxFramesInFlight(framesInFlight > 0 ? framesInFlight : 1)
+    , m_head(0)
+    , m_used(0)
+    , m_frameBytes(0)
+{
+    m_stats = Stats();
+}
+
+void* StreamBuffer::allocate(size_t size, size_t alignment, size_t& offset) {
+    size_t capacity = m_storage.size();
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    // 对齐；尾部放不下时跳过剩余部分，从开头继续
+    size_t start = (m_head + alignment - 1) / alignment * alignment;
+    bool wrapped = false;
+    if (start + size > capacity) {
+        start = 0;
+        wrapped = true;
+    }
+    size_t needed = (wrapped ? capacity - m_head : start - m_head) + size;
+    if (needed + m_frameBytes > capacity) {
+        m_stats.overflows++;
+        return nullptr;
+    }
+
+    retire(false);
+    while (m_used + needed > capacity) {
+        retire(true);
+    }
+    if (wrapped) {
+        m_stats.wraps++;
+    }
+
+    m_used += needed;
+    m_frameBytes += needed;
+    m_head = start + size;
+    m_stats.bytesWritten += needed;
+    m_stats.allocations++;
+    offset = start;
+    return &m_storage[start];
+}
+
+const void* StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+    size_t offset = 0;
+    void* destination = allocate(size, alignment, offset);
+    if (destination) {
+        std::memcpy(destination, data, size);
+    }
+    return destination;
+}
+
+void StreamBuffer::endFrame() {
+    if (m_frameBytes > 0) {
+        InFlightFrame frame;
+        frame.fence = m_device ? m_device->insertFence() : 0;
+        frame.bytes = m_frameBytes;
+        m_frames.push_back(frame);
+        m_frameBytes = 0;
+    }
+
+    retire(false);
+    while (m_frames.size() > m_maxFramesInFlight) {
+        retire(true);
+    }
+    m_stats.framesInFlight = static_cast<unsigned int>(m_frames.size());
+}
+
+const uint8_t* StreamBuffer::getData() const {
+    return m_storage.data();
+}
+
+size_t StreamBuffer::getCapacity() const {
+    return m_storage.size();
+}
+
+const StreamBuffer::Stats& StreamBuffer::getStats() const {
+    return m_stats;
+}
+
+void StreamBuffer::retire(bool wait) {
+    if (wait && !m_frames.empty() && m_device && !m_device->isFenceSignaled(m_frames.front().fence)) {
+        auto startTime = std::chrono::steady_clock::now();
+        m_device->waitFence(m_frames.front().fence);
+        auto endTime = std::chrono::steady_clock::now();
+        m_stats.stalls++;
+        m_stats.stallTime += std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    }
+
+    // 等待返回后最早的一帧视为已完成
+    while (!m_frames.empty() && (!m_device || m_device->isFenceSignaled(m_frames.front().fence) || wait)) {
+        m_used -= m_frames.front().bytes;
+        m_frames.pop_front();
+        wait = false;
+    }
+}
+
+} // namespace Appgame
@@ -0,0 +1,191 @@
+#include "core/SystemScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Appgame {
+
+namespace {
+
+// 黄金分割比例的小数部分，用于错开各系统的初始相位
+const float PHASE_STEP = 0.618034f;
+
+} // namespace
+
+SystemScheduler::SystemScheduler()
+    : m_nextId(0)
+    , m_maxTicksPerUpdate(4)
+    , m_lastUpdateTime(0.0f)
+{
+}
+
+SystemScheduler::~SystemScheduler() {
+}
+
+SystemScheduler::SystemID SystemScheduler::addSystem(const std::string& name, float rate, std::function<void(float)> update, float budget) {
+    SystemEntry entry;
+    entry.id = m_nextId++;
+    entry.name = name;
+    entry.rate = std::max(rate, 0.0f);
+    entry.period = entry.rate > 0.0f ? 1.0f / entry.rate : 0.0f;
+    entry.budget = budget;
+    entry.enabled = true;
+    entry.update = update;
+    entry.ticks = 0;
+    entry.totalTime = 0.0;
+    entry.simulatedTime = 0.0;
+    entry.lastTickTime = 0.0f;
+    entry.maxTickTime = 0.0f;
+    entry.overBudgetTicks = 0;
+
+    // 错开初始相位，避免同频率的系统在同一帧集中更新
+    float phase = std::fmod(static_cast<float>(entry.id) * PHASE_STEP, 1.0f);
+    entry.accumulator = entry.period * phase;
+
+    m_systems.push_back(entry);
+    return entry.id;
+}
+
+void SystemScheduler::removeSystem(SystemID id) {
+    m_systems.erase(std::remove_if(m_systems.begin(), m_systems.end(),
+        [id](const SystemEntry& entry) { return entry.id == id; }), m_systems.end());
+}
+
+void SystemScheduler::setRate(SystemID id, float rate) {
+    SystemEntry* entry = findSystem(id);
+    if (!entry) {
+        return;
+    }
+
+    entry->rate = std::max(rate, 0.0f);
+    entry->period = entry->rate > 0.0f ? 1.0f / entry->rate : 0.0f;
+    if (entry->period > 0.0f) {
+        entry->accumulator = std::min(entry->accumulator, entry->period);
+    }
+}
+
+float SystemScheduler::getRate(SystemID id) const {
+    const SystemEntry* entry = findSystem(id);
+    return entry ? entry->rate : 0.0f;
+}
+
+void SystemScheduler::setEnabled(SystemID id, bool enabled) {
+    SystemEntry* entry = findSystem(id);
+    if (entry) {
+        entry->enabled = enabled;
+    }
+}
+
+void SystemScheduler::setMaxTicksPerUpdate(int maxTicks) {
+    m_maxTicksPerUpdate = std::max(maxTicks, 1);
+}
+
+void SystemScheduler::update(float deltaTime) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& entry : m_systems) {
+        if (!entry.enabled || !entry.update) {
+            continue;
+        }
+
+        // 每帧更新的系统直接使用帧deltaTime
+        if (entry.period <= 0.0f) {
+            tick(entry, deltaTime);
+            continue;
+        }
+
+        entry.accumulator += deltaTime;
+        int ticks = 0;
+        while (entry.accumulator >= entry.period && ticks < m_maxTicksPerUpdate) {
+            tick(entry, entry.period);
+            entry.accumulator -= entry.period;
+            ticks++;
+        }
+
+        // 补偿次数达到上限时丢弃整周期的积压，只保留相位
+        if (entry.accumulator >= entry.period) {
+            entry.accumulator = std::fmod(entry.accumulator, entry.period);
+        }
+    }
+
+    m_lastUpdateTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+SystemScheduler::SystemStats SystemScheduler::getSystemStats(SystemID id) const {
+    SystemStats stats = SystemStats();
+    const SystemEntry* entry = findSystem(id);
+    if (!entry) {
+        return stats;
+    }
+
+    stats.name = entry->name;
+    stats.rate = entry->rate;
+    stats.ticks = entry->ticks;
+    stats.lastTickTime = entry->lastTickTime;
+    stats.avgTickTime = entry->ticks > 0 ? static_cast<float>(entry->totalTime / static_cast<double>(entry->ticks)) : 0.0f;
+    stats.maxTickTime = entry->maxTickTime;
+    stats.budget = entry->budget;
+    stats.budgetUsage = entry->budget > 0.0f ? stats.avgTickTime / entry->budget : 0.0f;
+    stats.overBudgetTicks = entry->overBudgetTicks;
+    stats.msPerSecond = entry->simulatedTime > 0.0 ? static_cast<float>(entry->totalTime / entry->simulatedTime) : 0.0f;
+    return stats;
+}
+
+std::vector<SystemScheduler::SystemStats> SystemScheduler::getAllStats() const {
+    std::vector<SystemStats> allStats;
+    allStats.reserve(m_systems.size());
+    for (const auto& entry : m_systems) {
+        allStats.push_back(getSystemStats(entry.id));
+    }
+    return allStats;
+}
+
+float SystemScheduler::getLastUpdateTime() const {
+    return m_lastUpdateTime;
+}
+
+void SystemScheduler::resetStats() {
+    for (auto& entry : m_systems) {
+        entry.ticks = 0;
+        entry.totalTime = 0.0;
+        entry.simulatedTime = 0.0;
+        entry.lastTickTime = 0.0f;
+        entry.maxTickTime = 0.0f;
+        entry.overBudgetTicks = 0;
+    }
+}
+
+void SystemScheduler::tick(SystemEntry& entry, float deltaTime) {
+    auto start = std::chrono::steady_clock::now();
+    entry.update(deltaTime);
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    entry.ticks++;
+    entry.totalTime += elapsed;
+    entry.simulatedTime += deltaTime;
+    entry.lastTickTime = elapsed;
+    entry.maxTickTime = std::max(entry.maxTickTime, elapsed);
+    if (entry.budget > 0.0f && elapsed > entry.budget) {
+        entry.overBudgetTicks++;
+    }
+}
+
+SystemScheduler::SystemEntry* SystemScheduler::findSystem(SystemID id) {
+    for (auto& entry : m_systems) {
+        if (entry.id == id) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const SystemScheduler::SystemEntry* SystemScheduler::findSystem(SystemID id) const {
+    for (const auto& entry : m_systems) {
+        if (entry.id == id) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace Appgame
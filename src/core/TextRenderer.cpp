@@ -0,0 +1,201 @@
+#include "core/TextRenderer.h"
+#include <algorithm>
+
+namespace Appgame {
+
+namespace {
+
+// 缺少字形且没有替代字形时的前进量（字号的比例）
+const float MISSING_ADVANCE = 0.5f;
+
+// FNV-1a
+const uint64_t HASH_OFFSET = 14695981039346656037ull;
+const uint64_t HASH_PRIME = 1099511628211ull;
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+    }
+    return hash;
+}
+
+uint64_t hashRun(const std::string& text, const SdfFont* font, float size) {
+    uint64_t hash = hashBytes(HASH_OFFSET, text.data(), text.size());
+    hash = hashBytes(hash, &font, sizeof(font));
+    return hashBytes(hash, &size, sizeof(size));
+}
+
+} // namespace
+
+TextRenderer::TextRenderer(size_t maxRuns)
+    : m_maxRuns(maxRuns > 0 ? maxRuns : 1) {
+    m_stats = Stats();
+}
+
+TextRenderer::~TextRenderer() {
+}
+
+void TextRenderer::drawText(Renderer& renderer, SdfFont& font, const std::string& text, float x, float y, float size, const Color& color) {
+    if (text.empty() || size <= 0.0f) {
+        return;
+    }
+
+    const GlyphRun& run = getRun(font, text, size);
+    for (const PageRange& range : run.pages) {
+        const Texture* texture = font.getAtlas().getPage(range.page);
+        if (!texture) {
+            continue;
+        }
+        m_scratch.assign(run.instances.begin() + range.first, run.instances.begin() + range.first + range.count);
+        for (SpriteInstance& instance : m_scratch) {
+            instance.x += x;
+            instance.y += y;
+            instance.color = color;
+        }
+        renderer.drawSprites(*texture, m_scratch.data(), m_scratch.size());
+    }
+}
+
+void TextRenderer::measureText(SdfFont& font, const std::string& text, float size, float& width, float& height) {
+    if (text.empty() || size <= 0.0f) {
+        width = 0.0f;
+        height = 0.0f;
+        return;
+    }
+
+    const GlyphRun& run = getRun(font, text, size);
+    width = run.width;
+    height = run.height;
+}
+
+void TextRenderer::clear() {
+    m_runs.clear();
+    m_index.clear();
+    m_stats.runs = 0;
+}
+
+const TextRenderer::Stats& TextRenderer::getStats() const {
+    return m_stats;
+}
+
+const TextRenderer::GlyphRun& TextRenderer::getRun(SdfFont& font, const std::string& text, float size) {
+    uint64_t key = hashRun(text, &font, size);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_runs.splice(m_runs.begin(), m_runs, it->second);
+        GlyphRun& run = m_runs.front();
+        if (run.font == &font && run.size == size && run.generation == font.getGeneration() && run.text == text) {
+            m_stats.hits++;
+            return run;
+        }
+
+        // 图集重新装箱后UV失效，或者哈希冲突：原地重新排版
+        run.text = text;
+        run.font = &font;
+        run.size = size;
+        layout(font, run);
+        m_stats.misses++;
+        return run;
+    }
+
+    m_runs.emplace_front();
+    GlyphRun& run = m_runs.front();
+    run.text = text;
+    run.font = &font;
+    run.size = size;
+    run.key = key;
+    m_index[key] = m_runs.begin();
+    layout(font, run);
+    m_stats.misses++;
+
+    while (m_runs.size() > m_maxRuns) {
+        m_index.erase(m_runs.back().key);
+        m_runs.pop_back();
+        m_stats.evictions++;
+    }
+    m_stats.runs = m_runs.size();
+    return run;
+}
+
+void TextRenderer::layout(SdfFont& font, GlyphRun& run) {
+    decodeUtf8(run.text, m_codepoints);
+
+    // 先取得所有字形：按需生成可能新建图集页面，之后再读取区域的页面和UV
+    std::vector<const SdfFont::Glyph*> glyphs(m_codepoints.size(), nullptr);
+    for (size_t i = 0; i < m_codepoints.size(); ++i) {
+        if (m_codepoints[i] != '\n' && m_codepoints[i] != '\r') {
+            glyphs[i] = font.getGlyph(m_codepoints[i]);
+        }
+    }
+
+    float scale = run.size / static_cast<float>(font.getBaseSize());
+    float lineHeight = font.getLineHeight() * scale;
+    float penX = 0.0f;
+    float baseline = font.getAscent() * scale;
+    int lines = 1;
+
+    std::vector<const AtlasRegion*> regions;
+    std::vector<SpriteInstance> instances;
+    run.width = 0.0f;
+    for (size_t i = 0; i < m_codepoints.size(); ++i) {
+        if (m_codepoints[i] == '\n') {
+            run.width = std::max(run.width, penX);
+            penX = 0.0f;
+            baseline += lineHeight;
+            lines++;
+            continue;
+        }
+        const SdfFont::Glyph* glyph = glyphs[i];
+        if (!glyph) {
+            if (m_codepoints[i] != '\r') {
+                penX += run.size * MISSING_ADVANCE;
+            }
+            continue;
+        }
+
+        if (glyph->region) {
+            SpriteInstance instance;
+            instance.width = glyph->width * scale;
+            instance.height = glyph->height * scale;
+            instance.x = penX + glyph->left * scale + instance.width * 0.5f;
+            instance.y = baseline + glyph->top * scale + instance.height * 0.5f;
+            instance.rotation = 0.0f;
+            instance.u0 = instance.v0 = instance.u1 = instance.v1 = 0.0f;
+            instance.color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+            regions.push_back(glyph->region);
+            instances.push_back(instance);
+        }
+        penX += glyph->advance * scale;
+    }
+    run.width = std::max(run.width, penX);
+    run.height = lineHeight * static_cast<float>(lines);
+
+    // 按页面分组（组内保持书写顺序），每页一次drawSprites
+    std::vector<size_t> order(instances.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&regions](size_t a, size_t b) {
+        return regions[a]->page < regions[b]->page;
+    });
+
+    run.instances.clear();
+    run.pages.clear();
+    for (size_t index : order) {
+        const AtlasRegion* region = regions[index];
+        SpriteInstance instance = instances[index];
+        instance.u0 = region->uvRect.x;
+        instance.v0 = region->uvRect.y;
+        instance.u1 = region->uvRect.x + region->uvRect.width;
+        instance.v1 = region->uvRect.y + region->uvRect.height;
+        if (run.pages.empty() || run.pages.back().page != region->page) {
+            run.pages.push_back({region->page, run.instances.size(), 0});
+        }
+        run.pages.back().count++;
+        run.instances.push_back(instance);
+    }
+    run.generation = font.getGeneration();
+}
+
+} // namespace Appgame
@@ -0,0 +1,414 @@
+#include "core/TextureAtlas.h"
+#include <algorithm>
+#include <climits>
+
+namespace Appgame {
+
+namespace {
+
+// 默认碎片率阈值
+const float DEFAULT_REPACK_THRESHOLD = 0.5f;
+
+bool intersects(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool contains(const AtlasRect& outer, const AtlasRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+}
+
+size_t area(const AtlasRect& rect) {
+    return static_cast<size_t>(rect.width) * rect.height;
+}
+
+} // namespace
+
+MaxRectsPacker::MaxRectsPacker(int width, int height) {
+    reset(width, height);
+}
+
+void MaxRectsPacker::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_usedArea = 0;
+    m_freeRects.clear();
+    if (width > 0 && height > 0) {
+        m_freeRects.push_back({0, 0, width, height});
+    }
+}
+
+bool MaxRectsPacker::insert(int width, int height, AtlasRect& rect) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // 最短边适配：剩余短边最小者优先，其次剩余长边最小
+    int bestShortSide = INT_MAX;
+    int bestLongSide = INT_MAX;
+    const AtlasRect* best = nullptr;
+    for (const AtlasRect& freeRect : m_freeRects) {
+        if (freeRect.width < width || freeRect.height < height) {
+            continue;
+        }
+        int leftoverX = freeRect.width - width;
+        int leftoverY = freeRect.height - height;
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            best = &freeRect;
+        }
+    }
+    if (!best) {
+        return false;
+    }
+
+    rect = {best->x, best->y, width, height};
+    occupy(rect);
+    return true;
+}
+
+void MaxRectsPacker::occupy(const AtlasRect& rect) {
+    splitFreeRects(rect);
+    pruneFreeRects();
+    m_usedArea += area(rect);
+}
+
+void MaxRectsPacker::remove(const AtlasRect& rect) {
+    m_usedArea -= std::min(m_usedArea, area(rect));
+    if (m_usedArea == 0) {
+        reset(m_width, m_height);
+        return;
+    }
+    m_freeRects.push_back(rect);
+    pruneFreeRects();
+}
+
+int MaxRectsPacker::getWidth() const {
+    return m_width;
+}
+
+int MaxRectsPacker::getHeight() const {
+    return m_height;
+}
+
+size_t MaxRectsPacker::getUsedArea() const {
+    return m_usedArea;
+}
+
+float MaxRectsPacker::getFragmentation() const {
+    size_t freeArea = static_cast<size_t>(m_width) * m_height - m_usedArea;
+    if (freeArea == 0) {
+        return 0.0f;
+    }
+
+    size_t largest = 0;
+    for (const AtlasRect& freeRect : m_freeRects) {
+        largest = std::max(largest, area(freeRect));
+    }
+    return 1.0f - static_cast<float>(std::min(largest, freeArea)) / static_cast<float>(freeArea);
+}
+
+const std::vector<AtlasRect>& MaxRectsPacker::getFreeRects() const {
+    return m_freeRects;
+}
+
+void MaxRectsPacker::splitFreeRects(const AtlasRect& used) {
+    m_newFreeRects.clear();
+    for (const AtlasRect& freeRect : m_freeRects) {
+        if (!intersects(freeRect, used)) {
+            m_newFreeRects.push_back(freeRect);
+            continue;
+        }
+
+        // 与used相交时保留used左、右、上、下四侧的剩余部分（各自取满另一方向）
+        if (used.x > freeRect.x) {
+            m_newFreeRects.push_back({freeRect.x, freeRect.y, used.x - freeRect.x, freeRect.height});
+        }
+        if (used.x + used.width < freeRect.x + freeRect.width) {
+            int x = used.x + used.width;
+            m_newFreeRects.push_back({x, freeRect.y, freeRect.x + freeRect.width - x, freeRect.height});
+        }
+        if (used.y > freeRect.y) {
+            m_newFreeRects.push_back({freeRect.x, freeRect.y, freeRect.width, used.y - freeRect.y});
+        }
+        if (used.y + used.height < freeRect.y + freeRect.height) {
+            int y = used.y + used.height;
+            m_newFreeRects.push_back({freeRect.x, y, freeRect.width, freeRect.y + freeRect.height - y});
+        }
+    }
+    m_freeRects.swap(m_newFreeRects);
+}
+
+void MaxRectsPacker::pruneFreeRects() {
+    for (size_t i = 0; i < m_freeRects.size(); ++i) {
+        for (size_t j = i + 1; j < m_freeRects.size();) {
+            if (contains(m_freeRects[i], m_freeRects[j])) {
+                m_freeRects.erase(m_freeRects.begin() + j);
+            } else if (contains(m_freeRects[j], m_freeRects[i])) {
+                m_freeRects.erase(m_freeRects.begin() + i);
+                j = i + 1;
+            } else {
+                ++j;
+            }
+        }
+    }
+}
+
+Rect AtlasRegion::mapUV(const Rect& srcRect) const {
+    return Rect(uvRect.x + srcRect.x * uvRect.width, uvRect.y + srcRect.y * uvRect.height,
+                srcRect.width * uvRect.width, srcRect.height * uvRect.height);
+}
+
+TextureAtlas::TextureAtlas(GraphicsDevice* device, int pageSize, int padding)
+    : m_device(device)
+    , m_pageSize(pageSize)
+    , m_padding(std::max(0, padding))
+    , m_repackThreshold(DEFAULT_REPACK_THRESHOLD)
+    , m_distanceFieldSpread(0.0f)
+    , m_generation(0)
+    , m_repacks(0)
+    , m_repackPending(false) {
+}
+
+TextureAtlas::~TextureAtlas() {
+}
+
+const AtlasRegion* TextureAtlas::insert(const std::string& name, int width, int height, const uint32_t* pixels) {
+    int slotWidth = width + m_padding * 2;
+    int slotHeight = height + m_padding * 2;
+    if (!pixels || width <= 0 || height <= 0 || slotWidth > m_pageSize || slotHeight > m_pageSize) {
+        return nullptr;
+    }
+
+    // 同名区域先释放，新图像可以放回原来的位置；放置失败时重新占用，原区域保持不变
+    auto existing = m_entries.find(name);
+    if (existing != m_entries.end()) {
+        m_pages[existing->second.region.page].packer.remove(existing->second.slot);
+    }
+
+    // 复制像素并向四周填充边缘像素
+    Entry entry;
+    entry.slot = {0, 0, slotWidth, slotHeight};
+    entry.pixels.resize(static_cast<size_t>(slotWidth) * slotHeight);
+    for (int y = 0; y < slotHeight; ++y) {
+        int sourceY = std::min(std::max(y - m_padding, 0), height - 1);
+        for (int x = 0; x < slotWidth; ++x) {
+            int sourceX = std::min(std::max(x - m_padding, 0), width - 1);
+            entry.pixels[static_cast<size_t>(y) * slotWidth + x] = pixels[static_cast<size_t>(sourceY) * width + sourceX];
+        }
+    }
+
+    // 放不下时先放到新页面，碎片整理推迟到帧之间，本帧已提交的区域保持不动
+    bool placed = place(entry, false);
+    if (!placed) {
+        if (shouldRepack(area(entry.slot))) {
+            m_repackPending = true;
+        }
+        placed = place(entry, true);
+    }
+    if (!placed) {
+        if (existing != m_entries.end()) {
+            m_pages[existing->second.region.page].packer.occupy(existing->second.slot);
+        }
+        return nullptr;
+    }
+
+    // 替换时原地更新，调用方持有的区域指针保持有效
+    if (existing != m_entries.end()) {
+        existing->second = std::move(entry);
+        return &existing->second.region;
+    }
+    Entry& stored = m_entries.emplace(name, std::move(entry)).first->second;
+    return &stored.region;
+}
+
+const AtlasRegion* TextureAtlas::find(const std::string& name) const {
+    auto it = m_entries.find(name);
+    return it != m_entries.end() ? &it->second.region : nullptr;
+}
+
+bool TextureAtlas::remove(const std::string& name) {
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    m_pages[it->second.region.page].packer.remove(it->second.slot);
+    m_entries.erase(it);
+    return true;
+}
+
+bool TextureAtlas::repack() {
+    // 从大到小放置填充率最高；尺寸相同时按名称排序，保证结果确定
+    std::vector<std::pair<const std::string*, Entry*>> order;
+    order.reserve(m_entries.size());
+    for (auto& pair : m_entries) {
+        order.push_back(std::make_pair(&pair.first, &pair.second));
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<const std::string*, Entry*>& a, const std::pair<const std::string*, Entry*>& b) {
+        int sideA = std::max(a.second->slot.width, a.second->slot.height);
+        int sideB = std::max(b.second->slot.width, b.second->slot.height);
+        if (sideA != sideB) {
+            return sideA > sideB;
+        }
+        if (area(a.second->slot) != area(b.second->slot)) {
+            return area(a.second->slot) > area(b.second->slot);
+        }
+        return *a.first < *b.first;
+    });
+
+    // 保存原有布局，有区域放不下（无法新建页面）时恢复
+    size_t pageCount = m_pages.size();
+    std::vector<MaxRectsPacker> packers;
+    packers.reserve(pageCount);
+    for (const Page& page : m_pages) {
+        packers.push_back(page.packer);
+    }
+    std::vector<std::pair<AtlasRegion, AtlasRect>> layout;
+    layout.reserve(order.size());
+    for (const auto& pair : order) {
+        layout.push_back(std::make_pair(pair.second->region, pair.second->slot));
+    }
+
+    // 清空现有页面后重新放置，未使用的页面在末尾删除
+    for (Page& page : m_pages) {
+        page.packer.reset(m_pageSize, m_pageSize);
+        page.texture->create(m_pageSize, m_pageSize);
+    }
+    bool placedAll = true;
+    for (auto& pair : order) {
+        if (!place(*pair.second, true)) {
+            placedAll = false;
+            break;
+        }
+    }
+    if (!placedAll) {
+        m_pages.erase(m_pages.begin() + pageCount, m_pages.end());
+        for (size_t i = 0; i < pageCount; ++i) {
+            m_pages[i].packer = packers[i];
+            m_pages[i].texture->create(m_pageSize, m_pageSize);
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            Entry& entry = *order[i].second;
+            entry.region = layout[i].first;
+            entry.slot = layout[i].second;
+            m_pages[entry.region.page].texture->update(entry.slot.x, entry.slot.y, entry.slot.width, entry.slot.height, entry.pixels.data());
+        }
+        m_repackPending = false;
+        return false;
+    }
+    while (m_pages.size() > 1 && m_pages.back().packer.getUsedArea() == 0) {
+        m_pages.pop_back();
+    }
+
+    m_generation++;
+    m_repacks++;
+    m_repackPending = false;
+    return true;
+}
+
+bool TextureAtlas::repackIfPending() {
+    if (!m_repackPending) {
+        return false;
+    }
+    return repack();
+}
+
+bool TextureAtlas::isRepackPending() const {
+    return m_repackPending;
+}
+
+void TextureAtlas::setRepackThreshold(float fragmentation) {
+    m_repackThreshold = fragmentation;
+}
+
+void TextureAtlas::setDistanceField(float spread) {
+    m_distanceFieldSpread = spread;
+    for (Page& page : m_pages) {
+        page.texture->setDistanceField(spread);
+    }
+}
+
+size_t TextureAtlas::getPageCount() const {
+    return m_pages.size();
+}
+
+const Texture* TextureAtlas::getPage(size_t index) const {
+    return index < m_pages.size() ? m_pages[index].texture.get() : nullptr;
+}
+
+unsigned int TextureAtlas::getGeneration() const {
+    return m_generation;
+}
+
+TextureAtlas::Stats TextureAtlas::getStats() const {
+    Stats stats;
+    stats.pages = m_pages.size();
+    stats.regions = m_entries.size();
+    stats.occupancy = 0.0f;
+    stats.fragmentation = 0.0f;
+    stats.repacks = m_repacks;
+    for (const Page& page : m_pages) {
+        stats.occupancy += static_cast<float>(page.packer.getUsedArea()) / (static_cast<float>(m_pageSize) * m_pageSize);
+        stats.fragmentation = std::max(stats.fragmentation, page.packer.getFragmentation());
+    }
+    if (!m_pages.empty()) {
+        stats.occupancy /= static_cast<float>(m_pages.size());
+    }
+    return stats;
+}
+
+bool TextureAtlas::place(Entry& entry, bool allowNewPage) {
+    AtlasRect slot;
+    size_t pageIndex = 0;
+    while (pageIndex < m_pages.size() && !m_pages[pageIndex].packer.insert(entry.slot.width, entry.slot.height, slot)) {
+        pageIndex++;
+    }
+    if (pageIndex == m_pages.size()) {
+        if (!allowNewPage || !addPage() || !m_pages.back().packer.insert(entry.slot.width, entry.slot.height, slot)) {
+            return false;
+        }
+    }
+
+    Page& page = m_pages[pageIndex];
+    page.texture->update(slot.x, slot.y, slot.width, slot.height, entry.pixels.data());
+
+    entry.slot = slot;
+    entry.region.texture = page.texture.get();
+    entry.region.page = pageIndex;
+    entry.region.rect = {slot.x + m_padding, slot.y + m_padding, slot.width - m_padding * 2, slot.height - m_padding * 2};
+    float scale = 1.0f / static_cast<float>(m_pageSize);
+    entry.region.uvRect = Rect(entry.region.rect.x * scale, entry.region.rect.y * scale,
+                               entry.region.rect.width * scale, entry.region.rect.height * scale);
+    return true;
+}
+
+bool TextureAtlas::addPage() {
+    if (!m_device) {
+        return false;
+    }
+
+    Page page;
+    page.texture = m_device->createTexture();
+    if (!page.texture || !page.texture->create(m_pageSize, m_pageSize)) {
+        return false;
+    }
+    page.texture->setDistanceField(m_distanceFieldSpread);
+    page.packer.reset(m_pageSize, m_pageSize);
+    m_pages.push_back(std::move(page));
+    return true;
+}
+
+bool TextureAtlas::shouldRepack(size_t area) const {
+    size_t freeArea = 0;
+    float fragmentation = 0.0f;
+    for (const Page& page : m_pages) {
+        freeArea += static_cast<size_t>(m_pageSize) * m_pageSize - page.packer.getUsedArea();
+        fragmentation = std::max(fragmentation, page.packer.getFragmentation());
+    }
+    return freeArea >= area && fragmentation > m_repackThreshold;
+}
+
+} // namespace Appgame
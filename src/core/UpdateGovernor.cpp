@@ -0,0 +1,161 @@
+#include "core/UpdateGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Appgame {
+
+namespace {
+
+// 负载指数平滑系数
+const float LOAD_SMOOTHING = 0.1f;
+
+// 降低过载等级时阈值乘以该系数，避免在阈值附近来回切换
+const float RECOVERY_MARGIN = 0.85f;
+
+} // namespace
+
+UpdateGovernor::UpdateGovernor()
+    : m_maxCatchUpSteps(4)
+    , m_moderateThreshold(0.75f)
+    , m_severeThreshold(1.0f)
+    , m_recoveryFrames(120)
+    , m_level(OverloadLevel::NONE)
+    , m_cappedThisFrame(false)
+    , m_hasLoadSample(false)
+    , m_calmFrames(0)
+    , m_nextCallbackId(0)
+{
+    m_stats = Stats();
+    m_stats.level = OverloadLevel::NONE;
+}
+
+void UpdateGovernor::setMaxCatchUpSteps(int maxSteps) {
+    m_maxCatchUpSteps = std::max(maxSteps, 1);
+}
+
+int UpdateGovernor::getMaxCatchUpSteps() const {
+    return m_maxCatchUpSteps;
+}
+
+void UpdateGovernor::setLoadThresholds(float moderate, float severe) {
+    m_moderateThreshold = moderate;
+    m_severeThreshold = std::max(severe, moderate);
+}
+
+void UpdateGovernor::setRecoveryFrames(int frames) {
+    m_recoveryFrames = std::max(frames, 1);
+}
+
+int UpdateGovernor::beginFrame(float& accumulator, float fixedStep) {
+    m_cappedThisFrame = false;
+    if (fixedStep <= 0.0f || accumulator < fixedStep) {
+        m_stats.backlog = std::max(accumulator, 0.0f);
+        return 0;
+    }
+
+    int steps = static_cast<int>(std::floor(accumulator / fixedStep));
+    if (steps > m_maxCatchUpSteps) {
+        // 丢弃超出上限的整步积压，保留不足一步的相位
+        int dropped = steps - m_maxCatchUpSteps;
+        accumulator -= static_cast<float>(dropped) * fixedStep;
+        m_stats.droppedSteps += static_cast<uint64_t>(dropped);
+        m_stats.droppedTime += static_cast<double>(dropped) * fixedStep;
+        m_stats.cappedFrames++;
+        m_cappedThisFrame = true;
+        steps = m_maxCatchUpSteps;
+    }
+
+    m_stats.backlog = std::max(accumulator - static_cast<float>(steps) * fixedStep, 0.0f);
+    return steps;
+}
+
+void UpdateGovernor::endFrame(int steps, float fixedStep, float workMilliseconds) {
+    m_stats.frames++;
+    m_stats.lastSteps = steps;
+    m_stats.maxSteps = std::max(m_stats.maxSteps, steps);
+
+    // 没有推进模拟时间的帧不参与负载估计
+    if (steps > 0 && fixedStep > 0.0f) {
+        float sample = workMilliseconds / (static_cast<float>(steps) * fixedStep * 1000.0f);
+        if (m_hasLoadSample) {
+            m_stats.load += (sample - m_stats.load) * LOAD_SMOOTHING;
+        } else {
+            m_stats.load = sample;
+            m_hasLoadSample = true;
+        }
+    }
+
+    OverloadLevel target = classify(m_stats.load, m_cappedThisFrame, 1.0f);
+    if (target > m_level) {
+        m_calmFrames = 0;
+        setLevel(target);
+        return;
+    }
+
+    // 连续若干帧低于带回差的阈值后逐级下降
+    if (classify(m_stats.load, m_cappedThisFrame, RECOVERY_MARGIN) < m_level) {
+        if (++m_calmFrames >= m_recoveryFrames) {
+            m_calmFrames = 0;
+            setLevel(static_cast<OverloadLevel>(static_cast<int>(m_level) - 1));
+        }
+    } else {
+        m_calmFrames = 0;
+    }
+}
+
+UpdateGovernor::OverloadLevel UpdateGovernor::getOverloadLevel() const {
+    return m_level;
+}
+
+UpdateGovernor::CallbackID UpdateGovernor::addOverloadCallback(std::function<void(OverloadLevel)> callback) {
+    CallbackID id = m_nextCallbackId++;
+    m_callbacks.push_back(std::make_pair(id, callback));
+    return id;
+}
+
+void UpdateGovernor::removeOverloadCallback(CallbackID id) {
+    m_callbacks.erase(std::remove_if(m_callbacks.begin(), m_callbacks.end(),
+        [id](const std::pair<CallbackID, std::function<void(OverloadLevel)>>& entry) { return entry.first == id; }), m_callbacks.end());
+}
+
+UpdateGovernor::Stats UpdateGovernor::getStats() const {
+    Stats stats = m_stats;
+    stats.level = m_level;
+    return stats;
+}
+
+void UpdateGovernor::resetStats() {
+    float load = m_stats.load;
+    m_stats = Stats();
+    m_stats.load = load;
+    m_stats.level = m_level;
+}
+
+UpdateGovernor::OverloadLevel UpdateGovernor::classify(float load, bool capped, float scale) const {
+    if (capped || load >= m_severeThreshold * scale) {
+        return OverloadLevel::SEVERE;
+    }
+    if (load >= m_moderateThreshold * scale) {
+        return OverloadLevel::MODERATE;
+    }
+    return OverloadLevel::NONE;
+}
+
+void UpdateGovernor::setLevel(OverloadLevel level) {
+    if (level == m_level) {
+        return;
+    }
+
+    m_level = level;
+    m_stats.levelChanges++;
+
+    // 回调中可能添加或移除订阅，遍历副本
+    std::vector<std::pair<CallbackID, std::function<void(OverloadLevel)>>> callbacks = m_callbacks;
+    for (const auto& entry : callbacks) {
+        if (entry.second) {
+            entry.second(level);
+        }
+    }
+}
+
+} // namespace Appgame
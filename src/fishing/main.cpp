@@ -1,6 +1,11 @@
 #include "fishing/platform/Platform.h"
 #include "fishing/ui/UIManager.h"
+#include "fishing/systems/SceneManager.h"
+#include "fishing/systems/FishingSystem.h"
+#include "core/GameLoop.h"
 #include <iostream>
+#include <string>
+#include <cstdlib>
 
 int main(int argc, char* argv[])
 {
@@ -73,34 +78,100 @@ int main(int argc, char* argv[])
     FishingGame::g_uiManager->setScreenSize(screenInfo.width, screenInfo.height);
     FishingGame::g_uiManager->init();
     
+    // 初始化场景管理器（启动时进入主菜单）
+    std::cout << "Initializing Scene Manager..." << std::endl;
+    FishingGame::g_sceneManager = new FishingGame::SceneManager();
+    FishingGame::g_sceneManager->setSceneSize(screenInfo.width, screenInfo.height);
+    FishingGame::g_sceneManager->init();
+    
+    // 初始化钓鱼系统
+    std::cout << "Initializing Fishing System..." << std::endl;
+    FishingGame::g_fishingSystem = new FishingGame::FishingSystem();
+    FishingGame::g_fishingSystem->init();
+    
     // 运行游戏主循环
-    std::cout << "Running game loop..." << std::endl;
-    
-    // 模拟游戏运行
-    bool running = true;
-    int32 frameCount = 0;
-    while (running && frameCount < 100) { // 只运行100帧，避免无限循环
-        // 运行平台消息循环
-        if (!FishingGame::g_platform->runMessageLoop()) {
-            running = false;
+    // 使用 --headless <秒数> 以无头模式运行：只执行固定步长更新，不渲染、不等待
+    double headlessSeconds = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--headless") {
+            headlessSeconds = (i + 1 < argc) ? std::atof(argv[i + 1]) : 60.0;
         }
-        
-        // 模拟游戏逻辑
+    }
+
+    Appgame::GameLoop gameLoop;
+    gameLoop.setFixedTimeStep(1.0f / 60.0f);
+    gameLoop.setTargetFPS(60);
+    gameLoop.setUpdateCallback([](float deltaTime) {
         // TODO: 实现游戏主逻辑
         
-        // 更新UI管理器
-        FishingGame::g_uiManager->update(0.016f); // 约60FPS
+        // 更新场景管理器
+        FishingGame::g_sceneManager->update(deltaTime);
         
-        // 渲染UI管理器
-        FishingGame::g_uiManager->render();
+        // 更新钓鱼系统（鱼AI和物理按各自频率更新）
+        FishingGame::g_fishingSystem->update(deltaTime);
         
-        // 短暂睡眠，避免CPU占用过高
-        FishingGame::g_platform->sleep(16); // 约60FPS
+        // 更新UI管理器
+        FishingGame::g_uiManager->update(deltaTime);
+    });
+
+    // 过载时降低鱼AI更新频率和物理迭代次数，负载恢复后还原
+    FishingGame::g_fishingSystem->attachUpdateGovernor(&gameLoop.getUpdateGovernor());
+
+    if (headlessSeconds > 0.0) {
+        std::cout << "Running headless simulation for " << headlessSeconds << "s..." << std::endl;
+        Appgame::GameLoop::HeadlessStats stats = gameLoop.runFor(headlessSeconds);
+        std::cout << "Steps: " << stats.steps << std::endl;
+        std::cout << "Simulated: " << stats.simulatedSeconds << "s in " << stats.wallSeconds << "s" << std::endl;
+        std::cout << "Throughput: " << stats.simSecondsPerWallSecond << " sim-s/wall-s" << std::endl;
+        std::cout << "Step time: avg " << stats.avgStepTime << "ms, max " << stats.maxStepTime << "ms" << std::endl;
+    } else {
+        std::cout << "Running game loop..." << std::endl;
         
-        // 增加帧计数
-        frameCount++;
+        FishingGame::int32 frameCount = 0;
+        gameLoop.setRenderCallback([&gameLoop, &frameCount](float alpha) {
+            // 运行平台消息循环
+            if (!FishingGame::g_platform->runMessageLoop()) {
+                gameLoop.stop();
+            }
+            
+            // 渲染UI管理器
+            FishingGame::g_uiManager->render();
+            
+            // 只运行100帧，避免无限循环
+            if (++frameCount >= 100) {
+                gameLoop.stop();
+            }
+        });
+        // 暂停或静态界面时进入空闲模式：只按超时唤醒处理平台消息，不更新、不渲染
+        gameLoop.setIdleTimeout(0.1f);
+        gameLoop.setIdleCondition([]() {
+            return FishingGame::g_sceneManager->isCurrentSceneStatic();
+        });
+        gameLoop.setIdleCallback([&gameLoop]() {
+            if (!FishingGame::g_platform->runMessageLoop()) {
+                gameLoop.stop();
+            }
+        });
+        gameLoop.start();
+
+        Appgame::GameLoop::IdleStats idleStats = gameLoop.getIdleStats();
+        if (idleStats.wakeups > 0) {
+            std::cout << "Idle: " << idleStats.idleSeconds << "s, " << idleStats.wakeups << " wakeups, CPU " << idleStats.cpuUsage * 100.0f << "%" << std::endl;
+        }
     }
     
+    // 清理钓鱼系统（取消过载信号订阅，须在gameLoop销毁前进行）
+    std::cout << "Cleaning up Fishing System..." << std::endl;
+    FishingGame::g_fishingSystem->cleanup();
+    delete FishingGame::g_fishingSystem;
+    FishingGame::g_fishingSystem = nullptr;
+    
+    // 清理场景管理器
+    std::cout << "Cleaning up Scene Manager..." << std::endl;
+    FishingGame::g_sceneManager->cleanup();
+    delete FishingGame::g_sceneManager;
+    FishingGame::g_sceneManager = nullptr;
+    
     // 清理UI管理器
     std::cout << "Cleaning up UI Manager..." << std::endl;
     FishingGame::g_uiManager->cleanup();
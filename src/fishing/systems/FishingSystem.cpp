@@ -1,10 +1,23 @@
 #include "fishing/systems/FishingSystem.h"
 #include "fishing/systems/FishManager.h"
 #include "fishing/systems/PhysicsManager.h"
+#include <algorithm>
 #include <iostream>
 
 namespace FishingGame {
 
+namespace {
+
+// 鱼AI和物理的更新频率（Hz）
+const float32 FISH_UPDATE_RATE = 30.0f;
+const float32 PHYSICS_UPDATE_RATE = 60.0f;
+
+// 过载时鱼AI的更新频率（Hz）
+const float32 FISH_UPDATE_RATE_MODERATE = 20.0f;
+const float32 FISH_UPDATE_RATE_SEVERE = 10.0f;
+
+} // namespace
+
 FishingSystem::FishingSystem()
     : m_fishingState(FishingState::IDLE),
       m_currentFishingSpot(0),
@@ -17,6 +30,12 @@ FishingSystem::FishingSystem()
       m_isFishing(false),
       m_fishManager(nullptr),
       m_physicsManager(nullptr),
+      m_fishSystemId(-1),
+      m_physicsSystemId(-1),
+      m_overloadLevel(Appgame::UpdateGovernor::OverloadLevel::NONE),
+      m_basePhysicsIterations(0),
+      m_updateGovernor(nullptr),
+      m_overloadCallbackId(0),
       m_playerData(nullptr),
       m_castPower(0.0f),
       m_castAngle(0.0f),
@@ -31,6 +50,14 @@ FishingSystem::FishingSystem()
     
     // 初始化物理管理器
     m_physicsManager = std::make_unique<PhysicsManager>();
+    
+    // 鱼AI和物理按各自频率更新
+    m_fishSystemId = m_systemScheduler.addSystem("FishManager", FISH_UPDATE_RATE, [this](float32 deltaTime) {
+        m_fishManager->update(deltaTime);
+    });
+    m_physicsSystemId = m_systemScheduler.addSystem("PhysicsManager", PHYSICS_UPDATE_RATE, [this](float32 deltaTime) {
+        m_physicsManager->update(deltaTime);
+    });
 }
 
 FishingSystem::~FishingSystem() {
@@ -58,6 +85,9 @@ bool FishingSystem::init() {
 }
 
 void FishingSystem::cleanup() {
+    // 取消过载信号订阅
+    attachUpdateGovernor(nullptr);
+    
     // 停止钓鱼
     stopFishing();
     
@@ -73,15 +103,8 @@ void FishingSystem::cleanup() {
 }
 
 void FishingSystem::update(float32 deltaTime) {
-    // 更新鱼管理器
-    if (m_fishManager) {
-        m_fishManager->update(deltaTime);
-    }
-    
-    // 更新物理管理器
-    if (m_physicsManager) {
-        m_physicsManager->update(deltaTime);
-    }
+    // 按各自频率更新鱼管理器和物理管理器
+    m_systemScheduler.update(deltaTime);
     
     // 处理钓鱼状态
     if (m_isFishing) {
@@ -239,6 +262,58 @@ PhysicsManager* FishingSystem::getPhysicsManager() const {
     return m_physicsManager.get();
 }
 
+Appgame::SystemScheduler& FishingSystem::getSystemScheduler() {
+    return m_systemScheduler;
+}
+
+void FishingSystem::setOverloadLevel(Appgame::UpdateGovernor::OverloadLevel level) {
+    if (level == m_overloadLevel) {
+        return;
+    }
+
+    // 首次降级时记录正常的物理迭代次数，恢复时还原
+    if (m_overloadLevel == Appgame::UpdateGovernor::OverloadLevel::NONE) {
+        m_basePhysicsIterations = m_physicsManager->getIterations();
+    }
+    m_overloadLevel = level;
+
+    switch (level) {
+        case Appgame::UpdateGovernor::OverloadLevel::NONE:
+            m_systemScheduler.setRate(m_fishSystemId, FISH_UPDATE_RATE);
+            m_physicsManager->setIterations(m_basePhysicsIterations);
+            break;
+        case Appgame::UpdateGovernor::OverloadLevel::MODERATE:
+            m_systemScheduler.setRate(m_fishSystemId, FISH_UPDATE_RATE_MODERATE);
+            m_physicsManager->setIterations(std::max(m_basePhysicsIterations / 2, 1));
+            break;
+        case Appgame::UpdateGovernor::OverloadLevel::SEVERE:
+            m_systemScheduler.setRate(m_fishSystemId, FISH_UPDATE_RATE_SEVERE);
+            m_physicsManager->setIterations(1);
+            break;
+    }
+}
+
+Appgame::UpdateGovernor::OverloadLevel FishingSystem::getOverloadLevel() const {
+    return m_overloadLevel;
+}
+
+void FishingSystem::attachUpdateGovernor(Appgame::UpdateGovernor* governor) {
+    if (m_updateGovernor) {
+        m_updateGovernor->removeOverloadCallback(m_overloadCallbackId);
+    }
+    m_updateGovernor = governor;
+    if (!m_updateGovernor) {
+        return;
+    }
+
+    m_overloadCallbackId = m_updateGovernor->addOverloadCallback([this](Appgame::UpdateGovernor::OverloadLevel level) {
+        setOverloadLevel(level);
+    });
+
+    // 订阅时同步调控器的当前等级
+    setOverloadLevel(m_updateGovernor->getOverloadLevel());
+}
+
 void FishingSystem::setPlayerData(PlayerData* playerData) {
     m_playerData = playerData;
 }
@@ -247,6 +322,51 @@ PlayerData* FishingSystem::getPlayerData() const {
     return m_playerData;
 }
 
+void FishingSystem::captureRenderSnapshot(RenderSnapshot& snapshot) const {
+    GameState& state = snapshot.gameState;
+    if (m_playerData) {
+        state.player = *m_playerData;
+    }
+    state.currentFishingSpot = m_currentFishingSpot;
+    state.isFishing = m_isFishing;
+    state.fishingState = m_fishingState;
+    state.currentFish = m_currentFish;
+    state.fishSize = m_currentFishSize;
+    state.fishWeight = m_currentFishWeight;
+    state.reelingProgress = m_reelingProgress;
+    state.fishStrength = m_fishStrength;
+    state.lineTension = m_lineTension;
+
+    // 鱼的位置
+    snapshot.fishes.clear();
+    if (m_fishManager) {
+        const std::vector<FishInstance*>& fishes = m_fishManager->getFishes();
+        snapshot.fishes.reserve(fishes.size());
+        for (const FishInstance* fish : fishes) {
+            if (!fish || !fish->isActive()) {
+                continue;
+            }
+            FishRenderState fishState;
+            fishState.typeId = fish->getTypeID();
+            fishState.position[0] = fish->getPosition()[0];
+            fishState.position[1] = fish->getPosition()[1];
+            fishState.velocity[0] = fish->getVelocity()[0];
+            fishState.velocity[1] = fish->getVelocity()[1];
+            fishState.size = fish->getSize();
+            fishState.isHooked = fish->isHooked();
+            snapshot.fishes.push_back(fishState);
+        }
+    }
+
+    // HUD数值
+    HUDValues& hud = snapshot.hud;
+    hud.playerLevel = m_playerData ? m_playerData->level : 0;
+    hud.playerMoney = m_playerData ? m_playerData->money : 0;
+    hud.playerExperience = m_playerData ? m_playerData->experience : 0.0f;
+    hud.reelingProgress = m_reelingProgress;
+    hud.lineTension = m_lineTension;
+}
+
 void FishingSystem::initFishingState() {
     m_fishingState = FishingState::IDLE;
     m_currentFish = 0;
@@ -0,0 +1,263 @@
+#include "fishing/systems/QualityController.h"
+#include "core/Graphics.h"
+#include <algorithm>
+
+namespace FishingGame {
+
+namespace {
+
+// 降级步骤数，即最高画质等级
+const int32 MAX_QUALITY_LEVEL = 7;
+
+// 最低画质下的细节系数
+const float32 MIN_DETAIL_SCALE = 0.25f;
+
+// 默认升级所需连续窗口数及其上限
+const int32 DEFAULT_UPGRADE_WINDOWS = 3;
+const int32 MAX_UPGRADE_WINDOWS = 48;
+
+// 升级后在该窗口数内又降级，视为升级失败
+const int32 FAILED_UPGRADE_WINDOWS = 2;
+
+// 按顺序应用第step个降级步骤
+void applyDowngradeStep(GameConfig& config, int32 step) {
+    switch (step) {
+        case 0:
+            config.enableBloom = false;
+            break;
+        case 1:
+            config.antiAliasing = std::min(config.antiAliasing, 2);
+            break;
+        case 2:
+            config.shadowQuality = std::min(config.shadowQuality, 1);
+            break;
+        case 3:
+            config.antiAliasing = 0;
+            break;
+        case 4:
+            config.enableShadows = false;
+            break;
+        case 5:
+            config.textureQuality = std::min(config.textureQuality, 1);
+            break;
+        case 6:
+            config.enableParticles = false;
+            break;
+        default:
+            break;
+    }
+}
+
+// 两份设置是否完全相同
+bool sameConfig(const GameConfig& a, const GameConfig& b) {
+    return a.screenWidth == b.screenWidth && a.screenHeight == b.screenHeight && a.fullscreen == b.fullscreen &&
+        a.framerateLimit == b.framerateLimit && a.volumeMusic == b.volumeMusic && a.volumeSFX == b.volumeSFX &&
+        a.volumeAmbient == b.volumeAmbient && a.language == b.language && a.difficulty == b.difficulty &&
+        a.saveType == b.saveType && a.enableVSync == b.enableVSync && a.enableParticles == b.enableParticles &&
+        a.enableShadows == b.enableShadows && a.enableBloom == b.enableBloom && a.textureQuality == b.textureQuality &&
+        a.shadowQuality == b.shadowQuality && a.antiAliasing == b.antiAliasing;
+}
+
+} // namespace
+
+QualityController::QualityController()
+    : m_baseConfig()
+    , m_config()
+    , m_level(MAX_QUALITY_LEVEL)
+    , m_targetFrameTime(1000.0f / 60.0f)
+    , m_percentile(90.0f)
+    , m_downgradeRatio(1.0f)
+    , m_upgradeRatio(0.7f)
+    , m_windowFrames(60)
+    , m_enabled(true)
+    , m_goodWindows(0)
+    , m_cooldownWindows(0)
+    , m_windowsSinceUpgrade(FAILED_UPGRADE_WINDOWS + 1)
+    , m_nextCallbackId(0)
+{
+    m_stats = Stats();
+    m_stats.upgradeWindows = DEFAULT_UPGRADE_WINDOWS;
+    m_performance = PerformanceData();
+}
+
+QualityController::~QualityController() {
+}
+
+void QualityController::setBaseConfig(const GameConfig& config) {
+    bool changed = m_level != MAX_QUALITY_LEVEL || !sameConfig(m_config, config);
+    m_baseConfig = config;
+    m_goodWindows = 0;
+    m_window.reset();
+
+    if (config.framerateLimit > 0) {
+        setTargetFrameRate(static_cast<float32>(config.framerateLimit));
+    }
+
+    // 恢复到最高画质，有变化时通知订阅者，避免它们停留在降级后的设置
+    if (changed) {
+        changeLevel(MAX_QUALITY_LEVEL, m_stats.lastFrameTime);
+    }
+    m_cooldownWindows = 0;
+}
+
+const GameConfig& QualityController::getConfig() const {
+    return m_config;
+}
+
+void QualityController::setTargetFrameRate(float32 fps) {
+    if (fps > 0.0f) {
+        m_targetFrameTime = 1000.0f / fps;
+    }
+}
+
+void QualityController::setPercentile(float32 percentile) {
+    m_percentile = std::min(std::max(percentile, 0.0f), 100.0f);
+}
+
+void QualityController::setThresholds(float32 downgradeRatio, float32 upgradeRatio) {
+    m_downgradeRatio = downgradeRatio;
+    m_upgradeRatio = std::min(upgradeRatio, downgradeRatio);
+}
+
+void QualityController::setWindowFrames(int32 frames) {
+    m_windowFrames = std::max(frames, 1);
+}
+
+void QualityController::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    m_window.reset();
+    m_goodWindows = 0;
+}
+
+bool QualityController::isEnabled() const {
+    return m_enabled;
+}
+
+void QualityController::recordFrame(float32 frameTime) {
+    m_performance.frameTime = frameTime;
+    if (!m_enabled) {
+        return;
+    }
+
+    m_window.record(frameTime);
+    if (m_window.getCount() >= static_cast<uint64>(m_windowFrames)) {
+        evaluateWindow();
+    }
+}
+
+int32 QualityController::getQualityLevel() const {
+    return m_level;
+}
+
+int32 QualityController::getMaxQualityLevel() const {
+    return MAX_QUALITY_LEVEL;
+}
+
+void QualityController::setQualityLevel(int32 level) {
+    level = std::min(std::max(level, 0), MAX_QUALITY_LEVEL);
+    if (level != m_level) {
+        changeLevel(level, m_stats.lastFrameTime);
+    }
+}
+
+float32 QualityController::getDetailScale() const {
+    return MIN_DETAIL_SCALE + (1.0f - MIN_DETAIL_SCALE) * static_cast<float32>(m_level) / static_cast<float32>(MAX_QUALITY_LEVEL);
+}
+
+QualityController::CallbackID QualityController::addQualityCallback(std::function<void(const QualityChangeEvent&)> callback) {
+    CallbackID id = m_nextCallbackId++;
+    m_callbacks.push_back(std::make_pair(id, callback));
+    return id;
+}
+
+void QualityController::removeQualityCallback(CallbackID id) {
+    m_callbacks.erase(std::remove_if(m_callbacks.begin(), m_callbacks.end(),
+        [id](const std::pair<CallbackID, std::function<void(const QualityChangeEvent&)>>& entry) { return entry.first == id; }), m_callbacks.end());
+}
+
+QualityController::Stats QualityController::getStats() const {
+    return m_stats;
+}
+
+void QualityController::recordRenderStats(const Appgame::RenderStats& stats) {
+    m_performance.drawCalls = static_cast<float32>(stats.batches);
+    m_performance.triangles = static_cast<float32>(stats.triangles);
+    m_performance.vertices = static_cast<float32>(stats.vertices);
+}
+
+const PerformanceData& QualityController::getPerformanceData() const {
+    return m_performance;
+}
+
+void QualityController::evaluateWindow() {
+    float32 frameTime = m_window.getPercentile(m_percentile);
+    if (m_window.getMean() > 0.0f) {
+        m_performance.averageFramerate = 1000.0f / m_window.getMean();
+        m_performance.minimumFramerate = 1000.0f / m_window.getMax();
+        m_performance.maximumFramerate = 1000.0f / std::max(m_window.getMin(), 0.001f);
+    }
+    m_window.reset();
+    m_stats.windows++;
+    m_stats.lastFrameTime = frameTime;
+    m_windowsSinceUpgrade++;
+
+    // 画质变化后跳过一个窗口，等待新设置的效果体现在帧时间上
+    if (m_cooldownWindows > 0) {
+        m_cooldownWindows--;
+        return;
+    }
+
+    if (frameTime > m_targetFrameTime * m_downgradeRatio) {
+        m_goodWindows = 0;
+        if (m_level > 0) {
+            // 刚升级就又超时，说明上一级无法维持，延长下次升级前的观察时间
+            if (m_windowsSinceUpgrade <= FAILED_UPGRADE_WINDOWS) {
+                m_stats.upgradeWindows = std::min(m_stats.upgradeWindows * 2, MAX_UPGRADE_WINDOWS);
+            }
+            m_stats.downgrades++;
+            changeLevel(m_level - 1, frameTime);
+        }
+    } else if (frameTime < m_targetFrameTime * m_upgradeRatio) {
+        if (++m_goodWindows >= m_stats.upgradeWindows && m_level < MAX_QUALITY_LEVEL) {
+            m_goodWindows = 0;
+            m_windowsSinceUpgrade = 0;
+            m_stats.upgrades++;
+            changeLevel(m_level + 1, frameTime);
+        }
+    } else {
+        // 处于回差区间内，保持当前画质
+        m_goodWindows = 0;
+    }
+}
+
+GameConfig QualityController::buildConfig(int32 level) const {
+    GameConfig config = m_baseConfig;
+    for (int32 step = 0; step < MAX_QUALITY_LEVEL - level; ++step) {
+        applyDowngradeStep(config, step);
+    }
+    return config;
+}
+
+void QualityController::changeLevel(int32 level, float32 frameTime) {
+    QualityChangeEvent event;
+    event.previousLevel = m_level;
+    event.level = level;
+    event.frameTime = frameTime;
+
+    m_level = level;
+    m_config = buildConfig(level);
+    m_cooldownWindows = 1;
+
+    event.detailScale = getDetailScale();
+    event.config = m_config;
+
+    // 回调中可能添加或移除订阅，遍历副本
+    std::vector<std::pair<CallbackID, std::function<void(const QualityChangeEvent&)>>> callbacks = m_callbacks;
+    for (const auto& entry : callbacks) {
+        if (entry.second) {
+            entry.second(event);
+        }
+    }
+}
+
+} // namespace FishingGame
@@ -5,6 +5,14 @@
 
 namespace FishingGame {
 
+namespace {
+
+// 慢变化系统的更新频率（Hz）
+const float32 WEATHER_UPDATE_RATE = 1.0f;
+const float32 TIME_UPDATE_RATE = 10.0f;
+
+} // namespace
+
 // Scene implementation
 Scene::~Scene() {
 }
@@ -49,15 +57,7 @@ void BaseScene::update(float32 deltaTime) {
         return;
     }
     
-    // 更新天气系统
-    if (m_weatherSystem) {
-        m_weatherSystem->update(deltaTime);
-    }
-    
-    // 更新时间系统
-    if (m_timeSystem) {
-        m_timeSystem->update(deltaTime);
-    }
+    // 天气系统和时间系统由SceneManager的系统调度器按各自频率更新
 }
 
 void BaseScene::render() {
@@ -207,6 +207,25 @@ FishingSpotID GameScene::getCurrentFishingSpot() const {
     return m_currentFishingSpot;
 }
 
+uint64 GameScene::getStaticLayerKey() const {
+    // 钓鱼点(32位) | 天气(8位) | 天气过渡进度(8位) | 时段(8位) | 时段过渡进度(8位)
+    // 各字段加1，使“没有天气/时间系统”与第一个枚举值区分开
+    uint64 key = static_cast<uint64>(m_currentFishingSpot) << 32;
+    if (m_weatherSystem) {
+        key |= static_cast<uint64>(static_cast<int32>(m_weatherSystem->getCurrentWeather()) + 1) << 24;
+        if (m_weatherSystem->isWeatherChanging()) {
+            key |= static_cast<uint64>(m_weatherSystem->getWeatherChangeProgress() * 16.0f + 1.0f) << 16;
+        }
+    }
+    if (m_timeSystem) {
+        key |= static_cast<uint64>(static_cast<int32>(m_timeSystem->getCurrentTime()) + 1) << 8;
+        if (m_timeSystem->isTimeChanging()) {
+            key |= static_cast<uint64>(m_timeSystem->getTimeChangeProgress() * 16.0f + 1.0f);
+        }
+    }
+    return key;
+}
+
 void GameScene::initFishingSpots() {
     // 初始化默认钓鱼点
     FishingSpot spot1;
@@ -296,7 +315,9 @@ SceneManager::SceneManager()
       m_weatherSystem(nullptr),
       m_timeSystem(nullptr),
       m_width(1920),
-      m_height(1080)
+      m_height(1080),
+      m_weatherSystemId(-1),
+      m_timeSystemId(-1)
 {
 }
 
@@ -305,6 +326,9 @@ SceneManager::~SceneManager() {
 }
 
 bool SceneManager::init() {
+    // 初始化系统调度器
+    initSystemScheduler();
+    
     // 初始化默认场景
     initDefaultScenes();
     
@@ -321,10 +345,18 @@ void SceneManager::cleanup() {
     // 清理所有场景
     clearScenes();
     
+    // 移除调度的系统，重新初始化时不会重复更新
+    clearSystemScheduler();
+    
     std::cout << "SceneManager cleaned up" << std::endl;
 }
 
 void SceneManager::update(float32 deltaTime) {
+    // 按各自频率更新天气系统和时间系统
+    if (m_currentScene && m_currentScene->isActive()) {
+        m_systemScheduler.update(deltaTime);
+    }
+    
     // 更新当前场景
     if (m_currentScene) {
         m_currentScene->update(deltaTime);
@@ -492,6 +524,10 @@ bool SceneManager::hasScene(SceneType type) const {
     return m_scenes.find(type) != m_scenes.end();
 }
 
+bool SceneManager::isCurrentSceneStatic() const {
+    return m_currentSceneType == SceneType::MAIN_MENU || m_currentSceneType == SceneType::SETTINGS_SCENE;
+}
+
 void SceneManager::setSceneSize(int32 width, int32 height) {
     m_width = width;
     m_height = height;
@@ -509,6 +545,39 @@ void SceneManager::getSceneSize(int32& width, int32& height) const {
     height = m_height;
 }
 
+Appgame::SystemScheduler& SceneManager::getSystemScheduler() {
+    return m_systemScheduler;
+}
+
+void SceneManager::initSystemScheduler() {
+    clearSystemScheduler();
+    
+    // 天气变化缓慢，每秒更新一次即可
+    m_weatherSystemId = m_systemScheduler.addSystem("WeatherSystem", WEATHER_UPDATE_RATE, [this](float32 deltaTime) {
+        if (m_weatherSystem) {
+            m_weatherSystem->update(deltaTime);
+        }
+    });
+    
+    // 时间系统每秒更新10次
+    m_timeSystemId = m_systemScheduler.addSystem("TimeSystem", TIME_UPDATE_RATE, [this](float32 deltaTime) {
+        if (m_timeSystem) {
+            m_timeSystem->update(deltaTime);
+        }
+    });
+}
+
+void SceneManager::clearSystemScheduler() {
+    if (m_weatherSystemId >= 0) {
+        m_systemScheduler.removeSystem(m_weatherSystemId);
+        m_weatherSystemId = -1;
+    }
+    if (m_timeSystemId >= 0) {
+        m_systemScheduler.removeSystem(m_timeSystemId);
+        m_timeSystemId = -1;
+    }
+}
+
 void SceneManager::initDefaultScenes() {
     // 创建并添加默认场景
     
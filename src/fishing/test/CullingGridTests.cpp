@@ -0,0 +1,126 @@
+#include "fishing/test/TestFramework.h"
+#include "core/CullingGrid.h"
+#include "core/SoftwareGraphics.h"
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+bool overlapsViewport(const Rect& bounds, const Rect& viewport) {
+    return bounds.x <= viewport.x + viewport.width && viewport.x <= bounds.x + bounds.width &&
+           bounds.y <= viewport.y + viewport.height && viewport.y <= bounds.y + bounds.height;
+}
+
+// 逐个检查的参考结果
+std::vector<void*> bruteForce(const std::vector<Rect>& bounds, std::vector<int>& ids, const Rect& viewport) {
+    std::vector<void*> visible;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (overlapsViewport(bounds[i], viewport)) {
+            visible.push_back(&ids[i]);
+        }
+    }
+    return visible;
+}
+
+} // namespace
+
+TEST_SUITE(CullingGrid) {
+
+TEST(CullingGrid, QueryMatchesBruteForce) {
+    // 模拟大小为1000的钓鱼点中散布的鱼
+    CullingGrid grid(128.0f);
+    std::vector<Rect> bounds;
+    std::vector<int> ids(500);
+    std::vector<CullingGrid::Handle> handles;
+    for (int i = 0; i < 500; ++i) {
+        ids[i] = i;
+        float size = 10.0f + static_cast<float>(i % 7) * 30.0f;
+        bounds.push_back(Rect(static_cast<float>((i * 397) % 1000) - 20.0f, static_cast<float>((i * 211) % 1000) - 20.0f, size, size * 0.5f));
+        handles.push_back(grid.insert(bounds.back(), &ids[i]));
+    }
+    ASSERT_EQ(500u, grid.getStats().objects);
+
+    Rect viewport(300.0f, 400.0f, 320.0f, 180.0f);
+    std::vector<void*> visible;
+    size_t count = grid.query(viewport, visible);
+    ASSERT_TRUE(visible == bruteForce(bounds, ids, viewport));
+    ASSERT_EQ(count, grid.getStats().submitted);
+    ASSERT_EQ(500u - count, grid.getStats().culled);
+    ASSERT_TRUE(count > 0 && count < 100);
+    ASSERT_TRUE(grid.getStats().cellsVisited <= 12);
+
+    // 移动一部分对象并移除一部分后结果仍与逐个检查一致
+    for (int i = 0; i < 500; i += 3) {
+        bounds[i].x = 1000.0f - bounds[i].x;
+        bounds[i].y += 37.0f;
+        grid.update(handles[i], bounds[i]);
+    }
+    for (int i = 1; i < 500; i += 5) {
+        grid.remove(handles[i]);
+        bounds[i] = Rect(-5000.0f, -5000.0f, 1.0f, 1.0f);
+    }
+    ASSERT_EQ(400u, grid.getStats().objects);
+    grid.query(viewport, visible);
+    ASSERT_TRUE(visible == bruteForce(bounds, ids, viewport));
+
+    // 覆盖整个世界的视口返回全部对象
+    ASSERT_EQ(400u, grid.query(Rect(-100.0f, -100.0f, 1400.0f, 1400.0f), visible));
+    ASSERT_EQ(0u, grid.getStats().culled);
+}
+
+TEST(CullingGrid, RendererSkipsQuadsOutsideCullRect) {
+    uint32_t white = 0xFFFFFFFFu;
+    SoftwareTexture texture;
+    texture.create(1, 1, &white);
+
+    std::vector<SpriteInstance> sprites(40);
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        SpriteInstance& sprite = sprites[i];
+        sprite.x = static_cast<float>(i) * 30.0f - 300.0f;
+        sprite.y = 30.0f;
+        sprite.width = 12.0f;
+        sprite.height = 12.0f;
+        sprite.rotation = 0.3f * static_cast<float>(i);
+        sprite.u0 = 0.0f;
+        sprite.v0 = 0.0f;
+        sprite.u1 = 1.0f;
+        sprite.v1 = 1.0f;
+        sprite.color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    uint64_t hashes[3];
+    for (int pass = 0; pass < 3; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(128, 64);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+        renderer.setInstancingEnabled(pass == 1);
+        if (pass > 0) {
+            renderer.setCullRect(Rect(0.0f, 0.0f, 128.0f, 64.0f));
+        }
+
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.drawSprites(texture, sprites.data(), sprites.size());
+        renderer.drawRect(Rect(-50.0f, 10.0f, 20.0f, 20.0f), Color(1.0f, 0.0f, 0.0f, 1.0f));
+        renderer.drawLine(10.0f, 100.0f, 100.0f, 120.0f, 4.0f, Color(0.0f, 1.0f, 0.0f, 1.0f));
+        renderer.endRender();
+
+        const RenderStats& stats = renderer.getRenderStats();
+        if (pass == 0) {
+            ASSERT_EQ(0u, stats.culled);
+            ASSERT_EQ(42u, stats.quads);
+        } else {
+            // 精灵中心x = 30i - 300，只有i为10到14的精灵与视口相交；矩形和线条都在视口外
+            ASSERT_EQ(5u, stats.quads);
+            ASSERT_EQ(37u, stats.culled);
+        }
+        hashes[pass] = softwareDevice->getFramebufferHash();
+    }
+
+    ASSERT_EQ(hashes[0], hashes[2]);
+}
+
+}
@@ -0,0 +1,140 @@
+#include "fishing/test/TestFramework.h"
+#include "core/DirtyRegion.h"
+#include "core/SoftwareGraphics.h"
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+struct Panel {
+    Rect bounds;
+    Color color;
+};
+
+bool rectsOverlap(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// 模拟商店界面：背景和若干面板，面板之间有重叠
+std::vector<Panel> makePanels() {
+    std::vector<Panel> panels;
+    panels.push_back({Rect(8.0f, 8.0f, 112.0f, 80.0f), Color(0.2f, 0.2f, 0.3f, 1.0f)});
+    for (int i = 0; i < 6; ++i) {
+        float x = 14.0f + static_cast<float>(i % 3) * 34.0f;
+        float y = 16.0f + static_cast<float>(i / 3) * 34.0f;
+        panels.push_back({Rect(x, y, 30.0f, 30.0f), Color(0.4f, 0.5f, 0.2f + 0.1f * static_cast<float>(i), 0.8f)});
+    }
+    return panels;
+}
+
+void drawPanels(Renderer& renderer, const std::vector<Panel>& panels) {
+    for (const Panel& panel : panels) {
+        renderer.drawRect(panel.bounds, panel.color);
+    }
+}
+
+} // namespace
+
+TEST_SUITE(DirtyRegion) {
+
+TEST(DirtyRegion, MergesOverlappingRectsAndCapsCount) {
+    DirtyRegion region(4);
+    region.setBounds(Rect(0.0f, 0.0f, 100.0f, 100.0f));
+    ASSERT_TRUE(region.isEmpty());
+
+    // 向外取整到像素，超出边界的部分被裁掉
+    region.add(Rect(10.5f, 10.5f, 4.0f, 4.0f));
+    ASSERT_EQ(1u, region.getRects().size());
+    ASSERT_NEAR(25.0f, region.getArea(), 0.001f);
+    region.add(Rect(95.0f, 95.0f, 20.0f, 20.0f));
+    ASSERT_NEAR(50.0f, region.getArea(), 0.001f);
+    region.add(Rect(200.0f, 0.0f, 10.0f, 10.0f));
+    ASSERT_EQ(2u, region.getRects().size());
+
+    // 重叠的矩形合并为包围盒，相距较远的保持独立
+    region.add(Rect(12.0f, 12.0f, 6.0f, 6.0f));
+    ASSERT_EQ(2u, region.getRects().size());
+    ASSERT_NEAR(64.0f + 25.0f, region.getArea(), 0.001f);
+
+    for (int i = 0; i < 6; ++i) {
+        region.add(Rect(static_cast<float>(i) * 15.0f, 50.0f, 3.0f, 3.0f));
+        ASSERT_TRUE(region.getRects().size() <= 4);
+    }
+    const std::vector<Rect>& rects = region.getRects();
+    for (size_t a = 0; a < rects.size(); ++a) {
+        for (size_t b = a + 1; b < rects.size(); ++b) {
+            ASSERT_FALSE(rectsOverlap(rects[a], rects[b]));
+        }
+    }
+
+    region.addAll();
+    ASSERT_EQ(1u, region.getRects().size());
+    ASSERT_NEAR(10000.0f, region.getArea(), 0.001f);
+    region.clear();
+    ASSERT_TRUE(region.isEmpty());
+}
+
+TEST(DirtyRegion, ScissoredRedrawMatchesFullRedraw) {
+    std::vector<Panel> panels = makePanels();
+
+    auto full = std::make_unique<SoftwareGraphicsDevice>(128, 96);
+    SoftwareGraphicsDevice* fullDevice = full.get();
+    Renderer fullRenderer(std::move(full));
+    ASSERT_TRUE(fullRenderer.init());
+
+    auto partial = std::make_unique<SoftwareGraphicsDevice>(128, 96);
+    SoftwareGraphicsDevice* partialDevice = partial.get();
+    Renderer renderer(std::move(partial));
+    ASSERT_TRUE(renderer.init());
+
+    DirtyRegion region;
+    region.setBounds(Rect(0.0f, 0.0f, 128.0f, 96.0f));
+    region.addAll();
+
+    Color background(0.0f, 0.0f, 0.0f, 1.0f);
+    for (int frame = 0; frame < 6; ++frame) {
+        // 第2帧和第4帧各有一个格子高亮变化，其余帧界面静止
+        if (frame == 2 || frame == 4) {
+            Panel& slot = panels[frame == 2 ? 2 : 6];
+            slot.color = Color(1.0f, 0.8f, 0.2f, frame == 2 ? 0.9f : 0.5f);
+            region.add(slot.bounds);
+        }
+
+        fullRenderer.beginRender();
+        fullDevice->clear(background);
+        drawPanels(fullRenderer, panels);
+        fullRenderer.endRender();
+
+        // 只重绘脏矩形，帧缓冲区保留其余区域
+        renderer.beginRender();
+        unsigned int rects = static_cast<unsigned int>(region.getRects().size());
+        for (const Rect& rect : region.getRects()) {
+            ASSERT_TRUE(renderer.setScissorRect(rect));
+            renderer.setCullRect(rect);
+            partialDevice->clear(background);
+            drawPanels(renderer, panels);
+        }
+        renderer.clearScissorRect();
+        renderer.clearCullRect();
+        region.clear();
+        renderer.endRender();
+
+        ASSERT_EQ(fullDevice->getFramebufferHash(), partialDevice->getFramebufferHash());
+        if (frame == 0) {
+            ASSERT_EQ(1u, rects);
+        } else if (frame == 2 || frame == 4) {
+            // 只提交与格子重叠的背景面板和格子本身，光栅化的像素远少于整帧
+            ASSERT_EQ(1u, rects);
+            ASSERT_EQ(2u, renderer.getRenderStats().quads);
+            ASSERT_TRUE(partialDevice->getStats().pixels * 4 < fullDevice->getStats().pixels);
+        } else {
+            ASSERT_EQ(0u, rects);
+            ASSERT_EQ(0u, renderer.getRenderStats().quads);
+            ASSERT_EQ(0u, partialDevice->getStats().pixels);
+        }
+    }
+}
+
+}
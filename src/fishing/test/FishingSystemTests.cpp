@@ -1,5 +1,6 @@
 #include "fishing/test/TestFramework.h"
 #include "fishing/systems/FishingSystem.h"
+#include "fishing/systems/PhysicsManager.h"
 #include "fishing/core/DataStructures.h"
 
 using namespace FishingGame;
@@ -186,4 +187,42 @@ TEST(FishingSystem, StateTransitions) {
     system.cleanup();
 }
 
+
+TEST(FishingSystem, DegradesWhenGovernorSignalsOverload) {
+    FishingSystem system;
+    system.init();
+    PhysicsManager* physics = system.getPhysicsManager();
+    physics->setIterations(8);
+    
+    Appgame::UpdateGovernor governor;
+    governor.setMaxCatchUpSteps(1);
+    system.attachUpdateGovernor(&governor);
+    ASSERT_TRUE(system.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::NONE);
+    
+    // 积压超过补偿上限：调控器进入SEVERE，物理只保留一次迭代
+    const float32 step = 0.01f;
+    float32 accumulator = 5.0f * step;
+    governor.endFrame(governor.beginFrame(accumulator, step), step, 40.0f);
+    ASSERT_TRUE(system.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::SEVERE);
+    ASSERT_EQ(1, physics->getIterations());
+    
+    // 负载恢复后逐级还原
+    for (int32 i = 0; i < 1000 && governor.getOverloadLevel() != Appgame::UpdateGovernor::OverloadLevel::NONE; ++i) {
+        accumulator = step;
+        governor.endFrame(governor.beginFrame(accumulator, step), step, 1.0f);
+        if (governor.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::MODERATE) {
+            ASSERT_EQ(4, physics->getIterations());
+        }
+    }
+    ASSERT_TRUE(system.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::NONE);
+    ASSERT_EQ(8, physics->getIterations());
+    
+    // cleanup取消订阅，之后的过载信号不再影响钓鱼系统
+    system.cleanup();
+    accumulator = 5.0f * step;
+    governor.endFrame(governor.beginFrame(accumulator, step), step, 40.0f);
+    ASSERT_TRUE(governor.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::SEVERE);
+    ASSERT_TRUE(system.getOverloadLevel() == Appgame::UpdateGovernor::OverloadLevel::NONE);
+}
+
 }
@@ -0,0 +1,269 @@
+#include "fishing/test/TestFramework.h"
+#include "core/Font.h"
+#include "core/TextRenderer.h"
+#include "core/SoftwareGraphics.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+// 测试用字形来源：空格为空白字形，ASCII和CJK统一汉字为实心方块，其他码点缺失
+class BlockGlyphSource : public GlyphSource {
+public:
+    bool rasterize(uint32_t codepoint, int pixelSize, GlyphBitmap& bitmap) override {
+        bool ascii = codepoint > ' ' && codepoint < 0x7F;
+        bool cjk = codepoint >= 0x4E00 && codepoint <= 0x9FFF;
+        if (codepoint == ' ') {
+            bitmap.advance = static_cast<float>(pixelSize) * 0.5f;
+            return true;
+        }
+        if (!ascii && !cjk) {
+            return false;
+        }
+        bitmap.width = cjk ? pixelSize : pixelSize / 2;
+        bitmap.height = pixelSize * 3 / 4;
+        bitmap.bearingX = 1.0f;
+        bitmap.bearingY = static_cast<float>(bitmap.height);
+        bitmap.advance = static_cast<float>(bitmap.width + 2);
+        bitmap.coverage.assign(static_cast<size_t>(bitmap.width) * bitmap.height, 255);
+        return true;
+    }
+
+    void getMetrics(int pixelSize, float& ascent, float& lineHeight) const override {
+        ascent = static_cast<float>(pixelSize) * 0.8f;
+        lineHeight = static_cast<float>(pixelSize) * 1.25f;
+    }
+};
+
+struct TextTarget {
+    SoftwareGraphicsDevice* device;
+    std::unique_ptr<Renderer> renderer;
+
+    TextTarget(int width, int height) {
+        auto owned = std::make_unique<SoftwareGraphicsDevice>(width, height);
+        device = owned.get();
+        renderer = std::make_unique<Renderer>(std::move(owned));
+        renderer->init();
+    }
+
+    void draw(TextRenderer& text, SdfFont& font, const std::string& string, float x, float y, float size) {
+        renderer->beginRender();
+        device->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        text.drawText(*renderer, font, string, x, y, size, Color(1.0f, 1.0f, 1.0f, 1.0f));
+        renderer->endRender();
+    }
+};
+
+// 两个帧缓冲区逐像素的最大通道差
+float maxDifference(const SoftwareGraphicsDevice& a, const SoftwareGraphicsDevice& b, int width, int height) {
+    float difference = 0.0f;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            Color pa = a.getPixel(x, y);
+            Color pb = b.getPixel(x, y);
+            difference = std::max(difference, std::max(std::fabs(pa.r - pb.r), std::max(std::fabs(pa.g - pb.g), std::max(std::fabs(pa.b - pb.b), std::fabs(pa.a - pb.a)))));
+        }
+    }
+    return difference;
+}
+
+} // namespace
+
+TEST_SUITE(Font) {
+
+TEST(Font, DecodesUtf8) {
+    std::vector<uint32_t> codepoints;
+    decodeUtf8("宁静湖畔", codepoints);
+    ASSERT_EQ(4u, codepoints.size());
+    ASSERT_EQ(0x5B81u, codepoints[0]);
+    ASSERT_EQ(0x9759u, codepoints[1]);
+    ASSERT_EQ(0x6E56u, codepoints[2]);
+    ASSERT_EQ(0x7554u, codepoints[3]);
+
+    // 非法字节、过长编码和截断的序列替换为U+FFFD，不吞掉后面的字符
+    decodeUtf8("a\xFF" "b\xC0\x80" "c\xE5\xAE", codepoints);
+    ASSERT_EQ(6u, codepoints.size());
+    ASSERT_EQ(static_cast<uint32_t>('a'), codepoints[0]);
+    ASSERT_EQ(0xFFFDu, codepoints[1]);
+    ASSERT_EQ(static_cast<uint32_t>('b'), codepoints[2]);
+    ASSERT_EQ(0xFFFDu, codepoints[3]);
+    ASSERT_EQ(static_cast<uint32_t>('c'), codepoints[4]);
+    ASSERT_EQ(0xFFFDu, codepoints[5]);
+}
+
+TEST(Font, GeneratesSignedDistanceField) {
+    std::vector<uint8_t> coverage(64, 255);
+    std::vector<uint8_t> field;
+    generateDistanceField(coverage.data(), 8, 8, 4, field);
+    ASSERT_EQ(256u, field.size());
+
+    // 边缘两侧的像素落在128两边，远离形状处为0，越靠近中心值越大
+    int inner = field[8 * 16 + 4];
+    int outer = field[8 * 16 + 3];
+    ASSERT_TRUE(inner > 128);
+    ASSERT_TRUE(outer < 128);
+    ASSERT_NEAR(128.0f, (inner + outer) * 0.5f, 1.0f);
+    ASSERT_TRUE(field[8 * 16 + 8] > field[8 * 16 + 6]);
+    ASSERT_TRUE(field[8 * 16 + 6] > inner);
+    ASSERT_EQ(0, static_cast<int>(field[0]));
+    ASSERT_EQ(field[8 * 16 + 3], field[3 * 16 + 8]);
+}
+
+TEST(Font, CachesGlyphRunsAndBatchesByPage) {
+    BlockGlyphSource source;
+    TextTarget target(192, 48);
+    SdfFont font(target.device, 16, 4, 256);
+    font.setSource(&source);
+    TextRenderer text;
+
+    // 第一帧排版并按需生成字形，第二帧直接使用缓存的字形串
+    target.draw(text, font, "宁静湖畔 Lake", 2.0f, 2.0f, 24.0f);
+    uint64_t firstFrame = target.device->getFramebufferHash();
+    ASSERT_EQ(1u, text.getStats().misses);
+    ASSERT_EQ(9u, font.getStats().generated);
+    ASSERT_EQ(8u, target.renderer->getRenderStats().quads);
+    ASSERT_EQ(1u, target.renderer->getRenderStats().batches);
+
+    target.draw(text, font, "宁静湖畔 Lake", 2.0f, 2.0f, 24.0f);
+    ASSERT_EQ(1u, text.getStats().hits);
+    ASSERT_EQ(1u, text.getStats().misses);
+    ASSERT_EQ(9u, font.getStats().generated);
+    ASSERT_EQ(firstFrame, target.device->getFramebufferHash());
+
+    // 缺失的字符使用替代字形
+    float width, height;
+    text.measureText(font, "\xF0\x9F\x98\x80", 16.0f, width, height);
+    ASSERT_EQ(1u, font.getStats().missing);
+    ASSERT_NEAR(10.0f, width, 0.001f);
+    ASSERT_NEAR(20.0f, height, 0.001f);
+    text.measureText(font, "ab\nabab", 16.0f, width, height);
+    ASSERT_NEAR(40.0f, width, 0.001f);
+    ASSERT_NEAR(40.0f, height, 0.001f);
+}
+
+TEST(Font, UpscaledGlyphsStaySharp) {
+    BlockGlyphSource source;
+    TextTarget target(80, 100);
+    SdfFont font(target.device, 16, 4, 256);
+    font.setSource(&source);
+    TextRenderer text;
+
+    // 16像素生成的方块放大6倍：x ∈ [10, 58)，y ∈ [8.8, 80.8)
+    target.draw(text, font, "A", 4.0f, 4.0f, 96.0f);
+    ASSERT_NEAR(1.0f, target.device->getPixel(34, 45).r, 0.01f);
+    ASSERT_NEAR(0.0f, target.device->getPixel(6, 45).r, 0.01f);
+    ASSERT_NEAR(0.0f, target.device->getPixel(62, 45).r, 0.01f);
+    ASSERT_NEAR(0.0f, target.device->getPixel(34, 4).r, 0.01f);
+
+    // 边缘过渡不超过一个像素，不会像放大位图那样糊成一片
+    int partial = 0;
+    for (int x = 0; x < 80; ++x) {
+        float value = target.device->getPixel(x, 45).r;
+        if (value > 0.05f && value < 0.95f) {
+            partial++;
+        }
+    }
+    ASSERT_TRUE(partial <= 2);
+}
+
+TEST(Font, GlyphsGeneratedMidFrameKeepQueuedTextValid) {
+    BlockGlyphSource source;
+    TextTarget target(96, 64);
+    SdfFont font(target.device, 16, 4, 64);
+    font.setRepackThreshold(0.0f);
+    font.setSource(&source);
+    TextRenderer text;
+    Color white(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // 同一帧内先绘制一行文字，再绘制需要新字形的文字：页面已放不下，需要重新装箱
+    target.renderer->beginRender();
+    target.device->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    text.drawText(*target.renderer, font, "abcdef", 2.0f, 2.0f, 24.0f, white);
+    text.drawText(*target.renderer, font, "宁静", 2.0f, 32.0f, 24.0f, white);
+    target.renderer->endRender();
+
+    // 重新装箱推迟到帧之间，已提交的字形不移动
+    ASSERT_TRUE(font.getAtlas().isRepackPending());
+    ASSERT_EQ(0u, font.getAtlas().getStats().repacks);
+    ASSERT_TRUE(font.getAtlas().getPageCount() > 1);
+
+    // 参考：所有字形预先生成，不在帧内生成
+    TextTarget reference(96, 64);
+    SdfFont preloaded(reference.device, 16, 4, 64);
+    preloaded.setSource(&source);
+    preloaded.preload("abcdef宁静");
+    TextRenderer referenceText;
+    reference.renderer->beginRender();
+    reference.device->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    referenceText.drawText(*reference.renderer, preloaded, "abcdef", 2.0f, 2.0f, 24.0f, white);
+    referenceText.drawText(*reference.renderer, preloaded, "宁静", 2.0f, 32.0f, 24.0f, white);
+    reference.renderer->endRender();
+    ASSERT_EQ(reference.device->getFramebufferHash(), target.device->getFramebufferHash());
+
+    // 帧开始时重新装箱，缓存的字形串按新的UV重新排版；UV量化不同，允许1/255的误差
+    unsigned int generation = font.getGeneration();
+    ASSERT_TRUE(font.repackIfPending());
+    ASSERT_TRUE(font.getGeneration() != generation);
+    target.renderer->beginRender();
+    target.device->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    text.drawText(*target.renderer, font, "abcdef", 2.0f, 2.0f, 24.0f, white);
+    text.drawText(*target.renderer, font, "宁静", 2.0f, 32.0f, 24.0f, white);
+    target.renderer->endRender();
+    ASSERT_EQ(4u, text.getStats().misses);
+    ASSERT_TRUE(maxDifference(*reference.device, *target.device, 96, 64) <= 1.5f / 255.0f);
+}
+
+TEST(Font, SavedGlyphsRenderIdentically) {
+    BlockGlyphSource source;
+    TextTarget generated(160, 48);
+    SdfFont font(generated.device, 16, 4, 256);
+    font.setSource(&source);
+    ASSERT_EQ(6u, font.preload("宁静湖畔钓鱼宁静"));
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(font.saveToMemory(data));
+
+    // 离线生成的数据加载后无需字形来源
+    TextTarget loaded(160, 48);
+    SdfFont offline(loaded.device, 32, 4, 256);
+    ASSERT_FALSE(offline.loadFromMemory(data.data(), data.size() - 1));
+    ASSERT_TRUE(offline.loadFromMemory(data.data(), data.size()));
+    ASSERT_EQ(16, offline.getBaseSize());
+    ASSERT_EQ(6u, offline.getStats().glyphs);
+    ASSERT_EQ(0u, offline.getStats().generated);
+
+    TextRenderer text;
+    generated.draw(text, font, "钓鱼 宁静湖畔", 4.0f, 4.0f, 20.0f);
+    loaded.draw(text, offline, "钓鱼 宁静湖畔", 4.0f, 4.0f, 20.0f);
+    ASSERT_EQ(generated.device->getFramebufferHash(), loaded.device->getFramebufferHash());
+}
+
+TEST(Font, EvictsLeastRecentlyUsedRuns) {
+    BlockGlyphSource source;
+    TextTarget target(64, 64);
+    SdfFont font(target.device, 16, 4, 256);
+    font.setSource(&source);
+    TextRenderer text(2);
+
+    float width, height;
+    text.measureText(font, "a", 16.0f, width, height);
+    text.measureText(font, "b", 16.0f, width, height);
+    text.measureText(font, "a", 16.0f, width, height);
+    text.measureText(font, "c", 16.0f, width, height);
+    ASSERT_EQ(1u, text.getStats().hits);
+    ASSERT_EQ(1u, text.getStats().evictions);
+    ASSERT_EQ(2u, text.getStats().runs);
+
+    // "b"最久未使用被淘汰；字号不同是不同的字形串
+    text.measureText(font, "a", 16.0f, width, height);
+    text.measureText(font, "b", 16.0f, width, height);
+    text.measureText(font, "b", 20.0f, width, height);
+    ASSERT_EQ(2u, text.getStats().hits);
+    ASSERT_EQ(5u, text.getStats().misses);
+}
+
+}
@@ -0,0 +1,90 @@
+#include "fishing/test/TestFramework.h"
+#include "core/FrameArena.h"
+#include "core/GameLoop.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+using namespace Appgame;
+
+TEST_SUITE(FrameArena) {
+
+TEST(FrameArena, AllocationsAreAlignedAndResetReusesMemory) {
+    FrameArena arena(1024);
+
+    char* first = static_cast<char*>(arena.allocate(3, 1));
+    double* second = arena.allocateArray<double>(4);
+    ASSERT_NOT_NULL(first);
+    ASSERT_EQ(0u, static_cast<unsigned int>(reinterpret_cast<uintptr_t>(second) % alignof(double)));
+    ASSERT_TRUE(arena.getUsed() >= 3 + 4 * sizeof(double));
+
+    arena.reset();
+    ASSERT_EQ(0u, static_cast<unsigned int>(arena.getUsed()));
+    ASSERT_TRUE(arena.allocate(3, 1) == first);
+}
+
+TEST(FrameArena, OverflowGrowsCapacityOnReset) {
+    FrameArena arena(256);
+
+    void* large = arena.allocate(1000);
+    ASSERT_NOT_NULL(large);
+    ASSERT_EQ(1u, static_cast<unsigned int>(arena.getOverflowCount()));
+    ASSERT_TRUE(arena.getPeakUsed() >= 1000u);
+
+    // 重置后主缓冲区按峰值扩容，同样的分配不再溢出
+    arena.reset();
+    ASSERT_TRUE(arena.getCapacity() >= 1000u);
+    arena.allocate(1000);
+    ASSERT_EQ(1u, static_cast<unsigned int>(arena.getOverflowCount()));
+}
+
+TEST(FrameArena, ScratchScopeAndContainers) {
+    FrameArena arena(4096);
+    arena.allocate(16);
+    size_t usedBefore = arena.getUsed();
+
+    {
+        ScratchScope scratch(arena);
+        FrameVector<int> values{ArenaAllocator<int>(&scratch.getArena())};
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        ASSERT_EQ(99, values.back());
+
+        FrameString text("帧内存字符串，长度超过短字符串优化", ArenaAllocator<char>(&arena));
+        text += "追加";
+        ASSERT_TRUE(arena.getUsed() > usedBefore);
+    }
+
+    // 作用域结束后回滚
+    ASSERT_EQ(static_cast<unsigned int>(usedBefore), static_cast<unsigned int>(arena.getUsed()));
+}
+
+TEST(FrameArena, HeapStatsCountAllocations) {
+    HeapStats before = getHeapStats();
+    std::unique_ptr<int> value(new int(42));
+    HeapStats after = getHeapStats();
+
+    if (isHeapTrackingEnabled()) {
+        ASSERT_TRUE(after.allocations > before.allocations);
+        ASSERT_TRUE(after.bytes >= before.bytes + sizeof(int));
+    } else {
+        ASSERT_EQ(before.allocations, after.allocations);
+    }
+}
+
+TEST(FrameArena, GameLoopResetsArenaEachStep) {
+    GameLoop gameLoop;
+    size_t maxUsedAtStepStart = 0;
+    gameLoop.setUpdateCallback([&](float) {
+        FrameArena& arena = gameLoop.getFrameArena();
+        maxUsedAtStepStart = std::max(maxUsedAtStepStart, arena.getUsed());
+        arena.allocate(128);
+    });
+
+    gameLoop.advance(10);
+    ASSERT_EQ(0u, static_cast<unsigned int>(maxUsedAtStepStart));
+    ASSERT_TRUE(gameLoop.getFrameArena().getPeakUsed() >= 128u);
+}
+
+}
@@ -0,0 +1,414 @@
+#include "fishing/test/TestFramework.h"
+#include "core/GameLoop.h"
+#include "core/FrameHistogram.h"
+#include "core/FramePacer.h"
+#include "core/TripleBuffer.h"
+#include "core/UpdateGovernor.h"
+#include <atomic>
+#include <thread>
+
+using namespace Appgame;
+
+TEST_SUITE(GameLoop) {
+
+TEST(GameLoop, HistogramPercentiles) {
+    FrameTimeHistogram histogram;
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(static_cast<float>(i) * 0.1f);
+    }
+
+    ASSERT_EQ(1000u, static_cast<unsigned int>(histogram.getCount()));
+    ASSERT_NEAR(50.0f, histogram.getPercentile(50.0f), 50.0f * 0.04f);
+    ASSERT_NEAR(90.0f, histogram.getPercentile(90.0f), 90.0f * 0.04f);
+    ASSERT_NEAR(99.0f, histogram.getPercentile(99.0f), 99.0f * 0.04f);
+    ASSERT_NEAR(100.0f, histogram.getPercentile(100.0f), 0.01f);
+    ASSERT_NEAR(0.1f, histogram.getMin(), 0.001f);
+    ASSERT_NEAR(50.05f, histogram.getMean(), 0.01f);
+}
+
+TEST(GameLoop, HistogramCatchesRareSpike) {
+    FrameTimeHistogram histogram;
+    for (int i = 0; i < 999; ++i) {
+        histogram.record(16.0f);
+    }
+    histogram.record(120.0f);
+
+    ASSERT_NEAR(16.0f, histogram.getPercentile(99.0f), 16.0f * 0.04f);
+    ASSERT_NEAR(120.0f, histogram.getPercentile(100.0f), 0.01f);
+
+    histogram.reset();
+    ASSERT_EQ(0u, static_cast<unsigned int>(histogram.getCount()));
+    ASSERT_NEAR(0.0f, histogram.getPercentile(99.0f), 0.0001f);
+}
+
+TEST(GameLoop, DetailedStatsSeparatePhases) {
+    GameLoop gameLoop;
+    gameLoop.setTimeStepMode(GameLoop::TimeStepMode::VARIABLE);
+    gameLoop.setTargetFPS(200);
+    gameLoop.setFrameBudget(1.0f);
+
+    int frames = 0;
+    gameLoop.setUpdateCallback([](float) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    gameLoop.setRenderCallback([&](float) {
+        if (++frames >= 5) {
+            gameLoop.stop();
+        }
+    });
+    gameLoop.start();
+
+    GameLoop::DetailedStats stats = gameLoop.getDetailedStats();
+    ASSERT_EQ(5u, static_cast<unsigned int>(stats.frameCount));
+    ASSERT_EQ(5u, static_cast<unsigned int>(stats.spikeCount));
+    ASSERT_TRUE(stats.update.average >= 2.0f);
+    ASSERT_TRUE(stats.render.average < stats.update.average);
+    ASSERT_TRUE(stats.p50FrameTime >= 2.0f);
+    ASSERT_TRUE(stats.p999FrameTime >= stats.p50FrameTime);
+
+    gameLoop.resetDetailedStats();
+    ASSERT_EQ(0u, static_cast<unsigned int>(gameLoop.getDetailedStats().frameCount));
+}
+
+TEST(GameLoop, PacerReachesDeadline) {
+    FramePacer pacer;
+    const FramePacer::Mode modes[] = { FramePacer::Mode::SLEEP, FramePacer::Mode::HYBRID, FramePacer::Mode::BUSY };
+
+    for (FramePacer::Mode mode : modes) {
+        pacer.setMode(mode);
+        pacer.resetStats();
+        for (int i = 0; i < 3; ++i) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(4);
+            pacer.waitUntil(deadline);
+            ASSERT_TRUE(std::chrono::steady_clock::now() >= deadline);
+        }
+
+        FramePacer::Stats stats = pacer.getStats();
+        ASSERT_EQ(3u, static_cast<unsigned int>(stats.waitCount));
+        ASSERT_TRUE(stats.avgError >= 0.0f);
+        ASSERT_TRUE(stats.maxError >= stats.avgError);
+    }
+
+    // 已过期的截止时间不等待也不计入统计
+    pacer.waitUntil(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+    ASSERT_EQ(3u, static_cast<unsigned int>(pacer.getStats().waitCount));
+}
+
+TEST(GameLoop, HeadlessAdvanceSkipsRenderAndSleep) {
+    GameLoop gameLoop;
+    gameLoop.setFixedTimeStep(0.01f);
+
+    int updates = 0;
+    int renders = 0;
+    float lastDelta = 0.0f;
+    gameLoop.setUpdateCallback([&](float deltaTime) {
+        updates++;
+        lastDelta = deltaTime;
+    });
+    gameLoop.setRenderCallback([&](float) { renders++; });
+
+    GameLoop::HeadlessStats stats = gameLoop.advance(500);
+    ASSERT_EQ(500, updates);
+    ASSERT_EQ(0, renders);
+    ASSERT_NEAR(0.01f, lastDelta, 1e-6f);
+    ASSERT_NEAR(5.0, stats.simulatedSeconds, 1e-4);
+    // 5秒模拟时间远快于实时完成
+    ASSERT_TRUE(stats.wallSeconds < 1.0);
+    ASSERT_TRUE(stats.simSecondsPerWallSecond > 5.0);
+
+    stats = gameLoop.runFor(1.0);
+    ASSERT_EQ(100u, static_cast<unsigned int>(stats.steps));
+    ASSERT_EQ(600u, static_cast<unsigned int>(gameLoop.getHeadlessStats().steps));
+}
+
+TEST(GameLoop, HeadlessStopEndsEarly) {
+    GameLoop gameLoop;
+    int updates = 0;
+    gameLoop.setUpdateCallback([&](float) {
+        if (++updates == 10) {
+            gameLoop.stop();
+        }
+    });
+
+    GameLoop::HeadlessStats stats = gameLoop.advance(1000);
+    ASSERT_EQ(10u, static_cast<unsigned int>(stats.steps));
+}
+
+TEST(GameLoop, TripleBufferReturnsLatestSnapshot) {
+    TripleBuffer<int> buffer;
+    ASSERT_FALSE(buffer.hasNewData());
+
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    buffer.getWriteBuffer() = 2;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.hasNewData());
+    ASSERT_EQ(2, buffer.acquire());
+    ASSERT_FALSE(buffer.hasNewData());
+    ASSERT_EQ(2, buffer.acquire());
+}
+
+TEST(GameLoop, PipelinedRenderRunsOnRenderThread) {
+    GameLoop gameLoop;
+    gameLoop.setTimeStepMode(GameLoop::TimeStepMode::VARIABLE);
+    gameLoop.setTargetFPS(500);
+    gameLoop.setPipelinedRender(true);
+
+    TripleBuffer<int> snapshots;
+    std::thread::id updateThread = std::this_thread::get_id();
+    std::atomic<bool> renderedOnOtherThread(true);
+    std::atomic<bool> snapshotsInOrder(true);
+    std::atomic<int> renders(0);
+    int frame = 0;
+    int lastSeen = 0;
+
+    gameLoop.setUpdateCallback([&](float) {
+        if (++frame >= 20) {
+            gameLoop.stop();
+        }
+    });
+    gameLoop.setPublishCallback([&](float) {
+        snapshots.getWriteBuffer() = frame;
+        snapshots.publish();
+    });
+    gameLoop.setRenderCallback([&](float) {
+        if (std::this_thread::get_id() == updateThread) {
+            renderedOnOtherThread = false;
+        }
+        int seen = snapshots.acquire();
+        if (seen < lastSeen) {
+            snapshotsInOrder = false;
+        }
+        lastSeen = seen;
+        renders++;
+    });
+    gameLoop.start();
+
+    // start()返回时渲染线程已结束，最后一帧也已渲染
+    ASSERT_EQ(20, renders.load());
+    ASSERT_EQ(20, lastSeen);
+    ASSERT_TRUE(renderedOnOtherThread.load());
+    ASSERT_TRUE(snapshotsInOrder.load());
+}
+
+TEST(GameLoop, GovernorCapsCatchUpAndRecovers) {
+    UpdateGovernor governor;
+    governor.setMaxCatchUpSteps(3);
+    governor.setRecoveryFrames(10);
+
+    std::vector<UpdateGovernor::OverloadLevel> levels;
+    governor.addOverloadCallback([&](UpdateGovernor::OverloadLevel level) { levels.push_back(level); });
+
+    // 积压10步，只允许执行3步，其余丢弃但保留相位
+    const float step = 0.01f;
+    float accumulator = 10.5f * step;
+    int steps = governor.beginFrame(accumulator, step);
+    ASSERT_EQ(3, steps);
+    ASSERT_NEAR(3.5f * step, accumulator, 1e-5f);
+    governor.endFrame(steps, step, 40.0f);
+    ASSERT_TRUE(governor.getOverloadLevel() == UpdateGovernor::OverloadLevel::SEVERE);
+
+    UpdateGovernor::Stats stats = governor.getStats();
+    ASSERT_EQ(7u, static_cast<unsigned int>(stats.droppedSteps));
+    ASSERT_EQ(1u, static_cast<unsigned int>(stats.cappedFrames));
+
+    // 负载恢复后逐级下降，每级至少等待recoveryFrames帧
+    for (int i = 0; i < 200; ++i) {
+        accumulator = step;
+        governor.endFrame(governor.beginFrame(accumulator, step), step, 1.0f);
+    }
+    ASSERT_TRUE(governor.getOverloadLevel() == UpdateGovernor::OverloadLevel::NONE);
+    ASSERT_EQ(3u, static_cast<unsigned int>(levels.size()));
+    ASSERT_TRUE(levels[1] == UpdateGovernor::OverloadLevel::MODERATE);
+}
+
+TEST(GameLoop, GovernorCallbacksMayUnsubscribeDuringDispatch) {
+    UpdateGovernor governor;
+    governor.setMaxCatchUpSteps(1);
+    governor.setRecoveryFrames(1);
+
+    // 回调中移除自身并添加新的订阅
+    int firstCalls = 0;
+    int secondCalls = 0;
+    int addedCalls = 0;
+    UpdateGovernor::CallbackID first = 0;
+    first = governor.addOverloadCallback([&](UpdateGovernor::OverloadLevel) {
+        firstCalls++;
+        governor.removeOverloadCallback(first);
+        governor.addOverloadCallback([&](UpdateGovernor::OverloadLevel) { addedCalls++; });
+    });
+    governor.addOverloadCallback([&](UpdateGovernor::OverloadLevel) { secondCalls++; });
+
+    const float step = 0.01f;
+    float accumulator = 5.0f * step;
+    governor.endFrame(governor.beginFrame(accumulator, step), step, 40.0f);
+    ASSERT_TRUE(governor.getOverloadLevel() == UpdateGovernor::OverloadLevel::SEVERE);
+    ASSERT_EQ(1, firstCalls);
+    ASSERT_EQ(1, secondCalls);
+    ASSERT_EQ(0, addedCalls);
+
+    for (int i = 0; i < 200 && governor.getOverloadLevel() == UpdateGovernor::OverloadLevel::SEVERE; ++i) {
+        accumulator = step;
+        governor.endFrame(governor.beginFrame(accumulator, step), step, 1.0f);
+    }
+    ASSERT_TRUE(governor.getOverloadLevel() != UpdateGovernor::OverloadLevel::SEVERE);
+    ASSERT_EQ(1, firstCalls);
+    ASSERT_EQ(2, secondCalls);
+    ASSERT_EQ(1, addedCalls);
+}
+
+TEST(GameLoop, SlowUpdateDoesNotSpiral) {
+    GameLoop gameLoop;
+    gameLoop.setFixedTimeStep(1.0f / 120.0f);
+    gameLoop.setTargetFPS(60);
+    gameLoop.getUpdateGovernor().setMaxCatchUpSteps(2);
+
+    UpdateGovernor::OverloadLevel signalled = UpdateGovernor::OverloadLevel::NONE;
+    gameLoop.getUpdateGovernor().addOverloadCallback([&](UpdateGovernor::OverloadLevel level) { signalled = level; });
+
+    // 每步更新耗时超过步长，不加限制时积压会越来越多
+    int frames = 0;
+    gameLoop.setUpdateCallback([](float) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(12));
+    });
+    gameLoop.setRenderCallback([&](float) {
+        if (++frames >= 10) {
+            gameLoop.stop();
+        }
+    });
+    gameLoop.start();
+
+    UpdateGovernor::Stats stats = gameLoop.getDetailedStats().governor;
+    ASSERT_TRUE(stats.maxSteps <= 2);
+    ASSERT_TRUE(stats.droppedSteps > 0u);
+    ASSERT_TRUE(stats.load > 1.0f);
+    ASSERT_TRUE(signalled == UpdateGovernor::OverloadLevel::SEVERE);
+}
+
+TEST(GameLoop, PausedLoopBlocksUntilWoken) {
+    GameLoop gameLoop;
+    gameLoop.setTargetFPS(120);
+    gameLoop.setIdleTimeout(0.05f);
+
+    std::atomic<int> frames(0);
+    std::atomic<int> idleCallbacks(0);
+    gameLoop.setRenderCallback([&](float) { frames++; });
+    gameLoop.setIdleCallback([&]() { idleCallbacks++; });
+
+    std::thread loopThread([&]() { gameLoop.start(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gameLoop.pause();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // 暂停期间不渲染
+    int pausedFrames = frames.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    int framesWhilePaused = frames.load() - pausedFrames;
+
+    // 请求重绘：空闲期间只渲染一帧
+    gameLoop.requestRedraw();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    int redrawFrames = frames.load() - pausedFrames;
+
+    gameLoop.resume();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int resumedFrames = frames.load() - pausedFrames;
+
+    // 空闲时stop()立即唤醒并退出
+    gameLoop.setIdle(true);
+    gameLoop.setIdleTimeout(0.0f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    std::chrono::steady_clock::time_point stopStart = std::chrono::steady_clock::now();
+    gameLoop.stop();
+    loopThread.join();
+    ASSERT_TRUE(std::chrono::steady_clock::now() - stopStart < std::chrono::milliseconds(100));
+    ASSERT_EQ(0, framesWhilePaused);
+    ASSERT_EQ(1, redrawFrames);
+    ASSERT_TRUE(resumedFrames > 1);
+
+    GameLoop::IdleStats stats = gameLoop.getIdleStats();
+    ASSERT_TRUE(stats.timerWakeups >= 3u && stats.timerWakeups <= 10u);
+    ASSERT_TRUE(stats.explicitWakeups >= 2u);
+    ASSERT_EQ(1u, static_cast<unsigned int>(stats.redraws));
+    ASSERT_EQ(static_cast<int>(stats.wakeups), idleCallbacks.load() + 1);
+    ASSERT_TRUE(stats.idleSeconds >= 0.3);
+    ASSERT_TRUE(stats.cpuUsage < 0.2f);
+}
+
+
+TEST(GameLoop, WakeOutsideIdleIsIgnored) {
+    GameLoop gameLoop;
+    gameLoop.setTargetFPS(120);
+    gameLoop.setIdleTimeout(0.2f);
+
+    std::atomic<int> frames(0);
+    std::atomic<int> idleCallbacks(0);
+    gameLoop.setRenderCallback([&](float) { frames++; });
+    gameLoop.setIdleCallback([&]() { idleCallbacks++; });
+
+    std::thread loopThread([&]() { gameLoop.start(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // 运行中的唤醒与重绘请求不留到之后的空闲等待
+    gameLoop.wake();
+    gameLoop.requestRedraw();
+    gameLoop.resume();
+    gameLoop.setIdle(false);
+    gameLoop.setIdle(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    int idleWakeups = idleCallbacks.load();
+    int idleFrames = frames.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    idleFrames = frames.load() - idleFrames;
+
+    gameLoop.stop();
+    loopThread.join();
+    ASSERT_EQ(0, idleWakeups);
+    ASSERT_EQ(0, idleFrames);
+    ASSERT_EQ(0u, static_cast<unsigned int>(gameLoop.getIdleStats().redraws));
+}
+
+
+TEST(GameLoop, IdlesWhileIdleConditionHolds) {
+    GameLoop gameLoop;
+    gameLoop.setTargetFPS(120);
+    gameLoop.setIdleTimeout(0.02f);
+
+    // 模拟场景管理器：主菜单（静态界面）期间空闲，空闲回调处理消息时切换到游戏场景
+    std::atomic<bool> staticScene(true);
+    std::atomic<bool> leaveMenu(false);
+    std::atomic<int> updates(0);
+    std::atomic<int> frames(0);
+    gameLoop.setIdleCondition([&]() { return staticScene.load(); });
+    gameLoop.setUpdateCallback([&](float) { updates++; });
+    gameLoop.setRenderCallback([&](float) { frames++; });
+    std::atomic<int> idleCallbacks(0);
+    gameLoop.setIdleCallback([&]() {
+        idleCallbacks++;
+        if (leaveMenu.load()) {
+            staticScene = false;
+        }
+    });
+
+    std::thread loopThread([&]() { gameLoop.start(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    int menuUpdates = updates.load();
+    int menuFrames = frames.load();
+    int menuWakeups = idleCallbacks.load();
+
+    leaveMenu = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    bool idleAfterLeaving = gameLoop.isIdle();
+    int gameFrames = frames.load();
+
+    gameLoop.stop();
+    loopThread.join();
+    ASSERT_EQ(0, menuUpdates);
+    ASSERT_EQ(0, menuFrames);
+    ASSERT_TRUE(menuWakeups >= 2);
+    ASSERT_FALSE(idleAfterLeaving);
+    ASSERT_TRUE(gameFrames > 1);
+}
+
+}
@@ -0,0 +1,107 @@
+#include "fishing/test/TestFramework.h"
+#include "core/JobSystem.h"
+#include "core/GameLoop.h"
+#include <atomic>
+#include <vector>
+
+using namespace Appgame;
+
+TEST_SUITE(JobSystem) {
+
+TEST(JobSystem, ScheduleAndWait) {
+    JobSystem jobSystem;
+    ASSERT_TRUE(jobSystem.init(4));
+    ASSERT_EQ(4u, jobSystem.getWorkerCount());
+
+    std::atomic<int> value(0);
+    JobHandle handle = jobSystem.schedule([&value]() { value = 42; });
+    jobSystem.wait(handle);
+
+    ASSERT_TRUE(handle.isComplete());
+    ASSERT_EQ(42, value.load());
+
+    jobSystem.cleanup();
+}
+
+TEST(JobSystem, DependenciesRunInOrder) {
+    JobSystem jobSystem;
+    jobSystem.init(4);
+
+    std::atomic<int> step(0);
+    std::atomic<bool> orderCorrect(true);
+
+    JobHandle first = jobSystem.schedule([&]() {
+        if (step.fetch_add(1) != 0) orderCorrect = false;
+    });
+    JobHandle second = jobSystem.schedule([&]() {
+        if (step.fetch_add(1) != 1) orderCorrect = false;
+    }, {first});
+    JobHandle third = jobSystem.schedule([&]() {
+        if (step.fetch_add(1) != 2) orderCorrect = false;
+    }, {first, second});
+    jobSystem.wait(third);
+
+    ASSERT_EQ(3, step.load());
+    ASSERT_TRUE(orderCorrect.load());
+
+    jobSystem.cleanup();
+}
+
+TEST(JobSystem, ParallelForCoversRange) {
+    JobSystem jobSystem;
+    jobSystem.init(4);
+
+    const size_t count = 10000;
+    std::vector<int> hits(count, 0);
+    JobHandle handle = jobSystem.parallelFor(count, 64, [&hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hits[i]++;
+        }
+    });
+    jobSystem.wait(handle);
+
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(1, hits[i]);
+    }
+
+    jobSystem.cleanup();
+}
+
+TEST(JobSystem, RunsInlineWithoutInit) {
+    JobSystem jobSystem;
+
+    int value = 0;
+    JobHandle handle = jobSystem.schedule([&value]() { value = 7; });
+
+    ASSERT_TRUE(handle.isComplete());
+    ASSERT_EQ(7, value);
+}
+
+TEST(JobSystem, GameLoopSystemGraph) {
+    JobSystem jobSystem;
+    jobSystem.init(4);
+
+    GameLoop gameLoop;
+    std::atomic<int> fishUpdated(0);
+    std::atomic<int> physicsAfterFish(0);
+
+    int fish = gameLoop.addSystem("FishManager", [&](float) { fishUpdated = 1; });
+    int physics = gameLoop.addSystem("PhysicsManager", [&](float) {
+        physicsAfterFish = fishUpdated.load();
+    }, {fish});
+    ASSERT_TRUE(physics > fish);
+
+    // 依赖尚未注册的系统是无效的
+    ASSERT_EQ(-1, gameLoop.addSystem("Invalid", [](float) {}, {5}));
+
+    gameLoop.setJobSystem(&jobSystem);
+    gameLoop.setFixedTimeStep(1.0f / 60.0f);
+    gameLoop.setUpdateCallback([&gameLoop](float) { gameLoop.stop(); });
+    gameLoop.start();
+
+    ASSERT_EQ(1, physicsAfterFish.load());
+
+    jobSystem.cleanup();
+}
+
+}
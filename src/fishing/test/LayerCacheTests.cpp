@@ -0,0 +1,132 @@
+#include "fishing/test/TestFramework.h"
+#include "core/LayerCache.h"
+#include "core/SoftwareGraphics.h"
+#include <memory>
+
+using namespace Appgame;
+
+namespace {
+
+// 不支持渲染目标的设备，用于检查直接绘制的回退路径
+class NoTargetDevice : public SoftwareGraphicsDevice {
+public:
+    NoTargetDevice(int width, int height) : SoftwareGraphicsDevice(width, height) {}
+
+    DeviceCapabilities getCapabilities() const override {
+        DeviceCapabilities capabilities = SoftwareGraphicsDevice::getCapabilities();
+        capabilities.renderTargets = false;
+        return capabilities;
+    }
+};
+
+// 模拟钓鱼点背景：天空、水面和几条水纹
+void drawBackground(Renderer& renderer, float originX, float originY) {
+    renderer.drawRect(Rect(originX, originY, 64.0f, 20.0f), Color(0.4f, 0.6f, 0.9f, 1.0f));
+    renderer.drawRect(Rect(originX, originY + 20.0f, 64.0f, 28.0f), Color(0.1f, 0.3f, 0.5f, 1.0f));
+    for (int i = 0; i < 4; ++i) {
+        float y = originY + 24.0f + static_cast<float>(i) * 6.0f;
+        renderer.drawLine(originX + 4.0f, y, originX + 60.0f, y, 2.0f, Color(0.8f, 0.9f, 1.0f, 1.0f));
+    }
+}
+
+} // namespace
+
+TEST_SUITE(LayerCache) {
+
+TEST(LayerCache, RenderTargetReceivesDrawsAndRestoresFramebuffer) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(32, 32);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+    ASSERT_TRUE(softwareDevice->getCapabilities().renderTargets);
+
+    SoftwareTexture target;
+    ASSERT_TRUE(target.create(8, 4));
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawRect(Rect(0.0f, 0.0f, 4.0f, 4.0f), Color(0.0f, 0.0f, 1.0f, 1.0f));
+    ASSERT_TRUE(renderer.setTargetTexture(&target));
+    ASSERT_EQ(8, softwareDevice->getWidth());
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 0.0f));
+    renderer.drawRect(Rect(2.0f, 0.0f, 4.0f, 4.0f), Color(1.0f, 0.0f, 0.0f, 1.0f));
+    ASSERT_TRUE(renderer.setTargetTexture(nullptr));
+    renderer.endRender();
+
+    // 目标纹理只包含切换后的绘制
+    ASSERT_EQ(32, softwareDevice->getWidth());
+    ASSERT_NEAR(0.0f, target.sample(0.5f / 8.0f, 0.5f).a, 0.01f);
+    ASSERT_NEAR(1.0f, target.sample(3.5f / 8.0f, 0.5f).r, 0.01f);
+
+    // 切换前排队的绘制落在主帧缓冲，且主帧缓冲内容被保留
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(1, 1).b, 0.01f);
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(5, 1).r, 0.01f);
+}
+
+TEST(LayerCache, RebuildsOnlyWhenKeyChanges) {
+    auto direct = std::make_unique<SoftwareGraphicsDevice>(96, 64);
+    SoftwareGraphicsDevice* directDevice = direct.get();
+    Renderer directRenderer(std::move(direct));
+    ASSERT_TRUE(directRenderer.init());
+    directRenderer.beginRender();
+    directDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    drawBackground(directRenderer, 16.0f, 8.0f);
+    directRenderer.endRender();
+
+    auto cached = std::make_unique<SoftwareGraphicsDevice>(96, 64);
+    SoftwareGraphicsDevice* cachedDevice = cached.get();
+    Renderer renderer(std::move(cached));
+    ASSERT_TRUE(renderer.init());
+
+    LayerCache cache;
+    int layerDraws = 0;
+    LayerCache::DrawFunction drawLayer = [&layerDraws](Renderer& target, float originX, float originY) {
+        layerDraws++;
+        drawBackground(target, originX, originY);
+    };
+
+    for (int frame = 0; frame < 5; ++frame) {
+        // 第3帧起天气变化，缓存键改变
+        uint64_t key = frame < 3 ? 1 : 2;
+        renderer.beginRender();
+        cachedDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        cache.draw(renderer, key, Rect(16.0f, 8.0f, 64.0f, 48.0f), drawLayer);
+        renderer.endRender();
+
+        // 重新合成的帧额外提交图层本身的6个四边形，其余帧只提交一个缓存四边形
+        bool rebuilt = frame == 0 || frame == 3;
+        ASSERT_EQ(rebuilt ? 7u : 1u, renderer.getRenderStats().quads);
+        ASSERT_EQ(directDevice->getFramebufferHash(), cachedDevice->getFramebufferHash());
+    }
+
+    ASSERT_EQ(2, layerDraws);
+    ASSERT_EQ(2u, cache.getStats().rebuilds);
+    ASSERT_EQ(3u, cache.getStats().hits);
+    ASSERT_TRUE(cache.isValid(2));
+
+    cache.invalidate();
+    ASSERT_FALSE(cache.isValid(2));
+    ASSERT_TRUE(cache.getTexture() == nullptr);
+}
+
+TEST(LayerCache, FallsBackToDirectDrawingWithoutRenderTargets) {
+    auto device = std::make_unique<NoTargetDevice>(96, 64);
+    NoTargetDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+
+    LayerCache cache;
+    for (int frame = 0; frame < 2; ++frame) {
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        cache.draw(renderer, 1, Rect(16.0f, 8.0f, 64.0f, 48.0f), drawBackground);
+        renderer.endRender();
+        ASSERT_EQ(6u, renderer.getRenderStats().quads);
+    }
+
+    ASSERT_EQ(0u, cache.getStats().rebuilds);
+    ASSERT_EQ(2u, cache.getStats().fallbacks);
+    ASSERT_FALSE(cache.isValid(1));
+}
+
+}
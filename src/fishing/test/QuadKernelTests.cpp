@@ -0,0 +1,191 @@
+#include "fishing/test/TestFramework.h"
+#include "core/QuadKernel.h"
+#include "core/SoftwareGraphics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+// 生成确定性的测试实例（数量故意不是内核宽度的整数倍）
+std::vector<SpriteInstance> makeInstances(size_t count) {
+    std::vector<SpriteInstance> instances(count);
+    for (size_t i = 0; i < count; ++i) {
+        SpriteInstance& instance = instances[i];
+        instance.x = static_cast<float>(i % 17) * 30.0f;
+        instance.y = static_cast<float>(i % 11) * 20.0f;
+        instance.width = 8.0f + static_cast<float>(i % 5) * 4.0f;
+        instance.height = 6.0f + static_cast<float>(i % 3) * 5.0f;
+        instance.rotation = static_cast<float>(i) * 0.37f - 20.0f;
+        instance.u0 = 0.0f;
+        instance.v0 = 0.0f;
+        instance.u1 = 1.0f;
+        instance.v1 = 1.0f;
+        instance.color = Color(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    return instances;
+}
+
+} // namespace
+
+TEST_SUITE(QuadKernel) {
+
+TEST(QuadKernel, FastSinCosIsAccurate) {
+    float maxError = 0.0f;
+    for (int i = -20000; i <= 20000; ++i) {
+        float angle = static_cast<float>(i) * 0.005f;
+        float sine, cosine;
+        fastSinCos(angle, sine, cosine);
+        maxError = std::max(maxError, std::fabs(sine - std::sin(angle)));
+        maxError = std::max(maxError, std::fabs(cosine - std::cos(angle)));
+    }
+    ASSERT_TRUE(maxError < 1e-5f);
+
+    float sine, cosine;
+    fastSinCos(0.0f, sine, cosine);
+    ASSERT_EQ(0.0f, sine);
+    ASSERT_EQ(1.0f, cosine);
+}
+
+TEST(QuadKernel, SimdMatchesScalar) {
+    std::vector<SpriteInstance> instances = makeInstances(103);
+    std::vector<float> simd(instances.size() * 8);
+    std::vector<float> scalar(instances.size() * 8);
+    transformSprites(instances.data(), instances.size(), simd.data());
+    transformSpritesScalar(instances.data(), instances.size(), scalar.data());
+    for (size_t i = 0; i < simd.size(); ++i) {
+        ASSERT_NEAR(scalar[i], simd[i], 1e-3f);
+    }
+
+    // 旋转后四边形仍以实例中心为中心
+    const float* quad = &simd[5 * 8];
+    ASSERT_NEAR(instances[5].x, (quad[0] + quad[6]) * 0.5f, 1e-3f);
+    ASSERT_NEAR(instances[5].y, (quad[1] + quad[7]) * 0.5f, 1e-3f);
+
+    std::vector<LineInstance> lines(13);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        lines[i] = {static_cast<float>(i), 0.0f, static_cast<float>(i) + 10.0f, static_cast<float>(i % 4) * 3.0f, 2.0f, Color()};
+    }
+    lines[6] = {5.0f, 5.0f, 5.0f, 5.0f, 2.0f, Color()};
+    std::vector<float> lineSimd(lines.size() * 8);
+    std::vector<float> lineScalar(lines.size() * 8);
+    transformLines(lines.data(), lines.size(), lineSimd.data());
+    transformLinesScalar(lines.data(), lines.size(), lineScalar.data());
+    for (size_t i = 0; i < lineSimd.size(); ++i) {
+        ASSERT_NEAR(lineScalar[i], lineSimd[i], 1e-3f);
+    }
+
+    // 长度为0的线段退化为一个点，不产生NaN
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_NEAR(5.0f, lineSimd[6 * 8 + i], 1e-6f);
+    }
+}
+
+TEST(QuadKernel, DrawSpritesMatchesDrawSprite) {
+    uint32_t white = 0xFFFFFFFFu;
+    SoftwareTexture texture;
+    texture.create(1, 1, &white);
+    std::vector<SpriteInstance> instances = makeInstances(37);
+
+    std::vector<uint32_t> frames[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(512, 256);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        if (pass == 0) {
+            for (const SpriteInstance& instance : instances) {
+                Rect dstRect(instance.x - instance.width * 0.5f, instance.y - instance.height * 0.5f, instance.width, instance.height);
+                renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), dstRect, instance.rotation);
+            }
+        } else {
+            renderer.drawSprites(texture, instances.data(), instances.size());
+        }
+        ASSERT_EQ(37u, renderer.getRenderStats().quads);
+        renderer.endRender();
+
+        frames[pass].assign(softwareDevice->getPixels(), softwareDevice->getPixels() + 512 * 256);
+    }
+
+    // 顶点只有舍入级别的差异，覆盖的像素最多相差极少数
+    size_t differences = 0;
+    for (size_t i = 0; i < frames[0].size(); ++i) {
+        if (frames[0][i] != frames[1][i]) {
+            differences++;
+        }
+    }
+    ASSERT_TRUE(differences <= 4);
+}
+
+TEST(QuadKernel, InstancedSpritesMatchCpuExpansion) {
+    uint32_t pixels[4] = {0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0x80FFFFFFu};
+    SoftwareTexture texture;
+    texture.create(2, 2, pixels);
+    std::vector<SpriteInstance> instances = makeInstances(53);
+    for (size_t i = 0; i < instances.size(); ++i) {
+        instances[i].u1 = 0.5f + static_cast<float>(i % 3) * 0.25f;
+        instances[i].color = Color(1.0f, 0.8f, 0.6f, 0.5f + static_cast<float>(i % 2) * 0.5f);
+    }
+
+    std::vector<uint32_t> frames[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(512, 256);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+        renderer.setInstancingEnabled(pass == 0);
+        ASSERT_EQ(pass == 0, renderer.isInstancingActive());
+
+        // 实例与逐顶点四边形交错提交，同一纹理内仍按提交顺序绘制
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 0.0f, 200.0f, 100.0f));
+        renderer.drawSprites(texture, instances.data(), instances.size());
+        renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(100.0f, 50.0f, 200.0f, 100.0f), 0.0f, Color(0.2f, 0.4f, 1.0f, 1.0f));
+        renderer.endRender();
+
+        const RenderStats& stats = renderer.getRenderStats();
+        ASSERT_EQ(55u, stats.quads);
+        ASSERT_EQ(220u, stats.vertices);
+        ASSERT_EQ(110u, stats.triangles);
+        ASSERT_TRUE(stats.flushTime >= 0.0f);
+        if (pass == 0) {
+            ASSERT_EQ(53u, stats.instances);
+            ASSERT_EQ(3u, stats.batches);
+            ASSERT_EQ(2u, stats.breaks[static_cast<int>(BatchBreak::INSTANCING)]);
+            // 2个逐顶点四边形的顶点和索引加53个32字节的实例
+            ASSERT_EQ(12u, stats.indices);
+            ASSERT_EQ(8u * 36u + 12u * 4u + 53u * 32u, stats.uploadBytes);
+        } else {
+            ASSERT_EQ(0u, stats.instances);
+            ASSERT_EQ(1u, stats.batches);
+            ASSERT_EQ(330u, stats.indices);
+            ASSERT_EQ(220u * 36u + 330u * 4u, stats.uploadBytes);
+        }
+
+        frames[pass].assign(softwareDevice->getPixels(), softwareDevice->getPixels() + 512 * 256);
+    }
+
+    // 实例的颜色与UV经过量化，误差不超过2级；覆盖像素只有舍入级别的差异
+    size_t differences = 0;
+    for (size_t i = 0; i < frames[0].size(); ++i) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int a = static_cast<int>((frames[0][i] >> shift) & 0xFF);
+            int b = static_cast<int>((frames[1][i] >> shift) & 0xFF);
+            if (std::abs(a - b) > 2) {
+                differences++;
+                break;
+            }
+        }
+    }
+    ASSERT_TRUE(differences <= 4);
+}
+
+}
@@ -0,0 +1,165 @@
+#include "fishing/test/TestFramework.h"
+#include "fishing/systems/QualityController.h"
+#include "core/Graphics.h"
+
+using namespace FishingGame;
+
+namespace {
+
+GameConfig makeHighConfig() {
+    GameConfig config = GameConfig();
+    config.framerateLimit = 60;
+    config.enableParticles = true;
+    config.enableShadows = true;
+    config.enableBloom = true;
+    config.textureQuality = 2;
+    config.shadowQuality = 2;
+    config.antiAliasing = 4;
+    return config;
+}
+
+// 以固定帧时间喂入若干个完整窗口
+void feedWindows(QualityController& controller, float32 frameTime, int32 windows) {
+    for (int32 i = 0; i < windows * 10; ++i) {
+        controller.recordFrame(frameTime);
+    }
+}
+
+} // namespace
+
+TEST_SUITE(QualityController) {
+
+TEST(QualityController, DowngradesInOrderWhenOverBudget) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+    controller.setWindowFrames(10);
+
+    std::vector<QualityChangeEvent> events;
+    controller.addQualityCallback([&](const QualityChangeEvent& event) { events.push_back(event); });
+
+    // 25ms远超60fps预算：每两个窗口降一级（变化后冷却一个窗口）
+    feedWindows(controller, 25.0f, 2);
+    ASSERT_EQ(1u, static_cast<unsigned int>(events.size()));
+    ASSERT_FALSE(controller.getConfig().enableBloom);
+    ASSERT_EQ(4, controller.getConfig().antiAliasing);
+    ASSERT_EQ(controller.getMaxQualityLevel() - 1, events[0].level);
+
+    feedWindows(controller, 25.0f, 40);
+    ASSERT_EQ(0, controller.getQualityLevel());
+    ASSERT_FALSE(controller.getConfig().enableShadows);
+    ASSERT_FALSE(controller.getConfig().enableParticles);
+    ASSERT_EQ(0, controller.getConfig().antiAliasing);
+    ASSERT_EQ(1, controller.getConfig().textureQuality);
+    ASSERT_NEAR(0.25f, controller.getDetailScale(), 1e-5f);
+}
+
+TEST(QualityController, HysteresisHoldsAndRecovers) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+    controller.setWindowFrames(10);
+    controller.setQualityLevel(3);
+
+    // 处于回差区间（目标的70%-100%）时保持不变
+    feedWindows(controller, 14.0f, 20);
+    ASSERT_EQ(3, controller.getQualityLevel());
+
+    // 明显低于目标时逐级恢复
+    feedWindows(controller, 5.0f, 100);
+    ASSERT_EQ(controller.getMaxQualityLevel(), controller.getQualityLevel());
+    ASSERT_TRUE(controller.getConfig().enableBloom);
+    ASSERT_EQ(4, controller.getConfig().antiAliasing);
+}
+
+TEST(QualityController, FailedUpgradeBacksOff) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+    controller.setWindowFrames(10);
+    controller.setQualityLevel(3);
+
+    // 升级后立即超时，升级所需窗口数加倍
+    feedWindows(controller, 5.0f, 4);
+    ASSERT_EQ(4, controller.getQualityLevel());
+    feedWindows(controller, 25.0f, 2);
+    ASSERT_EQ(3, controller.getQualityLevel());
+    ASSERT_EQ(6, controller.getStats().upgradeWindows);
+}
+
+TEST(QualityController, BaseConfigResetNotifiesSubscribers) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+    controller.setQualityLevel(2);
+
+    std::vector<QualityChangeEvent> events;
+    controller.addQualityCallback([&](const QualityChangeEvent& event) { events.push_back(event); });
+
+    // 降级后重新设置基础画质，订阅者收到恢复到最高画质的事件
+    controller.setBaseConfig(makeHighConfig());
+    ASSERT_EQ(1u, static_cast<unsigned int>(events.size()));
+    ASSERT_EQ(2, events[0].previousLevel);
+    ASSERT_EQ(controller.getMaxQualityLevel(), events[0].level);
+    ASSERT_TRUE(events[0].config.enableBloom);
+    ASSERT_EQ(4, events[0].config.antiAliasing);
+
+    // 等级和设置都没有变化时不通知，设置变化时通知
+    controller.setBaseConfig(makeHighConfig());
+    ASSERT_EQ(1u, static_cast<unsigned int>(events.size()));
+    GameConfig lowConfig = makeHighConfig();
+    lowConfig.enableShadows = false;
+    controller.setBaseConfig(lowConfig);
+    ASSERT_EQ(2u, static_cast<unsigned int>(events.size()));
+    ASSERT_FALSE(events[1].config.enableShadows);
+}
+
+TEST(QualityController, CallbacksMayUnsubscribeDuringDispatch) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+
+    // 回调中移除自身并添加新的订阅
+    int32 firstCalls = 0;
+    int32 secondCalls = 0;
+    int32 addedCalls = 0;
+    QualityController::CallbackID first = 0;
+    first = controller.addQualityCallback([&](const QualityChangeEvent&) {
+        firstCalls++;
+        controller.removeQualityCallback(first);
+        controller.addQualityCallback([&](const QualityChangeEvent&) { addedCalls++; });
+    });
+    controller.addQualityCallback([&](const QualityChangeEvent&) { secondCalls++; });
+
+    controller.setQualityLevel(5);
+    ASSERT_EQ(1, firstCalls);
+    ASSERT_EQ(1, secondCalls);
+    ASSERT_EQ(0, addedCalls);
+
+    controller.setQualityLevel(4);
+    ASSERT_EQ(1, firstCalls);
+    ASSERT_EQ(2, secondCalls);
+    ASSERT_EQ(1, addedCalls);
+}
+
+TEST(QualityController, PublishesPerformanceData) {
+    QualityController controller;
+    controller.setBaseConfig(makeHighConfig());
+    controller.setWindowFrames(10);
+
+    // 帧时间在10ms和20ms之间交替
+    for (int32 i = 0; i < 10; ++i) {
+        controller.recordFrame(i % 2 == 0 ? 10.0f : 20.0f);
+    }
+    Appgame::RenderStats stats = Appgame::RenderStats();
+    stats.batches = 12;
+    stats.vertices = 400;
+    stats.triangles = 200;
+    controller.recordRenderStats(stats);
+
+    const PerformanceData& data = controller.getPerformanceData();
+    ASSERT_NEAR(1000.0f / 15.0f, data.averageFramerate, 0.5f);
+    ASSERT_NEAR(50.0f, data.minimumFramerate, 0.5f);
+    ASSERT_NEAR(100.0f, data.maximumFramerate, 0.5f);
+    ASSERT_NEAR(20.0f, data.frameTime, 0.001f);
+    ASSERT_NEAR(12.0f, data.drawCalls, 0.001f);
+    ASSERT_NEAR(200.0f, data.triangles, 0.001f);
+    ASSERT_NEAR(400.0f, data.vertices, 0.001f);
+}
+
+}
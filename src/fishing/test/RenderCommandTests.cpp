@@ -0,0 +1,147 @@
+#include "fishing/test/TestFramework.h"
+#include "core/RenderCommand.h"
+#include "core/SoftwareGraphics.h"
+#include "core/JobSystem.h"
+#include <memory>
+
+using namespace Appgame;
+
+namespace {
+
+// 在一个缓冲区中录制一组场景内容，group区分不同的子系统
+void recordGroup(RenderCommandBuffer& buffer, int group, const Texture& texture) {
+    buffer.setLayer(group % 2);
+    for (int i = 0; i < 40; ++i) {
+        float x = static_cast<float>((i * 37 + group * 53) % 220);
+        float y = static_cast<float>((i * 19 + group * 29) % 150);
+        buffer.setDepth(y);
+        if (i % 3 == 0) {
+            buffer.drawRect(Rect(x, y, 24.0f, 16.0f), Color(0.2f * group, 0.5f, 1.0f - 0.2f * group, 0.6f));
+        } else if (i % 3 == 1) {
+            buffer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(x, y, 20.0f, 20.0f), 0.1f * i, Color(1.0f, 1.0f, 1.0f, 0.8f));
+        } else {
+            buffer.drawLine(x, y, x + 30.0f, y + 10.0f, 2.0f, Color(1.0f, 0.8f, 0.1f, 1.0f));
+        }
+    }
+}
+
+} // namespace
+
+TEST_SUITE(RenderCommand) {
+
+TEST(RenderCommand, SortKeyOrdersLayerTranslucencyAndDepth) {
+    // 图层优先，其次不透明先于半透明
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(-1, true, 100.0f, 5) < RenderCommandBuffer::makeSortKey(0, false, -100.0f, 0));
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, false, 100.0f, 5) < RenderCommandBuffer::makeSortKey(0, true, -100.0f, 0));
+
+    // 半透明按深度排序（含负数），深度相同时按材质
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, true, -2.0f, 9) < RenderCommandBuffer::makeSortKey(0, true, -1.0f, 0));
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, true, 0.5f, 9) < RenderCommandBuffer::makeSortKey(0, true, 1.5f, 0));
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, true, 1.0f, 1) < RenderCommandBuffer::makeSortKey(0, true, 1.0f, 2));
+
+    // 不透明按材质分组，材质相同时按深度
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, false, 50.0f, 1) < RenderCommandBuffer::makeSortKey(0, false, 1.0f, 2));
+    ASSERT_TRUE(RenderCommandBuffer::makeSortKey(0, false, 1.0f, 2) < RenderCommandBuffer::makeSortKey(0, false, 2.0f, 2));
+}
+
+TEST(RenderCommand, ReplaysInSortedOrder) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(32, 32);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+
+    RenderCommandQueue queue;
+    RenderCommandBuffer& scene = queue.createBuffer();
+    RenderCommandBuffer& effects = queue.createBuffer();
+
+    // 后录制但深度更小的命令先绘制；低图层的命令即使最后录制也在最下面
+    effects.setDepth(2.0f);
+    effects.drawRect(Rect(0.0f, 0.0f, 16.0f, 16.0f), Color(1.0f, 0.0f, 0.0f, 1.0f));
+    scene.setDepth(1.0f);
+    scene.drawRect(Rect(0.0f, 0.0f, 16.0f, 16.0f), Color(0.0f, 0.0f, 1.0f, 1.0f));
+    scene.setLayer(-1);
+    scene.drawRect(Rect(0.0f, 0.0f, 32.0f, 32.0f), Color(0.0f, 1.0f, 0.0f, 1.0f));
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    queue.execute(renderer);
+    ASSERT_EQ(3u, queue.getLastCommandCount());
+    ASSERT_EQ(1u, queue.getLastMaterialCount());
+    ASSERT_EQ(0u, scene.getCommands().size());
+    renderer.endRender();
+
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(8, 8).r, 0.01f);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(24, 24).g, 0.01f);
+}
+
+TEST(RenderCommand, OpaqueCommandsGroupByMaterial) {
+    uint32_t white = 0xFFFFFFFFu;
+    SoftwareTexture first;
+    SoftwareTexture second;
+    first.create(1, 1, &white);
+    second.create(1, 1, &white);
+
+    Renderer renderer(std::make_unique<SoftwareGraphicsDevice>(64, 64));
+    ASSERT_TRUE(renderer.init());
+
+    RenderCommandQueue queue;
+    RenderCommandBuffer& buffer = queue.createBuffer();
+    buffer.setTranslucent(false);
+    for (int i = 0; i < 10; ++i) {
+        buffer.setDepth(static_cast<float>(i));
+        buffer.drawSprite(i % 2 ? first : second, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(i * 6.0f, 0.0f, 6.0f, 6.0f));
+    }
+
+    renderer.beginRender();
+    queue.execute(renderer);
+    ASSERT_EQ(10u, renderer.getRenderStats().quads);
+    ASSERT_EQ(2u, renderer.getRenderStats().batches);
+    renderer.endRender();
+}
+
+TEST(RenderCommand, ParallelRecordingIsDeterministic) {
+    uint32_t pixels[4] = {0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0x80FFFFFFu};
+    SoftwareTexture texture;
+    texture.create(2, 2, pixels);
+
+    JobSystem jobSystem;
+    ASSERT_TRUE(jobSystem.init(3));
+
+    uint64_t hashes[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(256, 192);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+
+        RenderCommandQueue queue;
+        for (int group = 0; group < 4; ++group) {
+            queue.createBuffer();
+        }
+
+        // 第一次在工作线程上并行录制，第二次在本线程上倒序录制
+        if (pass == 0) {
+            jobSystem.wait(jobSystem.parallelFor(4, 1, [&](size_t begin, size_t end) {
+                for (size_t group = begin; group < end; ++group) {
+                    recordGroup(queue.getBuffer(group), static_cast<int>(group), texture);
+                }
+            }));
+        } else {
+            for (int group = 3; group >= 0; --group) {
+                recordGroup(queue.getBuffer(group), group, texture);
+            }
+        }
+
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        queue.execute(renderer);
+        ASSERT_EQ(160u, queue.getLastCommandCount());
+        renderer.endRender();
+        hashes[pass] = softwareDevice->getFramebufferHash();
+    }
+    jobSystem.cleanup();
+
+    ASSERT_EQ(hashes[0], hashes[1]);
+}
+
+}
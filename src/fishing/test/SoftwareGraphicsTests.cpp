@@ -0,0 +1,410 @@
+#include "fishing/test/TestFramework.h"
+#include "core/SoftwareGraphics.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+// 绘制一组半透明、带纹理和旋转的精灵，返回帧缓冲区哈希
+uint64_t renderScene(JobSystem* jobSystem) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(256, 192);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    softwareDevice->setJobSystem(jobSystem);
+
+    Renderer renderer(std::move(device));
+    if (!renderer.init()) {
+        return 0;
+    }
+
+    uint32_t checker[4] = {0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0x80FFFFFFu};
+    SoftwareTexture texture;
+    texture.create(2, 2, checker);
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.1f, 0.2f, 0.3f, 1.0f));
+    for (int i = 0; i < 200; ++i) {
+        float x = static_cast<float>((i * 37) % 240);
+        float y = static_cast<float>((i * 53) % 180);
+        Color color(0.2f + (i % 5) * 0.2f, 1.0f, 0.5f, 0.25f + (i % 4) * 0.25f);
+        if (i % 3 == 0) {
+            renderer.drawRect(Rect(x - 10.0f, y - 10.0f, 40.0f, 30.0f), color);
+        } else {
+            renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(x, y, 48.0f, 32.0f), i * 0.1f, color);
+        }
+    }
+    renderer.endRender();
+    return softwareDevice->getFramebufferHash();
+}
+
+// 记录uniform块上传次数的着色器
+class CountingShader : public SoftwareShader {
+public:
+    CountingShader() : blockUploads(0), blockResolves(0) {}
+
+    UniformHandle resolveBlock(const std::string& name) override {
+        blockResolves++;
+        return SoftwareShader::resolveBlock(name);
+    }
+
+    void setUniformBlock(UniformHandle handle, const void* data, size_t size) override {
+        blockUploads++;
+        SoftwareShader::setUniformBlock(handle, data, size);
+    }
+
+    int blockUploads;
+    int blockResolves;
+};
+
+// 记录每次drawIndexed的纹理和各四边形左上角x坐标（标识提交的四边形）的设备
+class RecordingDevice : public SoftwareGraphicsDevice {
+public:
+    struct Draw {
+        const Texture* texture;
+        std::vector<float> quads;
+    };
+
+    RecordingDevice(int width, int height) : SoftwareGraphicsDevice(width, height) {}
+
+    using SoftwareGraphicsDevice::drawIndexed;
+    void drawIndexed(const void* vertices, const VertexFormat& format, size_t vertexCount, const unsigned int* indices, size_t indexCount, const Texture* texture) override {
+        Draw draw;
+        draw.texture = texture;
+        for (size_t i = 0; i < indexCount; i += 6) {
+            draw.quads.push_back(static_cast<const Vertex*>(vertices)[indices[i]].x);
+        }
+        draws.push_back(draw);
+        SoftwareGraphicsDevice::drawIndexed(vertices, format, vertexCount, indices, indexCount, texture);
+    }
+
+    std::vector<Draw> draws;
+};
+
+} // namespace
+
+TEST_SUITE(SoftwareGraphics) {
+
+TEST(SoftwareGraphics, FillsQuadsWithTopLeftRule) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(64, 48);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawRect(Rect(10.0f, 10.0f, 20.0f, 20.0f), Color(1.0f, 0.0f, 0.0f, 1.0f));
+    // 半透明矩形的对角共享边上不能重复混合
+    renderer.drawRect(Rect(40.0f, 10.0f, 16.0f, 16.0f), Color(1.0f, 1.0f, 1.0f, 0.5f));
+    renderer.endRender();
+
+    // 20x20 + 16x16个像素，两个三角形的共享边只写一次
+    ASSERT_EQ(400u + 256u, softwareDevice->getStats().pixels);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(10, 10).r, 0.001f);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(29, 29).r, 0.001f);
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(30, 30).r, 0.001f);
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(9, 20).r, 0.001f);
+
+    float blended = softwareDevice->getPixel(40, 10).g;
+    ASSERT_NEAR(0.5f, blended, 0.01f);
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_NEAR(blended, softwareDevice->getPixel(40 + i, 10 + i).g, 0.0001f);
+        ASSERT_NEAR(blended, softwareDevice->getPixel(55 - i, 10 + i).g, 0.0001f);
+    }
+}
+
+TEST(SoftwareGraphics, SamplesTexturesBilinearly) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(64, 16);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+
+    // 左黑右白的2x1纹理，拉伸后应为水平渐变
+    uint32_t pixels[2] = {0xFF000000u, 0xFFFFFFFFu};
+    SoftwareTexture texture;
+    ASSERT_TRUE(texture.create(2, 1, pixels));
+    ASSERT_NEAR(0.5f, texture.sample(0.5f, 0.5f).r, 0.001f);
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 1.0f, 1.0f));
+    renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 0.0f, 64.0f, 16.0f));
+    renderer.endRender();
+
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(0, 8).r, 0.01f);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(63, 8).r, 0.01f);
+    ASSERT_NEAR(0.5f, softwareDevice->getPixel(32, 8).r, 0.02f);
+    for (int x = 1; x < 64; ++x) {
+        ASSERT_TRUE(softwareDevice->getPixel(x, 8).r >= softwareDevice->getPixel(x - 1, 8).r);
+    }
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(32, 8).b - softwareDevice->getPixel(32, 8).r, 0.001f);
+}
+
+TEST(SoftwareGraphics, ParallelTilesMatchSerial) {
+    uint64_t serial = renderScene(nullptr);
+    ASSERT_TRUE(serial != 0);
+
+    JobSystem jobSystem;
+    ASSERT_TRUE(jobSystem.init(4));
+    uint64_t parallel = renderScene(&jobSystem);
+    jobSystem.cleanup();
+
+    ASSERT_EQ(serial, parallel);
+    ASSERT_EQ(serial, renderScene(nullptr));
+}
+
+TEST(SoftwareGraphics, CompactVertexFormatMatchesStandard) {
+    ASSERT_EQ(16u, static_cast<unsigned int>(sizeof(PackedVertex)));
+    ASSERT_EQ(16u, VertexFormat::compact().stride);
+    ASSERT_EQ(static_cast<unsigned int>(sizeof(Vertex)), VertexFormat::standard().stride);
+
+    PackedVertex packed = {3.0f, 4.0f, PackedVertex::packUnorm16(1.0f), PackedVertex::packUnorm16(0.5f),
+                           PackedVertex::packColor(Color(1.0f, 0.0f, 0.2f, 0.5f))};
+    Vertex decoded = VertexFormat::compact().decode(&packed, 0);
+    ASSERT_NEAR(3.0f, decoded.x, 0.0001f);
+    ASSERT_NEAR(1.0f, decoded.u, 0.0001f);
+    ASSERT_NEAR(0.5f, decoded.v, 0.0001f);
+    ASSERT_NEAR(0.2f, decoded.color.b, 0.003f);
+
+    uint32_t pixels[4] = {0xFF0000FFu, 0xFF00FF00u, 0xFFFF0000u, 0x80FFFFFFu};
+    SoftwareTexture texture;
+    texture.create(2, 2, pixels);
+
+    std::vector<uint32_t> frames[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(96, 64);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+        ASSERT_TRUE(renderer.setVertexFormat(pass == 0 ? VertexFormat::standard() : VertexFormat::compact()));
+
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.drawSprite(texture, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(8.0f, 8.0f, 64.0f, 40.0f), 0.3f, Color(1.0f, 0.8f, 0.6f, 0.9f));
+        renderer.drawRect(Rect(30.0f, 20.0f, 50.0f, 30.0f), Color(0.3f, 0.6f, 0.9f, 0.4f));
+        renderer.drawLine(0.0f, 60.0f, 90.0f, 5.0f, 3.0f, Color(1.0f, 1.0f, 0.0f, 1.0f));
+        renderer.endRender();
+
+        frames[pass].assign(softwareDevice->getPixels(), softwareDevice->getPixels() + 96 * 64);
+    }
+
+    // 颜色与UV量化带来的误差不超过2级
+    int maxDifference = 0;
+    for (size_t i = 0; i < frames[0].size(); ++i) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int a = static_cast<int>((frames[0][i] >> shift) & 0xFF);
+            int b = static_cast<int>((frames[1][i] >> shift) & 0xFF);
+            maxDifference = std::max(maxDifference, std::abs(a - b));
+        }
+    }
+    ASSERT_TRUE(maxDifference <= 2);
+}
+
+TEST(SoftwareGraphics, ScreenshotRoundTrip) {
+    SoftwareGraphicsDevice device(8, 4);
+    ASSERT_TRUE(device.init());
+    device.clear(Color(0.0f, 1.0f, 0.0f, 1.0f));
+
+    const char* path = "software_graphics_test.ppm";
+    ASSERT_TRUE(device.saveToFile(path));
+
+    SoftwareTexture texture;
+    ASSERT_TRUE(texture.loadFromFile(path));
+    std::remove(path);
+
+    ASSERT_EQ(8, texture.getWidth());
+    ASSERT_EQ(4, texture.getHeight());
+    ASSERT_EQ(0xFF00FF00u, texture.getPixels()[0]);
+    ASSERT_FALSE(texture.loadFromMemory("P3\n1 1\n255\n", 11));
+}
+
+TEST(SoftwareGraphics, PolylineJoinsSegmentsInOneBatch) {
+    auto device = std::make_unique<SoftwareGraphicsDevice>(64, 64);
+    SoftwareGraphicsDevice* softwareDevice = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+    Color red(1.0f, 0.0f, 0.0f, 1.0f);
+
+    // 共线的折线（含重合点）与同样大小的矩形覆盖相同的像素
+    float straight[8] = {8.0f, 32.0f, 32.0f, 32.0f, 32.0f, 32.0f, 56.0f, 32.0f};
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawPolyline(straight, 4, PolylineStyle(8.0f, Color(1.0f, 1.0f, 1.0f, 0.5f)));
+    renderer.endRender();
+    ASSERT_EQ(2u, renderer.getRenderStats().quads);
+    ASSERT_EQ(48u * 8u, softwareDevice->getStats().pixels);
+
+    // 长度为0的线段和折线不绘制
+    float point[4] = {5.0f, 5.0f, 5.0f, 5.0f};
+    renderer.beginRender();
+    renderer.drawLine(5.0f, 5.0f, 5.0f, 5.0f, 2.0f, red);
+    renderer.drawPolyline(point, 2, PolylineStyle(2.0f, red));
+    renderer.endRender();
+    ASSERT_EQ(0u, renderer.getRenderStats().quads);
+
+    // 直角拐弯：尖角填满外侧角，斜角切掉外侧角并多一个三角形
+    float corner[6] = {16.0f, 48.0f, 16.0f, 16.0f, 48.0f, 16.0f};
+    for (int pass = 0; pass < 2; ++pass) {
+        PolylineStyle style(8.0f, red);
+        style.join = pass == 0 ? LineJoin::MITER : LineJoin::BEVEL;
+        renderer.beginRender();
+        softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+        renderer.drawPolyline(corner, 3, style);
+        renderer.endRender();
+        ASSERT_EQ(pass == 0 ? 2u : 3u, renderer.getRenderStats().quads);
+        ASSERT_NEAR(pass == 0 ? 1.0f : 0.0f, softwareDevice->getPixel(13, 13).r, 0.001f);
+        ASSERT_NEAR(1.0f, softwareDevice->getPixel(18, 18).r, 0.001f);
+        ASSERT_NEAR(1.0f, softwareDevice->getPixel(17, 13).r, 0.001f);
+    }
+
+    // 128个节点的曲线在一个批次内提交，起点宽、终点细
+    std::vector<float> curve;
+    for (int i = 0; i < 128; ++i) {
+        float t = static_cast<float>(i) / 127.0f;
+        curve.push_back(8.0f + t * 48.0f);
+        curve.push_back(32.0f + 16.0f * std::sin(t * 6.0f));
+    }
+    PolylineStyle tapered(6.0f, red);
+    tapered.endWidth = 0.5f;
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawPolyline(curve.data(), 128, tapered);
+    renderer.endRender();
+    ASSERT_EQ(127u, renderer.getRenderStats().quads);
+    ASSERT_EQ(1u, renderer.getRenderStats().batches);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(8, 34).r, 0.001f);
+    int endY = static_cast<int>(32.0f + 16.0f * std::sin(6.0f));
+    ASSERT_NEAR(0.0f, softwareDevice->getPixel(55, endY + 2).r, 0.001f);
+}
+
+TEST(SoftwareGraphics, SortsBatchesStablyAndCountsBreaks) {
+    auto device = std::make_unique<RecordingDevice>(128, 32);
+    RecordingDevice* recorder = device.get();
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+
+    uint32_t white = 0xFFFFFFFFu;
+    SoftwareTexture textureA;
+    SoftwareTexture textureB;
+    textureA.create(1, 1, &white);
+    textureB.create(1, 1, &white);
+    SoftwareShader shader;
+    Rect src(0.0f, 0.0f, 1.0f, 1.0f);
+
+    // 图层1中A、B交替，图层0在后面提交，最后切换着色器
+    renderer.beginRender();
+    renderer.setLayer(1);
+    renderer.drawSprite(textureA, src, Rect(10.0f, 0.0f, 4.0f, 4.0f));
+    renderer.drawSprite(textureB, src, Rect(20.0f, 0.0f, 4.0f, 4.0f));
+    renderer.drawSprite(textureA, src, Rect(30.0f, 0.0f, 4.0f, 4.0f));
+    renderer.drawSprite(textureB, src, Rect(40.0f, 0.0f, 4.0f, 4.0f));
+    renderer.setLayer(0);
+    renderer.drawSprite(textureA, src, Rect(50.0f, 0.0f, 4.0f, 4.0f));
+    renderer.setLayer(1);
+    renderer.setShader(&shader);
+    renderer.drawSprite(textureA, src, Rect(60.0f, 0.0f, 4.0f, 4.0f));
+    renderer.setShader(nullptr);
+
+    // 状态变化只拆分批次，不提前刷新
+    ASSERT_EQ(0u, renderer.getRenderStats().flushes);
+    ASSERT_EQ(0u, static_cast<unsigned int>(recorder->draws.size()));
+    renderer.endRender();
+
+    const RenderStats& stats = renderer.getRenderStats();
+    ASSERT_EQ(1u, stats.flushes);
+    ASSERT_EQ(4u, stats.batches);
+    ASSERT_EQ(1u, stats.breaks[static_cast<int>(BatchBreak::LAYER)]);
+    ASSERT_EQ(1u, stats.breaks[static_cast<int>(BatchBreak::TEXTURE)]);
+    ASSERT_EQ(1u, stats.breaks[static_cast<int>(BatchBreak::SHADER)]);
+    ASSERT_EQ(0u, stats.breaks[static_cast<int>(BatchBreak::CAPACITY)]);
+
+    // 按(图层, 着色器, 纹理)排序，排序键相同的四边形保持提交顺序
+    ASSERT_EQ(4u, static_cast<unsigned int>(recorder->draws.size()));
+    const float expected[4][2] = {{50.0f, -1.0f}, {10.0f, 30.0f}, {20.0f, 40.0f}, {60.0f, -1.0f}};
+    const Texture* expectedTextures[4] = {&textureA, &textureA, &textureB, &textureA};
+    for (int i = 0; i < 4; ++i) {
+        const RecordingDevice::Draw& draw = recorder->draws[i];
+        ASSERT_TRUE(draw.texture == expectedTextures[i]);
+        ASSERT_EQ(expected[i][1] < 0.0f ? 1u : 2u, static_cast<unsigned int>(draw.quads.size()));
+        for (size_t j = 0; j < draw.quads.size(); ++j) {
+            ASSERT_NEAR(expected[i][j], draw.quads[j], 0.001f);
+        }
+    }
+
+    // 缓冲区满时才提前刷新，每次记为容量中断，顺序不变
+    recorder->draws.clear();
+    renderer.setBatchCapacity(3);
+    renderer.beginRender();
+    for (int i = 0; i < 7; ++i) {
+        renderer.drawSprite(textureA, src, Rect(static_cast<float>(i * 10), 8.0f, 4.0f, 4.0f));
+        ASSERT_EQ(static_cast<unsigned int>(i / 3), renderer.getRenderStats().flushes);
+    }
+    renderer.endRender();
+    ASSERT_EQ(3u, renderer.getRenderStats().flushes);
+    ASSERT_EQ(3u, renderer.getRenderStats().batches);
+    ASSERT_EQ(2u, renderer.getRenderStats().breaks[static_cast<int>(BatchBreak::CAPACITY)]);
+    ASSERT_EQ(0u, renderer.getRenderStats().breaks[static_cast<int>(BatchBreak::TEXTURE)]);
+    std::vector<float> order;
+    for (const RecordingDevice::Draw& draw : recorder->draws) {
+        order.insert(order.end(), draw.quads.begin(), draw.quads.end());
+    }
+    ASSERT_EQ(7u, static_cast<unsigned int>(order.size()));
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_NEAR(static_cast<float>(i * 10), order[i], 0.001f);
+    }
+}
+
+TEST(SoftwareGraphics, UniformHandlesAndFrameBlock) {
+    SoftwareShader shader;
+    UniformHandle tint = shader.resolve("tint");
+    ASSERT_TRUE(tint.isValid());
+    ASSERT_EQ(tint.index, shader.resolve("tint").index);
+    ASSERT_TRUE(shader.getUniform("tint") == nullptr);
+
+    // 按句柄与按名称设置的是同一个uniform，无效句柄被忽略
+    shader.setUniform4f(tint, 1.0f, 0.5f, 0.25f, 1.0f);
+    ASSERT_NEAR(0.5f, shader.getUniform("tint")[1], 0.0001f);
+    shader.setUniform1f("tint", 2.0f);
+    ASSERT_NEAR(2.0f, shader.getUniform("tint")[0], 0.0001f);
+    shader.setUniform1f(UniformHandle(), 3.0f);
+    ASSERT_NEAR(2.0f, shader.getUniform("tint")[0], 0.0001f);
+
+    auto device = std::make_unique<SoftwareGraphicsDevice>(32, 32);
+    Renderer renderer(std::move(device));
+    ASSERT_TRUE(renderer.init());
+    renderer.setBatchCapacity(1);
+    CountingShader shaders[2];
+
+    FrameUniforms uniforms;
+    uniforms.tint[0] = 0.8f;
+    uniforms.time = 12.5f;
+    for (int frame = 0; frame < 2; ++frame) {
+        renderer.beginRender();
+        renderer.setFrameUniforms(uniforms);
+        // 每个四边形单独刷新，每次刷新都重新绑定着色器
+        for (int i = 0; i < 6; ++i) {
+            renderer.setShader(&shaders[i % 2]);
+            renderer.drawRect(Rect(static_cast<float>(i), 0.0f, 4.0f, 4.0f), Color(1.0f, 1.0f, 1.0f, 1.0f));
+        }
+        renderer.endRender();
+    }
+
+    // 每帧每个着色器只上传一次，uniform块在分配槽位时解析，不随每次绑定重复解析
+    ASSERT_EQ(2, shaders[0].blockUploads);
+    ASSERT_EQ(2, shaders[1].blockUploads);
+    ASSERT_EQ(2, shaders[0].blockResolves);
+    ASSERT_EQ(2, shaders[1].blockResolves);
+    size_t size = 0;
+    const FrameUniforms* uploaded = static_cast<const FrameUniforms*>(shaders[1].getUniformBlock(FRAME_UNIFORMS_BLOCK, &size));
+    ASSERT_TRUE(uploaded != nullptr);
+    ASSERT_EQ(sizeof(FrameUniforms), size);
+    ASSERT_NEAR(0.8f, uploaded->tint[0], 0.0001f);
+    ASSERT_NEAR(12.5f, uploaded->time, 0.0001f);
+    ASSERT_NEAR(1.0f, uploaded->projection[15], 0.0001f);
+}
+
+}
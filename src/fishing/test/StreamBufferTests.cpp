@@ -0,0 +1,152 @@
+#include "fishing/test/TestFramework.h"
+#include "core/StreamBuffer.h"
+#include "core/SoftwareGraphics.h"
+#include <memory>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+struct WrittenFrame {
+    FenceID fence;
+    std::vector<const uint8_t*> regions;
+    std::vector<size_t> sizes;
+    uint8_t value;
+};
+
+// 围栏未完成的帧写入的数据必须保持不变
+bool inFlightDataIntact(const SoftwareGraphicsDevice& device, const std::vector<WrittenFrame>& frames) {
+    for (const WrittenFrame& frame : frames) {
+        if (device.isFenceSignaled(frame.fence)) {
+            continue;
+        }
+        for (size_t i = 0; i < frame.regions.size(); ++i) {
+            for (size_t j = 0; j < frame.sizes[i]; ++j) {
+                if (frame.regions[i][j] != frame.value) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_SUITE(StreamBuffer) {
+
+TEST(StreamBuffer, NeverOverwritesInFlightFrames) {
+    SoftwareGraphicsDevice device(8, 8);
+    ASSERT_TRUE(device.init());
+    // GPU落后3帧，缓冲区只能容纳约两帧的数据，必然绕回到在途数据
+    device.setFrameLatency(3);
+    StreamBuffer ring(&device, 4096, 3);
+
+    std::vector<WrittenFrame> frames;
+    std::vector<uint8_t> data;
+    for (int frame = 0; frame < 40; ++frame) {
+        WrittenFrame written;
+        written.fence = static_cast<FenceID>(frame + 1);
+        written.value = static_cast<uint8_t>(frame + 1);
+        for (int draw = 0; draw < 3; ++draw) {
+            size_t size = 200 + static_cast<size_t>((frame * 37 + draw * 101) % 500);
+            data.assign(size, written.value);
+            const uint8_t* region = static_cast<const uint8_t*>(ring.write(data.data(), size));
+            ASSERT_TRUE(region != nullptr);
+            ASSERT_TRUE(region >= ring.getData() && region + size <= ring.getData() + ring.getCapacity());
+            written.regions.push_back(region);
+            written.sizes.push_back(size);
+            ASSERT_TRUE(inFlightDataIntact(device, frames));
+        }
+        frames.push_back(written);
+        ring.endFrame();
+        ASSERT_TRUE(ring.getStats().framesInFlight <= 3);
+        device.swapBuffers();
+    }
+
+    const StreamBuffer::Stats& stats = ring.getStats();
+    ASSERT_EQ(120u, stats.allocations);
+    ASSERT_TRUE(stats.wraps > 0);
+    ASSERT_TRUE(stats.stalls > 0);
+    ASSERT_EQ(0u, stats.overflows);
+
+    // 超出容量的单帧数据分配失败
+    size_t offset = 0;
+    ASSERT_TRUE(ring.allocate(8192, 16, offset) == nullptr);
+    ASSERT_EQ(1u, ring.getStats().overflows);
+}
+
+TEST(StreamBuffer, NoStallsWhenFencesKeepUp) {
+    SoftwareGraphicsDevice device(8, 8);
+    ASSERT_TRUE(device.init());
+    StreamBuffer ring(&device, 4096, 2);
+
+    std::vector<uint8_t> data(700, 1);
+    for (int frame = 0; frame < 20; ++frame) {
+        for (int draw = 0; draw < 2; ++draw) {
+            ASSERT_TRUE(ring.write(data.data(), data.size()) != nullptr);
+        }
+        ring.endFrame();
+        device.swapBuffers();
+    }
+    ASSERT_TRUE(ring.getStats().wraps > 0);
+    ASSERT_EQ(0u, ring.getStats().stalls);
+    ASSERT_EQ(0u, ring.getStats().framesInFlight);
+}
+
+TEST(StreamBuffer, RendererStreamsBatchesWithoutChangingOutput) {
+    uint32_t white = 0xFFFFFFFFu;
+    SoftwareTexture texture;
+    texture.create(1, 1, &white);
+
+    std::vector<SpriteInstance> sprites(100);
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        SpriteInstance& sprite = sprites[i];
+        sprite.x = static_cast<float>(i % 10) * 12.0f + 6.0f;
+        sprite.y = static_cast<float>(i / 10) * 12.0f + 6.0f;
+        sprite.width = 10.0f;
+        sprite.height = 8.0f;
+        sprite.rotation = 0.1f * static_cast<float>(i);
+        sprite.u0 = 0.0f;
+        sprite.v0 = 0.0f;
+        sprite.u1 = 1.0f;
+        sprite.v1 = 1.0f;
+        sprite.color = Color(0.2f, 0.6f, 1.0f, 0.75f);
+    }
+
+    uint64_t hashes[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        auto device = std::make_unique<SoftwareGraphicsDevice>(128, 128);
+        SoftwareGraphicsDevice* softwareDevice = device.get();
+        softwareDevice->setFrameLatency(2);
+        Renderer renderer(std::move(device));
+        ASSERT_TRUE(renderer.init());
+        renderer.setBatchCapacity(64);
+        if (pass == 1) {
+            renderer.setStreamBuffer(64 * 1024, 2);
+        }
+
+        for (int frame = 0; frame < 4; ++frame) {
+            renderer.beginRender();
+            softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+            renderer.setInstancingEnabled(frame % 2 == 0);
+            renderer.drawSprites(texture, sprites.data(), sprites.size());
+            renderer.drawRect(Rect(20.0f, 20.0f, 60.0f, 30.0f), Color(1.0f, 0.0f, 0.0f, 0.5f));
+            renderer.endRender();
+        }
+        hashes[pass] = softwareDevice->getFramebufferHash();
+
+        if (pass == 1) {
+            const StreamBuffer::Stats& stats = renderer.getStreamBuffer()->getStats();
+            ASSERT_TRUE(stats.allocations > 0);
+            ASSERT_EQ(0u, stats.overflows);
+            ASSERT_TRUE(stats.framesInFlight <= 2);
+        } else {
+            ASSERT_TRUE(renderer.getStreamBuffer() == nullptr);
+        }
+    }
+    ASSERT_EQ(hashes[0], hashes[1]);
+}
+
+}
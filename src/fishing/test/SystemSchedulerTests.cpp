@@ -0,0 +1,76 @@
+#include "fishing/test/TestFramework.h"
+#include "core/SystemScheduler.h"
+
+using namespace Appgame;
+
+TEST_SUITE(SystemScheduler) {
+
+TEST(SystemScheduler, SystemsTickAtOwnRate) {
+    SystemScheduler scheduler;
+    int weatherTicks = 0;
+    int physicsTicks = 0;
+    int frameTicks = 0;
+    float weatherDelta = 0.0f;
+
+    scheduler.addSystem("Weather", 1.0f, [&](float deltaTime) {
+        weatherTicks++;
+        weatherDelta = deltaTime;
+    });
+    scheduler.addSystem("Physics", 60.0f, [&](float) { physicsTicks++; });
+    scheduler.addSystem("EveryFrame", 0.0f, [&](float) { frameTicks++; });
+
+    // 模拟10秒，每帧1/60秒
+    for (int i = 0; i < 600; ++i) {
+        scheduler.update(1.0f / 60.0f);
+    }
+
+    ASSERT_TRUE(weatherTicks >= 9 && weatherTicks <= 10);
+    ASSERT_NEAR(1.0f, weatherDelta, 1e-6f);
+    ASSERT_TRUE(physicsTicks >= 599 && physicsTicks <= 600);
+    ASSERT_EQ(600, frameTicks);
+}
+
+TEST(SystemScheduler, SameRateSystemsSpreadAcrossFrames) {
+    SystemScheduler scheduler;
+    int maxTicksInOneFrame = 0;
+    int ticksThisFrame = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        scheduler.addSystem("Slow", 10.0f, [&](float) { ticksThisFrame++; });
+    }
+
+    for (int frame = 0; frame < 120; ++frame) {
+        ticksThisFrame = 0;
+        scheduler.update(1.0f / 60.0f);
+        if (ticksThisFrame > maxTicksInOneFrame) {
+            maxTicksInOneFrame = ticksThisFrame;
+        }
+    }
+
+    // 相位错开后，4个10Hz系统不会总在同一帧集中更新
+    ASSERT_TRUE(maxTicksInOneFrame < 4);
+}
+
+TEST(SystemScheduler, CatchUpIsCapped) {
+    SystemScheduler scheduler;
+    scheduler.setMaxTicksPerUpdate(3);
+    int ticks = 0;
+    SystemScheduler::SystemID id = scheduler.addSystem("Fish", 30.0f, [&](float) { ticks++; }, 1.0f);
+
+    scheduler.update(1.0f);
+    ASSERT_EQ(3, ticks);
+
+    SystemScheduler::SystemStats stats = scheduler.getSystemStats(id);
+    ASSERT_EQ(std::string("Fish"), stats.name);
+    ASSERT_EQ(3u, static_cast<unsigned int>(stats.ticks));
+    ASSERT_NEAR(1.0f, stats.budget, 1e-6f);
+    ASSERT_TRUE(stats.budgetUsage >= 0.0f);
+
+    scheduler.setRate(id, 10.0f);
+    ASSERT_NEAR(10.0f, scheduler.getRate(id), 1e-6f);
+
+    scheduler.removeSystem(id);
+    ASSERT_EQ(0u, static_cast<unsigned int>(scheduler.getAllStats().size()));
+}
+
+}
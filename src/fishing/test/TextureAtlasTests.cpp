@@ -0,0 +1,316 @@
+#include "fishing/test/TestFramework.h"
+#include "core/TextureAtlas.h"
+#include "core/SoftwareGraphics.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Appgame;
+
+namespace {
+
+bool overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// 检查区域像素（含四周padding）与原图一致
+bool matchesPage(const TextureAtlas& atlas, const AtlasRegion& region, uint32_t color, int padding = 1) {
+    const SoftwareTexture* page = dynamic_cast<const SoftwareTexture*>(atlas.getPage(region.page));
+    if (!page || page != region.texture) {
+        return false;
+    }
+    for (int y = region.rect.y - padding; y < region.rect.y + region.rect.height + padding; ++y) {
+        for (int x = region.rect.x - padding; x < region.rect.x + region.rect.width + padding; ++x) {
+            if (page->getPixels()[y * page->getWidth() + x] != color) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 纹理数量达到上限后无法再创建页面的设备
+class LimitedDevice : public SoftwareGraphicsDevice {
+public:
+    LimitedDevice() : SoftwareGraphicsDevice(8, 8), textureLimit(-1), textures(0) {}
+
+    std::unique_ptr<Texture> createTexture() override {
+        if (textureLimit >= 0 && textures >= textureLimit) {
+            return nullptr;
+        }
+        textures++;
+        return SoftwareGraphicsDevice::createTexture();
+    }
+
+    int textureLimit;
+    int textures;
+};
+
+} // namespace
+
+TEST_SUITE(TextureAtlas) {
+
+TEST(TextureAtlas, MaxRectsPacksWithoutOverlap) {
+    MaxRectsPacker packer(128, 128);
+    std::vector<AtlasRect> placed;
+    for (int i = 0; i < 200; ++i) {
+        AtlasRect rect;
+        if (packer.insert(4 + (i * 7) % 13, 3 + (i * 5) % 11, rect)) {
+            placed.push_back(rect);
+        }
+    }
+    ASSERT_TRUE(placed.size() > 100);
+
+    size_t usedArea = 0;
+    for (size_t i = 0; i < placed.size(); ++i) {
+        ASSERT_TRUE(placed[i].x >= 0 && placed[i].y >= 0);
+        ASSERT_TRUE(placed[i].x + placed[i].width <= 128 && placed[i].y + placed[i].height <= 128);
+        for (size_t j = i + 1; j < placed.size(); ++j) {
+            ASSERT_FALSE(overlaps(placed[i], placed[j]));
+        }
+        usedArea += static_cast<size_t>(placed[i].width) * placed[i].height;
+    }
+    ASSERT_EQ(usedArea, packer.getUsedArea());
+
+    // 空闲矩形与已放置矩形不相交
+    for (const AtlasRect& freeRect : packer.getFreeRects()) {
+        for (const AtlasRect& rect : placed) {
+            ASSERT_FALSE(overlaps(freeRect, rect));
+        }
+    }
+
+    // 间隔移除后空闲区域分散，碎片率上升；全部移除后恢复为整页
+    for (size_t i = 0; i < placed.size(); i += 2) {
+        packer.remove(placed[i]);
+    }
+    ASSERT_TRUE(packer.getFragmentation() > 0.5f);
+    for (size_t i = 1; i < placed.size(); i += 2) {
+        packer.remove(placed[i]);
+    }
+    ASSERT_EQ(0u, packer.getUsedArea());
+    ASSERT_EQ(1u, packer.getFreeRects().size());
+    ASSERT_EQ(0.0f, packer.getFragmentation());
+}
+
+TEST(TextureAtlas, RegionsShareOnePageAndBatch) {
+    SoftwareGraphicsDevice* softwareDevice = new SoftwareGraphicsDevice(64, 32);
+    Renderer renderer((std::unique_ptr<GraphicsDevice>(softwareDevice)));
+    ASSERT_TRUE(renderer.init());
+
+    TextureAtlas atlas(softwareDevice, 128);
+    std::vector<uint32_t> red(16 * 16, 0xFF0000FFu);
+    std::vector<uint32_t> blue(8 * 16, 0xFFFF0000u);
+    const AtlasRegion* redRegion = atlas.insert("icons/red.ppm", 16, 16, red.data());
+    const AtlasRegion* blueRegion = atlas.insert("icons/blue.ppm", 8, 16, blue.data());
+    ASSERT_TRUE(redRegion && blueRegion);
+    ASSERT_EQ(redRegion, atlas.find("icons/red.ppm"));
+    ASSERT_EQ(1u, atlas.getPageCount());
+    ASSERT_EQ(redRegion->texture, blueRegion->texture);
+
+    // 区域及其1像素填充都是原图颜色
+    ASSERT_TRUE(matchesPage(atlas, *redRegion, 0xFF0000FFu));
+    ASSERT_TRUE(matchesPage(atlas, *blueRegion, 0xFFFF0000u));
+    ASSERT_NEAR(redRegion->rect.x / 128.0f, redRegion->uvRect.x, 1e-6f);
+    ASSERT_NEAR(16.0f / 128.0f, redRegion->uvRect.width, 1e-6f);
+    Rect half = redRegion->mapUV(Rect(0.5f, 0.0f, 0.5f, 1.0f));
+    ASSERT_NEAR(redRegion->uvRect.x + redRegion->uvRect.width * 0.5f, half.x, 1e-6f);
+
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawSprite(*redRegion, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 0.0f, 32.0f, 32.0f));
+    renderer.drawSprite(*blueRegion, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(32.0f, 0.0f, 32.0f, 32.0f));
+    renderer.endRender();
+    ASSERT_EQ(1u, renderer.getRenderStats().batches);
+
+    Color left = softwareDevice->getPixel(2, 2);
+    Color right = softwareDevice->getPixel(61, 29);
+    ASSERT_NEAR(1.0f, left.r, 0.01f);
+    ASSERT_NEAR(0.0f, left.b, 0.01f);
+    ASSERT_NEAR(1.0f, right.b, 0.01f);
+    ASSERT_NEAR(0.0f, right.r, 0.01f);
+}
+
+TEST(TextureAtlas, RepacksFragmentedPageBetweenFrames) {
+    SoftwareGraphicsDevice device(16, 16);
+    TextureAtlas atlas(&device, 64);
+
+    // 填满一页14x14的小图（含填充16x16），再按棋盘格移除
+    std::vector<uint32_t> small(14 * 14, 0xFF00FF00u);
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(atlas.insert("small" + std::to_string(i), 14, 14, small.data()) != nullptr);
+    }
+    ASSERT_EQ(1u, atlas.getPageCount());
+    std::string survivorName;
+    for (int i = 0; i < 16; ++i) {
+        std::string name = "small" + std::to_string(i);
+        const AtlasRegion* region = atlas.find(name);
+        if ((region->rect.x / 16 + region->rect.y / 16) % 2 == 0) {
+            atlas.remove(name);
+        } else {
+            survivorName = name;
+        }
+    }
+    ASSERT_EQ(8u, atlas.getStats().regions);
+    ASSERT_TRUE(atlas.getStats().fragmentation > 0.5f);
+
+    // 空闲面积足够放下30x30的图，但没有连续空间：先放到新页面并标记重新装箱
+    const AtlasRegion* survivor = atlas.find(survivorName);
+    ASSERT_TRUE(survivor != nullptr);
+    std::vector<uint32_t> large(30 * 30, 0xFFFFFFFFu);
+    const AtlasRegion* largeRegion = atlas.insert("large", 30, 30, large.data());
+    ASSERT_TRUE(largeRegion != nullptr);
+    ASSERT_EQ(2u, atlas.getPageCount());
+    ASSERT_EQ(1u, largeRegion->page);
+    ASSERT_TRUE(atlas.isRepackPending());
+    ASSERT_EQ(0u, atlas.getStats().repacks);
+
+    // 帧之间重新装箱后合并回同一页，空页面被删除
+    ASSERT_TRUE(atlas.repackIfPending());
+    ASSERT_FALSE(atlas.repackIfPending());
+    ASSERT_EQ(1u, atlas.getPageCount());
+    ASSERT_EQ(0u, largeRegion->page);
+    ASSERT_EQ(1u, atlas.getStats().repacks);
+    ASSERT_EQ(1u, atlas.getGeneration());
+
+    // 已有区域的指针仍然有效，内容随区域移动
+    ASSERT_EQ(survivor, atlas.find(survivorName));
+    ASSERT_TRUE(matchesPage(atlas, *survivor, 0xFF00FF00u));
+    ASSERT_TRUE(matchesPage(atlas, *largeRegion, 0xFFFFFFFFu));
+
+    // 再放一个放不下的图时新建页面
+    std::vector<uint32_t> larger(40 * 40, 0xFFFFFFFFu);
+    ASSERT_TRUE(atlas.insert("overflow", 40, 40, larger.data()) != nullptr);
+    ASSERT_EQ(2u, atlas.getPageCount());
+    ASSERT_TRUE(atlas.insert("tooLarge", 64, 64, large.data()) == nullptr);
+    ASSERT_FALSE(atlas.isRepackPending());
+}
+
+TEST(TextureAtlas, InsertDuringFrameKeepsQueuedSpritesValid) {
+    SoftwareGraphicsDevice* softwareDevice = new SoftwareGraphicsDevice(32, 32);
+    Renderer renderer((std::unique_ptr<GraphicsDevice>(softwareDevice)));
+    ASSERT_TRUE(renderer.init());
+    TextureAtlas atlas(softwareDevice, 64);
+
+    // 每个小图颜色不同，按棋盘格移除制造碎片
+    for (int i = 0; i < 16; ++i) {
+        std::vector<uint32_t> tile(14 * 14, 0xFF000000u | static_cast<uint32_t>(10 + i * 15));
+        ASSERT_TRUE(atlas.insert("tile" + std::to_string(i), 14, 14, tile.data()) != nullptr);
+    }
+    int survivorIndex = -1;
+    for (int i = 0; i < 16; ++i) {
+        std::string name = "tile" + std::to_string(i);
+        const AtlasRegion* region = atlas.find(name);
+        if ((region->rect.x / 16 + region->rect.y / 16) % 2 == 0) {
+            atlas.remove(name);
+        } else {
+            survivorIndex = i;
+        }
+    }
+    const AtlasRegion* survivor = atlas.find("tile" + std::to_string(survivorIndex));
+    float survivorRed = static_cast<float>(10 + survivorIndex * 15) / 255.0f;
+
+    // 先提交精灵，再在同一帧内插入需要重新装箱的图（如按需生成的字形）
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawSprite(*survivor, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 0.0f, 32.0f, 16.0f));
+    std::vector<uint32_t> large(30 * 30, 0xFFFFFFFFu);
+    const AtlasRegion* largeRegion = atlas.insert("large", 30, 30, large.data());
+    ASSERT_TRUE(largeRegion != nullptr);
+    renderer.drawSprite(*largeRegion, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 16.0f, 32.0f, 16.0f));
+    renderer.endRender();
+    softwareDevice->resolve();
+
+    // 已提交的精灵仍采样原来的位置
+    ASSERT_NEAR(survivorRed, softwareDevice->getPixel(8, 8).r, 0.01f);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(8, 24).b, 0.01f);
+    ASSERT_EQ(0u, atlas.getStats().repacks);
+
+    // 下一帧开始前重新装箱，区域原地更新后绘制结果不变
+    ASSERT_TRUE(atlas.repackIfPending());
+    ASSERT_TRUE(matchesPage(atlas, *survivor, 0xFF000000u | static_cast<uint32_t>(10 + survivorIndex * 15)));
+    renderer.beginRender();
+    softwareDevice->clear(Color(0.0f, 0.0f, 0.0f, 1.0f));
+    renderer.drawSprite(*survivor, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 0.0f, 32.0f, 16.0f));
+    renderer.drawSprite(*largeRegion, Rect(0.0f, 0.0f, 1.0f, 1.0f), Rect(0.0f, 16.0f, 32.0f, 16.0f));
+    renderer.endRender();
+    softwareDevice->resolve();
+    ASSERT_NEAR(survivorRed, softwareDevice->getPixel(8, 8).r, 0.01f);
+    ASSERT_NEAR(1.0f, softwareDevice->getPixel(8, 24).b, 0.01f);
+    ASSERT_EQ(1u, renderer.getRenderStats().batches);
+}
+
+
+TEST(TextureAtlas, ReplaceKeepsRegionAndSurvivesFailure) {
+    LimitedDevice device;
+    device.textureLimit = 1;
+    TextureAtlas atlas(&device, 8, 0);
+    std::vector<uint32_t> red(64, 0xFF0000FFu);
+    std::vector<uint32_t> green(64, 0xFF00FF00u);
+    std::vector<uint32_t> blue(64, 0xFFFF0000u);
+
+    // 两个区域占满唯一的页面
+    const AtlasRegion* a = atlas.insert("a", 4, 8, red.data());
+    ASSERT_TRUE(a != nullptr);
+    ASSERT_TRUE(atlas.insert("b", 4, 8, red.data()) != nullptr);
+    AtlasRect rect = a->rect;
+
+    // 同尺寸替换放回原位置，区域指针不变
+    ASSERT_TRUE(atlas.insert("a", 4, 8, green.data()) == a);
+    ASSERT_EQ(rect.x, a->rect.x);
+    ASSERT_TRUE(matchesPage(atlas, *a, 0xFF00FF00u, 0));
+
+    // 更大的图像需要新页面但无法创建：替换失败，原区域及其占用保持不变
+    ASSERT_TRUE(atlas.insert("a", 5, 8, blue.data()) == nullptr);
+    ASSERT_TRUE(atlas.find("a") == a);
+    ASSERT_EQ(rect.x, a->rect.x);
+    ASSERT_EQ(4, a->rect.width);
+    ASSERT_TRUE(matchesPage(atlas, *a, 0xFF00FF00u, 0));
+    ASSERT_TRUE(atlas.insert("c", 4, 8, blue.data()) == nullptr);
+    ASSERT_EQ(1u, static_cast<unsigned int>(atlas.getPageCount()));
+    ASSERT_EQ(2u, static_cast<unsigned int>(atlas.getStats().regions));
+}
+
+TEST(TextureAtlas, FailedRepackRestoresLayout) {
+    LimitedDevice device;
+    TextureAtlas atlas(&device, 8, 0);
+
+    // 按插入顺序两页放得下，按尺寸从大到小重新装箱需要第三页
+    const int sizes[6][2] = {{4, 2}, {1, 7}, {3, 6}, {7, 8}, {3, 4}, {3, 4}};
+    const char* names[6] = {"a", "b", "c", "d", "e", "f"};
+    std::vector<uint32_t> pixels(64);
+    std::vector<const AtlasRegion*> regions;
+    std::vector<AtlasRegion> before;
+    for (int i = 0; i < 6; ++i) {
+        std::fill(pixels.begin(), pixels.end(), 0xFF000000u | static_cast<uint32_t>(20 + i * 30));
+        regions.push_back(atlas.insert(names[i], sizes[i][0], sizes[i][1], pixels.data()));
+        ASSERT_TRUE(regions.back() != nullptr);
+        before.push_back(*regions.back());
+    }
+    ASSERT_EQ(2u, static_cast<unsigned int>(atlas.getPageCount()));
+
+    // 无法新建页面：重新装箱失败，所有区域回到原来的页面、位置和像素
+    device.textureLimit = device.textures;
+    unsigned int generation = atlas.getGeneration();
+    ASSERT_FALSE(atlas.repack());
+    ASSERT_EQ(2u, static_cast<unsigned int>(atlas.getPageCount()));
+    ASSERT_EQ(generation, atlas.getGeneration());
+    ASSERT_EQ(0u, atlas.getStats().repacks);
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(before[i].page, regions[i]->page);
+        ASSERT_TRUE(before[i].texture == regions[i]->texture);
+        ASSERT_EQ(before[i].rect.x, regions[i]->rect.x);
+        ASSERT_EQ(before[i].rect.y, regions[i]->rect.y);
+        ASSERT_TRUE(matchesPage(atlas, *regions[i], 0xFF000000u | static_cast<uint32_t>(20 + i * 30), 0));
+    }
+
+    // 可以新建页面时重新装箱成功
+    device.textureLimit = -1;
+    ASSERT_TRUE(atlas.repack());
+    ASSERT_EQ(3u, static_cast<unsigned int>(atlas.getPageCount()));
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(matchesPage(atlas, *regions[i], 0xFF000000u | static_cast<uint32_t>(20 + i * 30), 0));
+    }
+}
+
+}
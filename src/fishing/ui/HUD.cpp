@@ -167,11 +167,11 @@ PlayerData* HUD::getPlayerData() const {
 }
 
 void HUD::show() {
-    m_visible = true;
+    setVisible(true);
 }
 
 void HUD::hide() {
-    m_visible = false;
+    setVisible(false);
 }
 
 bool HUD::isVisible() const {
@@ -179,7 +179,13 @@ bool HUD::isVisible() const {
 }
 
 void HUD::setVisible(bool visible) {
+    if (m_visible == visible) {
+        return;
+    }
+    
+    // 显示和隐藏都需要重绘元素所在区域
     m_visible = visible;
+    invalidate();
 }
 
 void HUD::showFishingStatus() {
@@ -225,10 +231,9 @@ void HUD::showMessage(const std::string& message, float32 duration) {
     
     if (m_messagePanel) {
         m_messagePanel->setVisible(true);
+        m_messagePanel->markDirty();
     }
-    if (m_messageLabel) {
-        // TODO: 更新消息标签文本
-    }
+    UIManager::setLabelText(m_messageLabel, message);
 }
 
 void HUD::clearMessage() {
@@ -238,6 +243,7 @@ void HUD::clearMessage() {
     if (m_messagePanel) {
         m_messagePanel->setVisible(false);
     }
+    UIManager::setLabelText(m_messageLabel, "");
 }
 
 const std::string& HUD::getCurrentMessage() const {
@@ -407,7 +413,7 @@ void HUD::updateFishingStatusUI() {
     // 更新钓鱼状态标签
     FishingState state = m_fishingSystem->getState();
     std::string stateString = getFishingStateString(state);
-    // TODO: 更新钓鱼状态标签文本
+    UIManager::setLabelText(m_fishingStateLabel, "钓鱼状态: " + stateString);
     
     // 更新收杆进度条
     float32 reelingProgress = m_fishingSystem->getReelingProgress();
@@ -415,12 +421,12 @@ void HUD::updateFishingStatusUI() {
     
     // 更新鱼线张力标签
     float32 lineTension = m_fishingSystem->getLineTension();
-    // TODO: 更新鱼线张力标签文本
+    UIManager::setLabelText(m_lineTensionLabel, "鱼线张力: " + std::to_string(static_cast<int32>(lineTension * 100.0f + 0.5f)) + "%");
     
     // 更新鱼信息标签
     if (m_fishingSystem->hasCaughtFish()) {
         std::string fishInfo = getFishInfoString();
-        // TODO: 更新鱼信息标签文本
+        UIManager::setLabelText(m_fishInfoLabel, fishInfo);
     }
 }
 
@@ -449,11 +455,11 @@ void HUD::updateWeatherAndTimeUI() {
     
     // 更新天气标签
     std::string weatherInfo = getWeatherInfoString();
-    // TODO: 更新天气标签文本
+    UIManager::setLabelText(m_weatherLabel, weatherInfo);
     
     // 更新时间标签
     std::string timeInfo = getTimeInfoString();
-    // TODO: 更新时间标签文本
+    UIManager::setLabelText(m_timeLabel, timeInfo);
 }
 
 void HUD::updateMessageUI(float32 deltaTime) {
@@ -584,6 +590,12 @@ void HUD::adjustUIElementsForInputType(InputType inputType) {
     }
 }
 
+void HUD::invalidate() {
+    for (auto& element : m_uiElements) {
+        element->markDirty();
+    }
+}
+
 void HUD::calculateUIElementPositions() {
     // 计算UI元素位置
     resizeUIElements(m_width, m_height);
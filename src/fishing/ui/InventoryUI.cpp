@@ -166,14 +166,14 @@ PlayerData* InventoryUI::getPlayerData() const {
 }
 
 void InventoryUI::show() {
-    m_visible = true;
+    setVisible(true);
     
     // 刷新背包内容
     refreshInventory();
 }
 
 void InventoryUI::hide() {
-    m_visible = false;
+    setVisible(false);
 }
 
 bool InventoryUI::isVisible() const {
@@ -181,7 +181,13 @@ bool InventoryUI::isVisible() const {
 }
 
 void InventoryUI::setVisible(bool visible) {
+    if (m_visible == visible) {
+        return;
+    }
+    
+    // 显示和隐藏都需要重绘元素所在区域
     m_visible = visible;
+    invalidate();
 }
 
 void InventoryUI::refreshInventory() {
@@ -273,6 +279,12 @@ ItemID InventoryUI::getEquippedItem(ItemType type) const {
 
 void InventoryUI::setEquippedItem(ItemType type, ItemID itemId) {
     m_equippedItems[type] = itemId;
+    
+    // 重绘对应的装备格子
+    auto it = m_equipmentSlots.find(type);
+    if (it != m_equipmentSlots.end()) {
+        it->second->markDirty();
+    }
 }
 
 void InventoryUI::resize(int32 width, int32 height) {
@@ -521,6 +533,18 @@ void InventoryUI::adjustUIElementsForInputType(InputType inputType) {
     }
 }
 
+void InventoryUI::invalidate() {
+    for (auto& element : m_uiElements) {
+        element->markDirty();
+    }
+    for (auto& slot : m_inventorySlots) {
+        slot->markDirty();
+    }
+    for (auto& pair : m_equipmentSlots) {
+        pair.second->markDirty();
+    }
+}
+
 void InventoryUI::calculateInventorySlotPositions() {
     // 计算背包格子位置
     int32 slotsPerRow = 5;
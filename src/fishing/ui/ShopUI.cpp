@@ -170,14 +170,14 @@ EconomySystem* ShopUI::getEconomySystem() const {
 }
 
 void ShopUI::show() {
-    m_visible = true;
+    setVisible(true);
     
     // 刷新商店内容
     refreshShop();
 }
 
 void ShopUI::hide() {
-    m_visible = false;
+    setVisible(false);
 }
 
 bool ShopUI::isVisible() const {
@@ -185,7 +185,13 @@ bool ShopUI::isVisible() const {
 }
 
 void ShopUI::setVisible(bool visible) {
+    if (m_visible == visible) {
+        return;
+    }
+    
+    // 显示和隐藏都需要重绘元素所在区域
     m_visible = visible;
+    invalidate();
 }
 
 void ShopUI::refreshShop() {
@@ -378,6 +384,7 @@ int32 ShopUI::getShopPages() const {
 }
 
 void ShopUI::setCurrentShopPage(int32 page) {
+    int32 previousPage = m_currentShopPage;
     m_currentShopPage = page;
     
     // 确保页面在有效范围内
@@ -390,6 +397,16 @@ void ShopUI::setCurrentShopPage(int32 page) {
     
     // 更新商品格子
     updateShopSlots();
+    
+    // 翻页后重绘商品格子和页面指示器
+    if (m_currentShopPage != previousPage) {
+        for (auto& slot : m_shopSlots) {
+            slot->markDirty();
+        }
+        if (m_pageIndicator) {
+            m_pageIndicator->markDirty();
+        }
+    }
 }
 
 int32 ShopUI::getCurrentShopPage() const {
@@ -497,9 +514,7 @@ void ShopUI::updateShopSlots() {
 
 void ShopUI::updatePageNavigation() {
     // 更新页面指示器
-    if (m_pageIndicator) {
-        // TODO: 更新页面指示器文本
-    }
+    UIManager::setLabelText(m_pageIndicator, std::to_string(m_currentShopPage) + "/" + std::to_string(m_shopPages));
     
     // 启用/禁用页面导航按钮
     if (m_previousPageButton) {
@@ -578,6 +593,15 @@ void ShopUI::adjustUIElementsForInputType(InputType inputType) {
     }
 }
 
+void ShopUI::invalidate() {
+    for (auto& element : m_uiElements) {
+        element->markDirty();
+    }
+    for (auto& slot : m_shopSlots) {
+        slot->markDirty();
+    }
+}
+
 void ShopUI::calculateShopSlotPositions() {
     // 计算商品格子位置
     int32 slotsPerRow = 4;
@@ -106,8 +106,15 @@ uint32 BaseUIElement::getID() const {
 }
 
 void BaseUIElement::setPosition(float32 x, float32 y) {
+    if (m_position[0] == x && m_position[1] == y) {
+        return;
+    }
+    
+    // 旧位置和新位置都需要重绘
+    markDirty();
     m_position[0] = x;
     m_position[1] = y;
+    markDirty();
 }
 
 void BaseUIElement::getPosition(float32& x, float32& y) const {
@@ -116,8 +123,15 @@ void BaseUIElement::getPosition(float32& x, float32& y) const {
 }
 
 void BaseUIElement::setSize(float32 width, float32 height) {
+    if (m_size[0] == width && m_size[1] == height) {
+        return;
+    }
+    
+    // 旧区域和新区域都需要重绘
+    markDirty();
     m_size[0] = width;
     m_size[1] = height;
+    markDirty();
 }
 
 void BaseUIElement::getSize(float32& width, float32& height) const {
@@ -142,7 +156,14 @@ UIAlignment BaseUIElement::getAlignment() const {
 }
 
 void BaseUIElement::setVisible(bool visible) {
+    if (m_visible == visible) {
+        return;
+    }
+    
+    // 隐藏前或显示后标记所在区域
+    markDirty();
     m_visible = visible;
+    markDirty();
 }
 
 bool BaseUIElement::isVisible() const {
@@ -150,7 +171,10 @@ bool BaseUIElement::isVisible() const {
 }
 
 void BaseUIElement::setEnabled(bool enabled) {
-    m_enabled = enabled;
+    if (m_enabled != enabled) {
+        m_enabled = enabled;
+        markDirty();
+    }
 }
 
 bool BaseUIElement::isEnabled() const {
@@ -158,7 +182,10 @@ bool BaseUIElement::isEnabled() const {
 }
 
 void BaseUIElement::setScale(float32 scale) {
-    m_scale = scale;
+    if (m_scale != scale) {
+        m_scale = scale;
+        markDirty();
+    }
     
     // 更新子元素缩放
     for (auto& child : m_children) {
@@ -171,7 +198,10 @@ float32 BaseUIElement::getScale() const {
 }
 
 void BaseUIElement::setAlpha(float32 alpha) {
-    m_alpha = alpha;
+    if (m_alpha != alpha) {
+        m_alpha = alpha;
+        markDirty();
+    }
     
     // 更新子元素透明度
     for (auto& child : m_children) {
@@ -265,6 +295,16 @@ void BaseUIElement::getBounds(Rectf& bounds) const {
     bounds.height = m_size[1];
 }
 
+void BaseUIElement::markDirty() {
+    if (!m_visible || !m_uiManager) {
+        return;
+    }
+    
+    Rectf bounds;
+    getBounds(bounds);
+    m_uiManager->invalidateRect(bounds);
+}
+
 void BaseUIElement::resize(float32 width, float32 height) {
     // 设置新大小
     setSize(width, height);
@@ -313,6 +353,92 @@ void BaseUIElement::resizeChildren(float32 width, float32 height) {
     }
 }
 
+// UILabel implementation
+UILabel::UILabel(const std::string& name, uint32 id, const std::string& text, float32 fontSize)
+    : BaseUIElement(UIElementType::LABEL, name, id),
+      m_text(text),
+      m_fontSize(fontSize),
+      m_color(1.0f, 1.0f, 1.0f, 1.0f)
+{
+    updateSize();
+}
+
+void UILabel::render() {
+    if (!m_visible) {
+        return;
+    }
+    
+    // 整串文字作为一个缓存的字形串提交，同一字体的标签在渲染器中合批
+    Appgame::Renderer* renderer = m_uiManager ? m_uiManager->getRenderer() : nullptr;
+    Appgame::SdfFont* font = m_uiManager ? m_uiManager->getFont() : nullptr;
+    if (renderer && font && !m_text.empty()) {
+        Appgame::Color color(m_color.r, m_color.g, m_color.b, m_color.a * m_alpha);
+        m_uiManager->getTextRenderer().drawText(*renderer, *font, m_text, m_position[0], m_position[1], m_fontSize, color);
+    }
+    
+    BaseUIElement::render();
+}
+
+void UILabel::setUIManager(UIManager* uiManager) {
+    BaseUIElement::setUIManager(uiManager);
+    updateSize();
+}
+
+void UILabel::setText(const std::string& text) {
+    if (m_text == text) {
+        return;
+    }
+    
+    // 文字变化但大小不变时setSize不会标记，这里标记一次
+    markDirty();
+    m_text = text;
+    updateSize();
+    markDirty();
+}
+
+const std::string& UILabel::getText() const {
+    return m_text;
+}
+
+void UILabel::setFontSize(float32 fontSize) {
+    if (m_fontSize == fontSize) {
+        return;
+    }
+    
+    markDirty();
+    m_fontSize = fontSize;
+    updateSize();
+    markDirty();
+}
+
+float32 UILabel::getFontSize() const {
+    return m_fontSize;
+}
+
+void UILabel::setColor(const Appgame::Color& color) {
+    m_color = color;
+    markDirty();
+}
+
+const Appgame::Color& UILabel::getColor() const {
+    return m_color;
+}
+
+void UILabel::updateSize() {
+    Appgame::SdfFont* font = m_uiManager ? m_uiManager->getFont() : nullptr;
+    if (font) {
+        float32 width, height;
+        m_uiManager->getTextRenderer().measureText(*font, m_text, m_fontSize, width, height);
+        setSize(width, height);
+        return;
+    }
+    
+    // 没有字体时按字符数估算
+    std::vector<uint32_t> codepoints;
+    Appgame::decodeUtf8(m_text, codepoints);
+    setSize(m_fontSize * codepoints.size() * 0.6f, m_fontSize * 1.2f);
+}
+
 // UIManager implementation
 UIManager::UIManager()
     : m_hud(nullptr),
@@ -324,8 +450,13 @@ UIManager::UIManager()
       m_uiScaleFactor(1.0f),
       m_inputType(InputType::MOUSE),
       m_deviceType(DeviceType::DESKTOP),
-      m_nextElementId(1)
+      m_nextElementId(1),
+      m_renderer(nullptr),
+      m_clearColor(0.0f, 0.0f, 0.0f, 0.0f),
+      m_font(nullptr)
 {
+    m_redrawStats = RedrawStats();
+    m_dirtyRegion.setBounds(Appgame::Rect(0.0f, 0.0f, static_cast<float32>(m_screenWidth), static_cast<float32>(m_screenHeight)));
 }
 
 UIManager::~UIManager() {
@@ -406,27 +537,101 @@ void UIManager::update(float32 deltaTime) {
 }
 
 void UIManager::render() {
-    // 渲染HUD
-    if (m_hud) {
-        m_hud->render();
+    // 上一帧的文字已经绘制完成，本帧还没有使用字体图集，在这里执行推迟的重新装箱
+    if (m_font) {
+        m_font->repackIfPending();
     }
     
-    // 渲染背包UI
-    if (m_inventoryUI) {
-        m_inventoryUI->render();
+    if (!m_renderer || !m_renderer->getDevice()->getCapabilities().scissor) {
+        renderElements(nullptr);
+        return;
     }
     
-    // 渲染商店UI
-    if (m_shopUI) {
-        m_shopUI->render();
+    m_redrawStats.frames++;
+    m_redrawStats.dirtyRects = 0;
+    m_redrawStats.dirtyArea = 0.0f;
+    if (m_dirtyRegion.isEmpty()) {
+        // 静态界面：帧缓冲区中保留着上一帧的内容
+        m_redrawStats.skippedFrames++;
+        return;
     }
     
-    // 渲染UI元素
-    for (auto& element : m_uiElements) {
-        element->render();
+    // 裁剪矩形限制清除和光栅化的像素，剔除矩形让区域外的四边形不进入批处理
+    Appgame::GraphicsDevice* device = m_renderer->getDevice();
+    bool culling = m_renderer->isCullingEnabled();
+    Appgame::Rect cullRect = m_renderer->getCullRect();
+    for (const Appgame::Rect& rect : m_dirtyRegion.getRects()) {
+        m_renderer->setScissorRect(rect);
+        m_renderer->setCullRect(rect);
+        device->clear(m_clearColor);
+        
+        Rectf bounds = Rect(rect.x, rect.y, rect.width, rect.height);
+        renderElements(&bounds);
+    }
+    m_renderer->clearScissorRect();
+    if (culling) {
+        m_renderer->setCullRect(cullRect);
+    } else {
+        m_renderer->clearCullRect();
+    }
+    
+    m_redrawStats.dirtyRects = static_cast<uint32>(m_dirtyRegion.getRects().size());
+    m_redrawStats.dirtyArea = m_dirtyRegion.getArea();
+    m_dirtyRegion.clear();
+}
+
+void UIManager::setRenderer(Appgame::Renderer* renderer) {
+    m_renderer = renderer;
+    
+    // 帧缓冲区中还没有UI内容
+    invalidateAll();
+}
+
+Appgame::Renderer* UIManager::getRenderer() const {
+    return m_renderer;
+}
+
+void UIManager::setClearColor(const Appgame::Color& color) {
+    m_clearColor = color;
+    invalidateAll();
+}
+
+void UIManager::setFont(Appgame::SdfFont* font) {
+    m_font = font;
+    m_textRenderer.clear();
+    invalidateAll();
+}
+
+Appgame::SdfFont* UIManager::getFont() const {
+    return m_font;
+}
+
+Appgame::TextRenderer& UIManager::getTextRenderer() {
+    return m_textRenderer;
+}
+
+void UIManager::setLabelText(UIElement* element, const std::string& text) {
+    if (element && element->getType() == UIElementType::LABEL) {
+        static_cast<UILabel*>(element)->setText(text);
     }
 }
 
+void UIManager::invalidateRect(const Rectf& rect) {
+    m_dirtyRegion.add(Appgame::Rect(rect.x, rect.y, rect.width, rect.height));
+}
+
+void UIManager::invalidateAll() {
+    m_dirtyRegion.addAll();
+}
+
+bool UIManager::isDirty() const {
+    return !m_dirtyRegion.isEmpty();
+}
+
+const UIManager::RedrawStats& UIManager::getRedrawStats() const {
+    return m_redrawStats;
+}
+
 bool UIManager::handleInput(int32 inputType, int32 inputValue, float32 x, float32 y) {
     // 处理商店UI输入
     if (m_shopUI && m_shopUI->isVisible()) {
@@ -478,6 +683,7 @@ bool UIManager::addUIElement(UIElement* element) {
     m_uiElements.push_back(element);
     m_uiElementsById[element->getID()] = element;
     m_uiElementsByName[element->getName()] = element;
+    element->markDirty();
     
     std::cout << "Added UI element: " << element->getName() << " (ID: " << element->getID() << ")" << std::endl;
     return true;
@@ -492,6 +698,7 @@ void UIManager::removeUIElement(UIElement* element) {
     auto it = std::find(m_uiElements.begin(), m_uiElements.end(), element);
     if (it != m_uiElements.end()) {
         // 清理UI元素
+        element->markDirty();
         element->cleanup();
         
         // 从映射中移除
@@ -519,6 +726,7 @@ void UIManager::removeAllUIElements() {
     m_uiElements.clear();
     m_uiElementsById.clear();
     m_uiElementsByName.clear();
+    invalidateAll();
     
     std::cout << "Removed all UI elements" << std::endl;
 }
@@ -553,6 +761,17 @@ std::vector<UIElement*> UIManager::getUIElementsByType(UIElementType type) const
     return elements;
 }
 
+Appgame::FrameVector<UIElement*> UIManager::getUIElementsByType(UIElementType type, Appgame::FrameArena& arena) const {
+    Appgame::FrameVector<UIElement*> elements{Appgame::ArenaAllocator<UIElement*>(&arena)};
+    elements.reserve(m_uiElements.size());
+    for (auto& element : m_uiElements) {
+        if (element->getType() == type) {
+            elements.push_back(element);
+        }
+    }
+    return elements;
+}
+
 void UIManager::showHUD() {
     if (m_hud) {
         m_hud->show();
@@ -623,6 +842,8 @@ Platform* UIManager::getPlatform() const {
 void UIManager::setScreenSize(int32 width, int32 height) {
     m_screenWidth = width;
     m_screenHeight = height;
+    m_dirtyRegion.setBounds(Appgame::Rect(0.0f, 0.0f, static_cast<float32>(width), static_cast<float32>(height)));
+    invalidateAll();
     
     // 调整UI大小
     resize(width, height);
@@ -717,16 +938,16 @@ UIElement* UIManager::createButton(const std::string& name, const std::string& t
     UIElement* button = new BaseUIElement(UIElementType::BUTTON, name, id);
     button->setPosition(x, y);
     button->setSize(width, height);
+    button->setUIManager(this);
     return button;
 }
 
 UIElement* UIManager::createLabel(const std::string& name, const std::string& text, float32 x, float32 y, float32 fontSize) {
     // 创建标签UI元素
-    // TODO: 实现标签创建
     uint32 id = generateElementId();
-    UIElement* label = new BaseUIElement(UIElementType::LABEL, name, id);
+    UIElement* label = new UILabel(name, id, text, fontSize);
     label->setPosition(x, y);
-    label->setSize(fontSize * text.length() * 0.6f, fontSize * 1.2f);
+    label->setUIManager(this);
     return label;
 }
 
@@ -737,6 +958,7 @@ UIElement* UIManager::createImage(const std::string& name, const std::string& im
     UIElement* image = new BaseUIElement(UIElementType::IMAGE, name, id);
     image->setPosition(x, y);
     image->setSize(width, height);
+    image->setUIManager(this);
     return image;
 }
 
@@ -747,6 +969,7 @@ UIElement* UIManager::createProgressBar(const std::string& name, float32 x, floa
     UIElement* progressBar = new BaseUIElement(UIElementType::PROGRESS_BAR, name, id);
     progressBar->setPosition(x, y);
     progressBar->setSize(width, height);
+    progressBar->setUIManager(this);
     return progressBar;
 }
 
@@ -757,6 +980,7 @@ UIElement* UIManager::createSlider(const std::string& name, float32 x, float32 y
     UIElement* slider = new BaseUIElement(UIElementType::SLIDER, name, id);
     slider->setPosition(x, y);
     slider->setSize(width, height);
+    slider->setUIManager(this);
     return slider;
 }
 
@@ -767,6 +991,7 @@ UIElement* UIManager::createCheckbox(const std::string& name, const std::string&
     UIElement* checkbox = new BaseUIElement(UIElementType::CHECKBOX, name, id);
     checkbox->setPosition(x, y);
     checkbox->setSize(20.0f, 20.0f);
+    checkbox->setUIManager(this);
     return checkbox;
 }
 
@@ -777,6 +1002,7 @@ UIElement* UIManager::createRadioButton(const std::string& name, const std::stri
     UIElement* radioButton = new BaseUIElement(UIElementType::RADIO_BUTTON, name, id);
     radioButton->setPosition(x, y);
     radioButton->setSize(20.0f, 20.0f);
+    radioButton->setUIManager(this);
     return radioButton;
 }
 
@@ -787,6 +1013,7 @@ UIElement* UIManager::createTextInput(const std::string& name, float32 x, float3
     UIElement* textInput = new BaseUIElement(UIElementType::TEXT_INPUT, name, id);
     textInput->setPosition(x, y);
     textInput->setSize(width, height);
+    textInput->setUIManager(this);
     return textInput;
 }
 
@@ -797,6 +1024,7 @@ UIElement* UIManager::createPanel(const std::string& name, float32 x, float32 y,
     UIElement* panel = new BaseUIElement(UIElementType::PANEL, name, id);
     panel->setPosition(x, y);
     panel->setSize(width, height);
+    panel->setUIManager(this);
     return panel;
 }
 
@@ -807,6 +1035,7 @@ UIElement* UIManager::createWindow(const std::string& name, const std::string& t
     UIElement* window = new BaseUIElement(UIElementType::WINDOW, name, id);
     window->setPosition(x, y);
     window->setSize(width, height);
+    window->setUIManager(this);
     return window;
 }
 
@@ -817,6 +1046,7 @@ UIElement* UIManager::createScrollView(const std::string& name, float32 x, float
     UIElement* scrollView = new BaseUIElement(UIElementType::SCROLL_VIEW, name, id);
     scrollView->setPosition(x, y);
     scrollView->setSize(width, height);
+    scrollView->setUIManager(this);
     return scrollView;
 }
 
@@ -827,6 +1057,7 @@ UIElement* UIManager::createGridView(const std::string& name, float32 x, float32
     UIElement* gridView = new BaseUIElement(UIElementType::GRID_VIEW, name, id);
     gridView->setPosition(x, y);
     gridView->setSize(width, height);
+    gridView->setUIManager(this);
     return gridView;
 }
 
@@ -837,9 +1068,40 @@ UIElement* UIManager::createListView(const std::string& name, float32 x, float32
     UIElement* listView = new BaseUIElement(UIElementType::LIST_VIEW, name, id);
     listView->setPosition(x, y);
     listView->setSize(width, height);
+    listView->setUIManager(this);
     return listView;
 }
 
+void UIManager::renderElements(const Rectf* bounds) {
+    // 渲染HUD
+    if (m_hud) {
+        m_hud->render();
+    }
+    
+    // 渲染背包UI
+    if (m_inventoryUI) {
+        m_inventoryUI->render();
+    }
+    
+    // 渲染商店UI
+    if (m_shopUI) {
+        m_shopUI->render();
+    }
+    
+    // 渲染UI元素
+    for (auto& element : m_uiElements) {
+        if (bounds) {
+            Rectf elementBounds;
+            element->getBounds(elementBounds);
+            if (elementBounds.x >= bounds->x + bounds->width || elementBounds.x + elementBounds.width <= bounds->x ||
+                elementBounds.y >= bounds->y + bounds->height || elementBounds.y + elementBounds.height <= bounds->y) {
+                continue;
+            }
+        }
+        element->render();
+    }
+}
+
 void UIManager::initHUD() {
     // 创建HUD
     m_hud = new HUD();